@@ -0,0 +1,73 @@
+#include "instances.h"
+
+using namespace dlplan;
+using namespace dlplan::core;
+
+
+/*
+  Evaluation of the booleans and numericals generated on an instance
+  on all of its states: per state without caches, per state with caches,
+  and on all states at once with caches. Caches start empty in each
+  iteration.
+
+  Argument: position of the instance, see get_instance_files.
+*/
+namespace dlplan::benchmarks::macro {
+
+static void set_items_processed(benchmark::State& state, const LoadedInstance& instance) {
+    state.SetItemsProcessed(state.iterations() * instance.states.size() * (instance.booleans.size() + instance.numericals.size()));
+}
+
+static void BM_EvaluateElementsPerState(benchmark::State& state) {
+    const auto* instance = load_instance(state, state.range(0));
+    if (!instance) return;
+    for (auto _ : state) {
+        for (const auto& dlplan_state : instance->states) {
+            for (const auto& boolean : instance->booleans) {
+                benchmark::DoNotOptimize(boolean->evaluate(dlplan_state));
+            }
+            for (const auto& numerical : instance->numericals) {
+                benchmark::DoNotOptimize(numerical->evaluate(dlplan_state));
+            }
+        }
+    }
+    set_items_processed(state, *instance);
+}
+
+static void BM_EvaluateElementsPerStateWithCaches(benchmark::State& state) {
+    const auto* instance = load_instance(state, state.range(0));
+    if (!instance) return;
+    for (auto _ : state) {
+        DenotationsCaches caches;
+        for (const auto& dlplan_state : instance->states) {
+            for (const auto& boolean : instance->booleans) {
+                benchmark::DoNotOptimize(boolean->evaluate(dlplan_state, caches));
+            }
+            for (const auto& numerical : instance->numericals) {
+                benchmark::DoNotOptimize(numerical->evaluate(dlplan_state, caches));
+            }
+        }
+    }
+    set_items_processed(state, *instance);
+}
+
+static void BM_EvaluateElementsOnAllStates(benchmark::State& state) {
+    const auto* instance = load_instance(state, state.range(0));
+    if (!instance) return;
+    for (auto _ : state) {
+        DenotationsCaches caches;
+        for (const auto& boolean : instance->booleans) {
+            benchmark::DoNotOptimize(boolean->evaluate(instance->states, caches));
+        }
+        for (const auto& numerical : instance->numericals) {
+            benchmark::DoNotOptimize(numerical->evaluate(instance->states, caches));
+        }
+    }
+    set_items_processed(state, *instance);
+}
+
+BENCHMARK(BM_EvaluateElementsPerState)->Apply(apply_instances)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EvaluateElementsPerStateWithCaches)->Apply(apply_instances)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EvaluateElementsOnAllStates)->Apply(apply_instances)->Unit(benchmark::kMillisecond);
+
+}
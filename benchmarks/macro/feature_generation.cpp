@@ -0,0 +1,73 @@
+#include "instances.h"
+
+using namespace dlplan;
+
+
+/*
+  Feature generation on all states of an instance with the same
+  complexity limit for all types of elements.
+
+  Arguments: position of the instance, see get_instance_files,
+             and complexity limit.
+*/
+namespace dlplan::benchmarks::macro {
+
+static void BM_GenerateFeatures(benchmark::State& state) {
+    const auto* instance = load_instance(state, state.range(0));
+    if (!instance) return;
+    const int complexity_limit = state.range(1);
+    std::size_t num_features = 0;
+    for (auto _ : state) {
+        core::SyntacticElementFactory factory(instance->state_space->get_instance_info()->get_vocabulary_info());
+        auto [booleans, numericals, concepts, roles] = generator::generate_features(
+            factory, instance->states, complexity_limit, complexity_limit, complexity_limit, complexity_limit, complexity_limit, 3600, 1000000);
+        num_features = booleans.size() + numericals.size() + concepts.size() + roles.size();
+    }
+    state.counters["features"] = num_features;
+}
+
+static void apply_instances_and_complexities(benchmark::internal::Benchmark* benchmark) {
+    for (int position = 0; position < static_cast<int>(get_instance_files().size()); ++position) {
+        for (int complexity_limit = 2; complexity_limit <= 6; complexity_limit += 2) {
+            benchmark->Args({position, complexity_limit});
+        }
+    }
+}
+
+BENCHMARK(BM_GenerateFeatures)->Apply(apply_instances_and_complexities)->Unit(benchmark::kMillisecond);
+
+
+/*
+  Feature generation with all rules enabled and candidates evaluated
+  by a thread pool, or serially with a single thread.
+
+  Arguments: position of the instance, see get_instance_files,
+             and number of threads.
+*/
+static void BM_GenerateFeaturesWithExecutor(benchmark::State& state) {
+    const auto* instance = load_instance(state, state.range(0));
+    if (!instance) return;
+    const int num_threads = state.range(1);
+    core::ThreadPoolExecutor executor(num_threads);
+    generator::FeatureGenerator generator;
+    generator.set_executor(num_threads > 1 ? &executor : nullptr);
+    std::size_t num_features = 0;
+    for (auto _ : state) {
+        core::SyntacticElementFactory factory(instance->state_space->get_instance_info()->get_vocabulary_info());
+        auto [booleans, numericals, concepts, roles] = generator.generate(factory, instance->states, 5, 5, 5, 5, 5, 3600, 1000000);
+        num_features = booleans.size() + numericals.size() + concepts.size() + roles.size();
+    }
+    state.counters["features"] = num_features;
+}
+
+static void apply_instances_and_threads(benchmark::internal::Benchmark* benchmark) {
+    for (int position = 0; position < static_cast<int>(get_instance_files().size()); ++position) {
+        for (int num_threads : {1, 4}) {
+            benchmark->Args({position, num_threads});
+        }
+    }
+}
+
+BENCHMARK(BM_GenerateFeaturesWithExecutor)->Apply(apply_instances_and_threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
@@ -0,0 +1,65 @@
+#include "instances.h"
+
+#include <map>
+
+
+namespace dlplan::benchmarks::macro {
+
+static InstanceFiles make_instance_files(const std::string& domain, const std::string& instance) {
+    const std::string directory = std::string(DLPLAN_BENCHMARKS_DIR) + "/" + domain + "/";
+    return InstanceFiles{ domain, directory + "domain.pddl", directory + instance };
+}
+
+const std::vector<InstanceFiles>& get_instance_files() {
+    static const std::vector<InstanceFiles> instance_files{
+        make_instance_files("barman", "p-1-2-1-0.pddl"),
+        make_instance_files("blocksworld_3", "p-3-0.pddl"),
+        make_instance_files("blocksworld_4", "p-3-0.pddl"),
+        make_instance_files("childsnack", "p-2-1.0-0.0-1-0.pddl"),
+        make_instance_files("delivery", "instance_2_2_0.pddl"),
+        make_instance_files("gripper", "p-2-0.pddl"),
+        make_instance_files("miconic", "p-2-2-0.pddl"),
+        make_instance_files("reward", "instance_2x2_0.pddl"),
+        make_instance_files("spanner", "p-3-3-3-0.pddl"),
+        make_instance_files("visitall", "p-1-0.5-2-0.pddl"),
+    };
+    return instance_files;
+}
+
+const LoadedInstance* load_instance(benchmark::State& state, int position) {
+    // Failed loads are cached as nullptr.
+    static std::map<int, std::unique_ptr<LoadedInstance>> loaded_instances;
+    const auto& instance_files = get_instance_files().at(position);
+    state.SetLabel(instance_files.domain);
+    auto it = loaded_instances.find(position);
+    if (it == loaded_instances.end()) {
+        std::unique_ptr<LoadedInstance> loaded_instance;
+        try {
+            auto result = state_space::generate_state_space(instance_files.domain_file, instance_files.instance_file, nullptr, position);
+            if (result.exit_code == state_space::GeneratorExitCode::COMPLETE) {
+                loaded_instance = std::make_unique<LoadedInstance>();
+                loaded_instance->state_space = std::move(result.state_space);
+            }
+        } catch (const std::exception&) { }
+        if (loaded_instance) {
+            for (const auto& pair : loaded_instance->state_space->get_states()) {
+                loaded_instance->states.push_back(pair.second);
+            }
+            loaded_instance->factory = std::make_shared<core::SyntacticElementFactory>(
+                loaded_instance->state_space->get_instance_info()->get_vocabulary_info());
+            std::tie(loaded_instance->booleans, loaded_instance->numericals, loaded_instance->concepts, loaded_instance->roles) =
+                generator::generate_features(*loaded_instance->factory, loaded_instance->states, 5, 5, 5, 5, 5, 3600, 1000);
+        }
+        it = loaded_instances.emplace(position, std::move(loaded_instance)).first;
+    }
+    if (!it->second) {
+        state.SkipWithError(("state space generation failed for " + instance_files.instance_file).c_str());
+    }
+    return it->second.get();
+}
+
+void apply_instances(benchmark::internal::Benchmark* benchmark) {
+    benchmark->DenseRange(0, static_cast<int>(get_instance_files().size()) - 1);
+}
+
+}
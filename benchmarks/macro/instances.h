@@ -0,0 +1,50 @@
+#ifndef DLPLAN_BENCHMARKS_MACRO_INSTANCES_H_
+#define DLPLAN_BENCHMARKS_MACRO_INSTANCES_H_
+
+#include <benchmark/benchmark.h>
+
+#include "../../include/dlplan/core.h"
+#include "../../include/dlplan/generator.h"
+#include "../../include/dlplan/state_space.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace dlplan::benchmarks::macro {
+
+/// @brief A bundled PDDL instance in the benchmarks directory.
+struct InstanceFiles {
+    std::string domain;
+    std::string domain_file;
+    std::string instance_file;
+};
+
+/// @brief Returns one small instance per bundled domain.
+///        Benchmarks take the position in this list as first argument.
+extern const std::vector<InstanceFiles>& get_instance_files();
+
+/// @brief The state space of an instance with features generated on it.
+struct LoadedInstance {
+    std::shared_ptr<state_space::StateSpace> state_space;
+    core::States states;
+    std::shared_ptr<core::SyntacticElementFactory> factory;
+    std::vector<std::shared_ptr<const core::Boolean>> booleans;
+    std::vector<std::shared_ptr<const core::Numerical>> numericals;
+    std::vector<std::shared_ptr<const core::Concept>> concepts;
+    std::vector<std::shared_ptr<const core::Role>> roles;
+};
+
+/// @brief Generates the state space and features up to complexity 5 of the
+///        instance at the given position once per process. Returns nullptr
+///        and stops the benchmark with an error if state space generation
+///        fails, e.g., because the Python state space generator is not installed.
+extern const LoadedInstance* load_instance(benchmark::State& state, int position);
+
+/// @brief Registers the instance positions as first argument.
+extern void apply_instances(benchmark::internal::Benchmark* benchmark);
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "instances.h"
+
+#include "../../include/dlplan/policy.h"
+
+using namespace dlplan;
+
+
+/*
+  Evaluation of a policy on all transitions of an instance. The policy
+  has a rule per generated boolean (b -> !b) and per generated numerical
+  (n > 0 -> n decreases), up to 16 each. Caches start empty in each
+  iteration.
+
+  Argument: position of the instance, see get_instance_files.
+*/
+namespace dlplan::benchmarks::macro {
+
+static std::shared_ptr<const policy::Policy> make_policy(policy::PolicyFactory& factory, const LoadedInstance& instance) {
+    const std::size_t max_num_rules = 16;
+    policy::Rules rules;
+    for (std::size_t i = 0; i < std::min(max_num_rules, instance.booleans.size()); ++i) {
+        std::string name = "b";
+        name += std::to_string(i);
+        auto boolean = factory.make_boolean(name, instance.booleans[i]);
+        rules.insert(factory.make_rule({factory.make_pos_condition(boolean)}, {factory.make_neg_effect(boolean)}));
+    }
+    for (std::size_t i = 0; i < std::min(max_num_rules, instance.numericals.size()); ++i) {
+        std::string name = "n";
+        name += std::to_string(i);
+        auto numerical = factory.make_numerical(name, instance.numericals[i]);
+        rules.insert(factory.make_rule({factory.make_gt_condition(numerical)}, {factory.make_dec_effect(numerical)}));
+    }
+    return factory.make_policy(rules);
+}
+
+template<bool use_caches>
+static void BM_EvaluatePolicy(benchmark::State& state) {
+    const auto* instance = load_instance(state, state.range(0));
+    if (!instance) return;
+    policy::PolicyFactory factory(instance->factory);
+    auto policy = make_policy(factory, *instance);
+    const auto& states = instance->state_space->get_states();
+    std::size_t num_transitions = 0;
+    for (auto _ : state) {
+        core::DenotationsCaches caches;
+        num_transitions = 0;
+        for (const auto& pair : states) {
+            instance->state_space->for_each_forward_successor_state_index([&](int target_index) {
+                if constexpr (use_caches) {
+                    benchmark::DoNotOptimize(policy->evaluate(pair.second, states.at(target_index), caches));
+                } else {
+                    benchmark::DoNotOptimize(policy->evaluate(pair.second, states.at(target_index)));
+                }
+                ++num_transitions;
+            }, pair.first);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_transitions);
+}
+
+BENCHMARK_TEMPLATE(BM_EvaluatePolicy, false)->Apply(apply_instances)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EvaluatePolicy, true)->Apply(apply_instances)->Unit(benchmark::kMillisecond);
+
+}
@@ -0,0 +1,34 @@
+#include "instances.h"
+
+using namespace dlplan;
+
+
+/*
+  Generation of the complete state space of an instance from PDDL files,
+  including the Python state space generator and parsing its output.
+
+  Argument: position of the instance, see get_instance_files.
+*/
+namespace dlplan::benchmarks::macro {
+
+static void BM_GenerateStateSpace(benchmark::State& state) {
+    const auto& instance_files = get_instance_files().at(state.range(0));
+    state.SetLabel(instance_files.domain);
+    int num_states = 0;
+    for (auto _ : state) {
+        state_space::GeneratorResult result{ state_space::GeneratorExitCode::FAIL, nullptr };
+        try {
+            result = state_space::generate_state_space(instance_files.domain_file, instance_files.instance_file);
+        } catch (const std::exception&) { }
+        if (result.exit_code != state_space::GeneratorExitCode::COMPLETE) {
+            state.SkipWithError(("state space generation failed for " + instance_files.instance_file).c_str());
+            break;
+        }
+        num_states = result.state_space->get_states().size();
+    }
+    state.counters["states"] = num_states;
+}
+
+BENCHMARK(BM_GenerateStateSpace)->Apply(apply_instances)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+}
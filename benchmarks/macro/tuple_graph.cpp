@@ -0,0 +1,37 @@
+#include "instances.h"
+
+#include "../../include/dlplan/novelty.h"
+
+using namespace dlplan;
+
+
+/*
+  Construction of the tuple graph rooted at the initial state.
+
+  Arguments: position of the instance, see get_instance_files,
+             and width of the tuple graph.
+*/
+namespace dlplan::benchmarks::macro {
+
+static void BM_ConstructTupleGraph(benchmark::State& state) {
+    const auto* instance = load_instance(state, state.range(0));
+    if (!instance) return;
+    auto novelty_base = std::make_shared<novelty::NoveltyBase>(
+        instance->state_space->get_instance_info()->get_atoms().size(), state.range(1));
+    for (auto _ : state) {
+        novelty::TupleGraph tuple_graph(novelty_base, instance->state_space, instance->state_space->get_initial_state_index());
+        benchmark::DoNotOptimize(tuple_graph);
+    }
+}
+
+static void apply_instances_and_widths(benchmark::internal::Benchmark* benchmark) {
+    for (int position = 0; position < static_cast<int>(get_instance_files().size()); ++position) {
+        for (int width = 0; width <= 2; ++width) {
+            benchmark->Args({position, width});
+        }
+    }
+}
+
+BENCHMARK(BM_ConstructTupleGraph)->Apply(apply_instances_and_widths)->Unit(benchmark::kMillisecond);
+
+}
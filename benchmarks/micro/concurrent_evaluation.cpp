@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include "states.h"
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+/*
+  Evaluation of elements by several threads, either on one shared
+  DenotationsCaches with 64 shards or on one DenotationsCaches per thread.
+  Each thread evaluates all states starting at a different offset.
+  Thread-local caches recompute every denotation in each iteration.
+
+  Argument: number of states.
+*/
+namespace dlplan::benchmarks::micro {
+
+struct ConcurrentEvaluationFixture {
+    std::shared_ptr<VocabularyInfo> vocabulary;
+    std::shared_ptr<InstanceInfo> instance;
+    States states;
+    std::vector<std::shared_ptr<const Concept>> concepts;
+    std::vector<std::shared_ptr<const Numerical>> numericals;
+
+    explicit ConcurrentEvaluationFixture(int num_states) {
+        vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("edge", 2);
+        vocabulary->add_predicate("at", 1);
+        instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        const int num_objects = 32;
+        std::vector<Atom> atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            instance->add_static_atom("edge", {std::to_string(i), std::to_string((i + 1) % num_objects)});
+            instance->add_static_atom("edge", {std::to_string(i), std::to_string((i * 7) % num_objects)});
+            atoms.push_back(instance->add_atom("at", {std::to_string(i)}));
+        }
+        states = generate_states(instance, atoms, num_states);
+        SyntacticElementFactory factory(vocabulary);
+        concepts = {
+            factory.parse_concept("c_some(r_primitive(edge,0,1),c_primitive(at,0))"),
+            factory.parse_concept("c_all(r_transitive_closure(r_primitive(edge,0,1)),c_primitive(at,0))"),
+            factory.parse_concept("c_and(c_not(c_primitive(at,0)),c_some(r_inverse(r_primitive(edge,0,1)),c_primitive(at,0)))")};
+        numericals = {
+            factory.parse_numerical("n_count(c_some(r_primitive(edge,0,1),c_primitive(at,0)))"),
+            factory.parse_numerical("n_role_distance(r_primitive(edge,0,1),r_primitive(edge,0,1),r_restrict(r_primitive(edge,0,1),c_primitive(at,0)))")};
+    }
+
+    void evaluate(int offset, DenotationsCaches& caches) const {
+        for (size_t k = 0; k < states.size(); ++k) {
+            const auto& state = states[(k + offset) % states.size()];
+            for (const auto& concept_element : concepts) {
+                benchmark::DoNotOptimize(concept_element->evaluate(state, caches));
+            }
+            for (const auto& numerical : numericals) {
+                benchmark::DoNotOptimize(numerical->evaluate(state, caches));
+            }
+        }
+    }
+};
+
+static std::unique_ptr<ConcurrentEvaluationFixture> fixture;
+static std::unique_ptr<DenotationsCaches> shared_caches;
+
+static void BM_EvaluateSharedCaches(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        fixture = std::make_unique<ConcurrentEvaluationFixture>(state.range(0));
+        shared_caches = std::make_unique<DenotationsCaches>(64);
+    }
+    // Threads race on computing denotations in the first iteration
+    // and look them up in the shared caches afterwards.
+    for (auto _ : state) {
+        fixture->evaluate(state.thread_index() * 17, *shared_caches);
+    }
+    if (state.thread_index() == 0) {
+        shared_caches.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_EvaluateThreadLocalCaches(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        fixture = std::make_unique<ConcurrentEvaluationFixture>(state.range(0));
+    }
+    for (auto _ : state) {
+        DenotationsCaches caches;
+        fixture->evaluate(state.thread_index() * 17, caches);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_EvaluateSharedCaches)->Arg(1024)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_EvaluateThreadLocalCaches)->Arg(1024)->ThreadRange(1, 64)->UseRealTime();
+
+}
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+/*
+  Insertion and lookup of concept denotations in DenotationsCaches
+  as done by Element::evaluate(state, caches).
+
+  Arguments: number of distinct keys, number of objects.
+*/
+namespace dlplan::benchmarks::micro {
+
+static std::vector<ConceptDenotation> create_concept_denotations(int num_denotations, int num_objects) {
+    std::vector<ConceptDenotation> denotations;
+    denotations.reserve(num_denotations);
+    for (int i = 0; i < num_denotations; ++i) {
+        ConceptDenotation denotation(num_objects);
+        denotation.insert(i % num_objects);
+        denotation.insert((i / num_objects) % num_objects);
+        denotations.push_back(std::move(denotation));
+    }
+    return denotations;
+}
+
+static void BM_DenotationsCachesInsert(benchmark::State& state) {
+    const int num_keys = state.range(0);
+    const auto denotations = create_concept_denotations(num_keys, state.range(1));
+    for (auto _ : state) {
+        DenotationsCaches caches;
+        for (int i = 0; i < num_keys; ++i) {
+            auto handle = caches.data.insert_unique_handle(ConceptDenotation(denotations[i]));
+            caches.data.insert_mapping<ConceptDenotation>(DenotationsCacheKey{0, 0, i}, handle);
+        }
+        benchmark::DoNotOptimize(caches);
+    }
+    state.SetItemsProcessed(state.iterations() * num_keys);
+}
+
+static void BM_DenotationsCachesGet(benchmark::State& state) {
+    const int num_keys = state.range(0);
+    const auto denotations = create_concept_denotations(num_keys, state.range(1));
+    DenotationsCaches caches;
+    for (int i = 0; i < num_keys; ++i) {
+        auto handle = caches.data.insert_unique_handle(ConceptDenotation(denotations[i]));
+        caches.data.insert_mapping<ConceptDenotation>(DenotationsCacheKey{0, 0, i}, handle);
+    }
+    for (auto _ : state) {
+        for (int i = 0; i < num_keys; ++i) {
+            benchmark::DoNotOptimize(caches.data.get<ConceptDenotation>(DenotationsCacheKey{0, 0, i}));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_keys);
+}
+
+BENCHMARK(BM_DenotationsCachesInsert)->ArgsProduct({{1000, 100000}, {64, 1000}});
+BENCHMARK(BM_DenotationsCachesGet)->ArgsProduct({{1000, 100000}, {64, 1000}});
+
+}
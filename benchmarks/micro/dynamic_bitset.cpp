@@ -0,0 +1,154 @@
+#include <benchmark/benchmark.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+using namespace dlplan::bitset_kernels;
+
+
+/*
+  Set algebra on role denotations with n^2 bits
+  for each instruction set supported by the CPU.
+
+  Arguments: number of objects n, instruction set.
+*/
+namespace dlplan::benchmarks::micro {
+
+static const std::vector<int64_t> num_objects = { 50, 100, 250, 500, 1000, 2000 };
+static const std::vector<int64_t> instruction_sets = {
+    static_cast<int64_t>(InstructionSet::SCALAR),
+    static_cast<int64_t>(InstructionSet::AVX2),
+    static_cast<int64_t>(InstructionSet::AVX512) };
+
+static const char* instruction_set_names[] = { "scalar", "avx2", "avx512" };
+
+/// @brief Returns a role denotation where pair (i,j) is included iff (i + j) % modulo == remainder.
+static RoleDenotation create_role_denotation(int n, int modulo, int remainder) {
+    RoleDenotation denotation(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if ((i + j) % modulo == remainder) denotation.insert({i, j});
+        }
+    }
+    return denotation;
+}
+
+/// @brief Activates the instruction set given in the second argument
+///        and restores the previous one on destruction.
+class InstructionSetScope {
+private:
+    InstructionSet m_previous;
+    bool m_supported;
+
+public:
+    explicit InstructionSetScope(benchmark::State& state)
+        : m_previous(get_instruction_set()),
+          m_supported(is_supported(static_cast<InstructionSet>(state.range(1)))) {
+        if (m_supported) {
+            set_instruction_set(static_cast<InstructionSet>(state.range(1)));
+            state.SetLabel(instruction_set_names[state.range(1)]);
+        } else {
+            state.SkipWithError("Instruction set not supported by this CPU.");
+        }
+    }
+    ~InstructionSetScope() { set_instruction_set(m_previous); }
+    bool supported() const { return m_supported; }
+};
+
+static void set_bytes_processed(benchmark::State& state, int num_operands) {
+    const int64_t n = state.range(0);
+    state.SetBytesProcessed(state.iterations() * num_operands * ((n * n + 63) / 64) * 8);
+}
+
+static void BM_RoleDenotationAnd(benchmark::State& state) {
+    InstructionSetScope scope(state);
+    if (!scope.supported()) return;
+    auto left = create_role_denotation(state.range(0), 2, 0);
+    const auto right = create_role_denotation(state.range(0), 3, 0);
+    for (auto _ : state) {
+        left &= right;
+        benchmark::DoNotOptimize(left);
+    }
+    set_bytes_processed(state, 2);
+}
+
+static void BM_RoleDenotationOr(benchmark::State& state) {
+    InstructionSetScope scope(state);
+    if (!scope.supported()) return;
+    auto left = create_role_denotation(state.range(0), 2, 0);
+    const auto right = create_role_denotation(state.range(0), 3, 0);
+    for (auto _ : state) {
+        left |= right;
+        benchmark::DoNotOptimize(left);
+    }
+    set_bytes_processed(state, 2);
+}
+
+static void BM_RoleDenotationDiff(benchmark::State& state) {
+    InstructionSetScope scope(state);
+    if (!scope.supported()) return;
+    auto left = create_role_denotation(state.range(0), 2, 0);
+    const auto right = create_role_denotation(state.range(0), 3, 0);
+    for (auto _ : state) {
+        left -= right;
+        benchmark::DoNotOptimize(left);
+    }
+    set_bytes_processed(state, 2);
+}
+
+static void BM_RoleDenotationNot(benchmark::State& state) {
+    InstructionSetScope scope(state);
+    if (!scope.supported()) return;
+    auto denotation = create_role_denotation(state.range(0), 2, 0);
+    for (auto _ : state) {
+        ~denotation;
+        benchmark::DoNotOptimize(denotation);
+    }
+    set_bytes_processed(state, 1);
+}
+
+static void BM_RoleDenotationIntersects(benchmark::State& state) {
+    InstructionSetScope scope(state);
+    if (!scope.supported()) return;
+    // Disjoint operands force a full scan.
+    const auto left = create_role_denotation(state.range(0), 2, 0);
+    const auto right = create_role_denotation(state.range(0), 2, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(left.intersects(right));
+    }
+    set_bytes_processed(state, 2);
+}
+
+static void BM_RoleDenotationIsSubsetOf(benchmark::State& state) {
+    InstructionSetScope scope(state);
+    if (!scope.supported()) return;
+    // Proper subset forces a full scan.
+    const auto left = create_role_denotation(state.range(0), 4, 0);
+    const auto right = create_role_denotation(state.range(0), 2, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(left.is_subset_of(right));
+    }
+    set_bytes_processed(state, 2);
+}
+
+static void BM_RoleDenotationEqual(benchmark::State& state) {
+    InstructionSetScope scope(state);
+    if (!scope.supported()) return;
+    // Equal operands force a full scan.
+    const auto left = create_role_denotation(state.range(0), 2, 0);
+    const auto right = left;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(left == right);
+    }
+    set_bytes_processed(state, 2);
+}
+
+BENCHMARK(BM_RoleDenotationAnd)->ArgsProduct({num_objects, instruction_sets});
+BENCHMARK(BM_RoleDenotationOr)->ArgsProduct({num_objects, instruction_sets});
+BENCHMARK(BM_RoleDenotationDiff)->ArgsProduct({num_objects, instruction_sets});
+BENCHMARK(BM_RoleDenotationNot)->ArgsProduct({num_objects, instruction_sets});
+BENCHMARK(BM_RoleDenotationIntersects)->ArgsProduct({num_objects, instruction_sets});
+BENCHMARK(BM_RoleDenotationIsSubsetOf)->ArgsProduct({num_objects, instruction_sets});
+BENCHMARK(BM_RoleDenotationEqual)->ArgsProduct({num_objects, instruction_sets});
+
+}
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include "states.h"
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+/*
+  Evaluation of a fixed set of features on states that are seen once,
+  as in search, either by Element::evaluate(state, caches) or by an
+  EvaluationProgram compiled from the features.
+
+  Argument: number of objects.
+*/
+namespace dlplan::benchmarks::micro {
+
+struct EvaluationProgramFixture {
+    std::shared_ptr<VocabularyInfo> vocabulary;
+    std::shared_ptr<InstanceInfo> instance;
+    States states;
+    std::vector<std::shared_ptr<const Boolean>> booleans;
+    std::vector<std::shared_ptr<const Numerical>> numericals;
+
+    explicit EvaluationProgramFixture(int num_objects) {
+        vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("edge", 2, true);
+        vocabulary->add_predicate("at", 1);
+        vocabulary->add_predicate("on", 2);
+        instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        std::vector<Atom> atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            instance->add_static_atom("edge", {std::to_string(i), std::to_string((i + 1) % num_objects)});
+            atoms.push_back(instance->add_atom("at", {std::to_string(i)}));
+            atoms.push_back(instance->add_atom("on", {std::to_string(i), std::to_string((i * 7) % num_objects)}));
+        }
+        states = generate_states(instance, atoms, 256);
+        SyntacticElementFactory factory(vocabulary);
+        booleans = {
+            factory.parse_boolean("b_empty(c_and(c_primitive(at,0),c_projection(r_primitive(on,0,1),1)))")};
+        numericals = {
+            factory.parse_numerical("n_count(c_some(r_primitive(edge,0,1),c_primitive(at,0)))"),
+            factory.parse_numerical("n_count(c_and(c_primitive(at,0),c_projection(r_primitive(on,0,1),1)))"),
+            factory.parse_numerical("n_count(r_restrict(r_primitive(on,0,1),c_some(r_primitive(edge,0,1),c_primitive(at,0))))"),
+            factory.parse_numerical("n_concept_distance(c_primitive(at,0),r_primitive(edge,0,1),c_projection(r_primitive(on,0,1),1))")};
+    }
+};
+
+static void BM_EvaluateElementsWithCaches(benchmark::State& state) {
+    EvaluationProgramFixture fixture(state.range(0));
+    for (auto _ : state) {
+        DenotationsCaches caches;
+        for (const auto& dlplan_state : fixture.states) {
+            for (const auto& boolean : fixture.booleans) {
+                benchmark::DoNotOptimize(boolean->evaluate(dlplan_state, caches));
+            }
+            for (const auto& numerical : fixture.numericals) {
+                benchmark::DoNotOptimize(numerical->evaluate(dlplan_state, caches));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.states.size());
+}
+
+static void BM_EvaluateProgram(benchmark::State& state) {
+    EvaluationProgramFixture fixture(state.range(0));
+    EvaluationProgram program(fixture.booleans, fixture.numericals);
+    for (auto _ : state) {
+        for (const auto& dlplan_state : fixture.states) {
+            program.evaluate(dlplan_state);
+            benchmark::DoNotOptimize(program.get_numerical_value(0));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.states.size());
+}
+
+BENCHMARK(BM_EvaluateElementsWithCaches)->Arg(16)->Arg(128);
+BENCHMARK(BM_EvaluateProgram)->Arg(16)->Arg(128);
+
+}
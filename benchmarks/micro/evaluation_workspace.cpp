@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include "states.h"
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+/*
+  Evaluation of features by Element::evaluate(state) without caches,
+  as in a successor generator, with and without an EvaluationWorkspace
+  that provides the storage of intermediate denotations.
+
+  Argument: number of objects.
+*/
+namespace dlplan::benchmarks::micro {
+
+struct EvaluationWorkspaceFixture {
+    std::shared_ptr<VocabularyInfo> vocabulary;
+    std::shared_ptr<InstanceInfo> instance;
+    States states;
+    std::vector<std::shared_ptr<const Numerical>> numericals;
+
+    explicit EvaluationWorkspaceFixture(int num_objects) {
+        vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("at", 1);
+        vocabulary->add_predicate("on", 2);
+        instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        std::vector<Atom> atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            atoms.push_back(instance->add_atom("at", {std::to_string(i)}));
+            atoms.push_back(instance->add_atom("on", {std::to_string(i), std::to_string((i * 7) % num_objects)}));
+        }
+        states = generate_states(instance, atoms, 64);
+        SyntacticElementFactory factory(vocabulary);
+        numericals = {
+            factory.parse_numerical("n_count(c_and(c_primitive(at,0),c_projection(r_primitive(on,0,1),1)))"),
+            factory.parse_numerical("n_count(r_restrict(r_inverse(r_primitive(on,0,1)),c_some(r_primitive(on,0,1),c_primitive(at,0))))"),
+            factory.parse_numerical("n_count(r_and(r_primitive(on,0,1),r_compose(r_primitive(on,0,1),r_primitive(on,0,1))))")};
+    }
+};
+
+static void evaluate_numericals(const EvaluationWorkspaceFixture& fixture) {
+    for (const auto& dlplan_state : fixture.states) {
+        for (const auto& numerical : fixture.numericals) {
+            benchmark::DoNotOptimize(numerical->evaluate(dlplan_state));
+        }
+    }
+}
+
+static void BM_EvaluateWithoutWorkspace(benchmark::State& state) {
+    EvaluationWorkspaceFixture fixture(state.range(0));
+    for (auto _ : state) {
+        evaluate_numericals(fixture);
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.states.size());
+}
+
+static void BM_EvaluateWithWorkspace(benchmark::State& state) {
+    EvaluationWorkspaceFixture fixture(state.range(0));
+    EvaluationWorkspace workspace;
+    EvaluationWorkspace::Activation activation(workspace);
+    for (auto _ : state) {
+        evaluate_numericals(fixture);
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.states.size());
+    state.counters["allocations"] = workspace.get_num_allocations();
+}
+
+BENCHMARK(BM_EvaluateWithoutWorkspace)->Arg(16)->Arg(128);
+BENCHMARK(BM_EvaluateWithWorkspace)->Arg(16)->Arg(128);
+
+}
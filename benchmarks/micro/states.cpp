@@ -0,0 +1,19 @@
+#include "states.h"
+
+
+namespace dlplan::benchmarks::micro {
+
+core::States generate_states(const std::shared_ptr<core::InstanceInfo>& instance, const std::vector<core::Atom>& atoms, int num_states) {
+    core::States states;
+    states.reserve(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        std::vector<core::Atom> state_atoms;
+        for (size_t j = 0; j < atoms.size(); ++j) {
+            if (((i * 2654435761u) >> (j % 32)) & 1) state_atoms.push_back(atoms[j]);
+        }
+        states.emplace_back(i, instance, state_atoms);
+    }
+    return states;
+}
+
+}
@@ -0,0 +1,19 @@
+#ifndef DLPLAN_BENCHMARKS_MICRO_STATES_H_
+#define DLPLAN_BENCHMARKS_MICRO_STATES_H_
+
+#include "../../include/dlplan/core.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace dlplan::benchmarks::micro {
+
+/// @brief Returns num_states states with indices 0 to num_states - 1 over the
+///        given atoms. State i contains atom j iff bit j % 32 of a multiplicative
+///        hash of i is set such that states are diverse but reproducible.
+extern core::States generate_states(const std::shared_ptr<core::InstanceInfo>& instance, const std::vector<core::Atom>& atoms, int num_states);
+
+}
+
+#endif
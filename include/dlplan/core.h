@@ -4,7 +4,13 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_CORE_H_
 #define DLPLAN_INCLUDE_DLPLAN_CORE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
@@ -19,9 +25,15 @@
 
 
 // Forward declarations of this header
+namespace dlplan::utils::threadpool {
+class ThreadPool;
+}
+
 namespace dlplan::core {
 class ConceptDenotation;
+class ConceptDenotationBatch;
 class RoleDenotation;
+class RoleAdjacency;
 class DenotationsCaches;
 struct DenotationsCacheKey;
 class Constant;
@@ -33,6 +45,9 @@ class InstanceInfo;
 class State;
 class SyntacticElementFactory;
 class SyntacticElementFactoryImpl;
+class EvaluationProgramImpl;
+class BitMatrix;
+class PairwiseDistances;
 
 using ConceptDenotations = std::vector<std::shared_ptr<const ConceptDenotation>>;
 using RoleDenotations = std::vector<std::shared_ptr<const RoleDenotation>>;
@@ -99,6 +114,10 @@ namespace std {
         size_t operator()(const dlplan::core::RoleDenotations& denotations) const;
     };
     template<>
+    struct hash<dlplan::core::ConceptDenotationBatch> {
+        size_t operator()(const dlplan::core::ConceptDenotationBatch& batch) const;
+    };
+    template<>
     struct hash<dlplan::core::DenotationsCacheKey> {
         std::size_t operator()(const dlplan::core::DenotationsCacheKey& key) const;
     };
@@ -115,7 +134,9 @@ namespace dlplan::core {
 class ConceptDenotation : public Base<ConceptDenotation> {
 private:
     int m_num_objects;
-    DynamicBitset<unsigned> m_data;
+    DynamicBitset<std::uint64_t> m_data;
+
+    friend class ConceptDenotationBatch;
 
 public:
     ConceptDenotation(int num_objects);
@@ -136,6 +157,7 @@ public:
 
     bool contains(ObjectIndex value) const;
     void set();
+    void clear();
     void insert(ObjectIndex value);
     void erase(ObjectIndex value);
 
@@ -144,6 +166,14 @@ public:
     bool intersects(const ConceptDenotation& other) const;
     bool is_subset_of(const ConceptDenotation& other) const;
 
+    /// @brief Returns the number of objects in both denotations without
+    ///        materializing the intersection.
+    int intersection_size(const ConceptDenotation& other) const;
+
+    /// @brief Returns true iff the intersection with other is a subset of
+    ///        superset. Stops at the first object that is not.
+    bool intersection_is_subset_of(const ConceptDenotation& other, const ConceptDenotation& superset) const;
+
     /// @brief Compute a vector representation of this concept denotation.
     /// @return A vector of object indices.
     ObjectIndices to_vector() const;
@@ -152,6 +182,16 @@ public:
     /// @return A vector of object indices in ascending order.
     ObjectIndices to_sorted_vector() const;
 
+    /// @brief Calls the given function on each object index in ascending order
+    ///        without materializing an intermediate vector.
+    /// @param function A callable with signature void(ObjectIndex).
+    template<typename F>
+    void for_each(F&& function) const {
+        for (std::size_t pos = m_data.find_first(); pos != m_data.npos; pos = m_data.find_next(pos)) {
+            function(static_cast<ObjectIndex>(pos));
+        }
+    }
+
     int get_num_objects() const;
 };
 
@@ -163,10 +203,50 @@ public:
 /// The set of pairs of object indices represent the elements in the binary
 /// relation of the role that are true in a given state. Each object index
 /// refers to an object of a common instance info.
+///
+/// A pair (a,b) is stored at position a * num_objects + b, either in a sorted
+/// list of positions if the role is sparse or in a bitset over all positions
+/// otherwise. The representation is switched based on the density such that
+/// memory scales with the number of pairs. Equality and hashing do not depend
+/// on the representation.
 class RoleDenotation : public Base<RoleDenotation> {
 private:
     int m_num_objects;
-    DynamicBitset<unsigned> m_data;
+    int m_size;
+    bool m_is_dense;
+    // The positions of the pairs in ascending order if sparse.
+    std::vector<std::uint64_t> m_positions;
+    // The pairs if dense, no bits otherwise.
+    DynamicBitset<std::uint64_t> m_data;
+    // Lazily built adjacency index of an interned denotation, owned by this denotation.
+    mutable std::atomic<const RoleAdjacency*> m_adjacency;
+    // Lazily computed pairwise distances of an interned denotation, owned by this denotation.
+    mutable std::atomic<const PairwiseDistances*> m_pairwise_distances;
+
+    /// @brief Asserts that no index or distances are attached before a modification.
+    void assert_unindexed() const;
+
+    std::size_t get_position(const PairOfObjectIndices& value) const;
+    bool test(std::size_t position) const;
+    /// @brief Returns the maximum number of pairs of a sparse denotation,
+    ///        at which the list of positions is as large as the bitset.
+    std::size_t get_max_sparse_size() const;
+    /// @brief Returns empty storage for at least the given number of positions,
+    ///        from the current workspace if there is one.
+    std::vector<std::uint64_t> make_positions(std::size_t num_positions) const;
+    /// @brief Ensures storage for the given number of positions.
+    void reserve_positions(std::size_t num_positions);
+    /// @brief Moves the storage out of the positions and returns it to the
+    ///        current workspace if there is one.
+    void release_positions();
+    void to_dense();
+    void to_sparse();
+    /// @brief Recounts the pairs of a dense denotation and switches to the
+    ///        sparse representation if it has become sufficiently sparse.
+    void update_dense();
+
+    friend class BitMatrix;
+    friend std::size_t compute_memory_usage(const RoleDenotation& denotation);
 
 public:
     explicit RoleDenotation(int num_objects);
@@ -187,6 +267,7 @@ public:
 
     bool contains(const PairOfObjectIndices& value) const;
     void set();
+    void clear();
     void insert(const PairOfObjectIndices& value);
     void erase(const PairOfObjectIndices& value);
 
@@ -203,9 +284,164 @@ public:
     /// @return A vector of pairs of object indices in ascending order by first then second element.
     PairsOfObjectIndices to_sorted_vector() const;
 
+    /// @brief Calls the given function on each pair of object indices in ascending
+    ///        order by first then second element without materializing an
+    ///        intermediate vector.
+    /// @param function A callable with signature void(ObjectIndex, ObjectIndex).
+    template<typename F>
+    void for_each(F&& function) const {
+        if (m_is_dense) {
+            for (std::size_t pos = m_data.find_first(); pos != m_data.npos; pos = m_data.find_next(pos)) {
+                function(static_cast<ObjectIndex>(pos / m_num_objects), static_cast<ObjectIndex>(pos % m_num_objects));
+            }
+        } else {
+            for (std::size_t pos : m_positions) {
+                function(static_cast<ObjectIndex>(pos / m_num_objects), static_cast<ObjectIndex>(pos % m_num_objects));
+            }
+        }
+    }
+
+    /// @brief Returns true iff the given predicate holds for some pair of
+    ///        object indices. Stops at the first such pair.
+    /// @param predicate A callable with signature bool(ObjectIndex, ObjectIndex).
+    template<typename F>
+    bool any_of(F&& predicate) const {
+        if (m_is_dense) {
+            for (std::size_t pos = m_data.find_first(); pos != m_data.npos; pos = m_data.find_next(pos)) {
+                if (predicate(static_cast<ObjectIndex>(pos / m_num_objects), static_cast<ObjectIndex>(pos % m_num_objects))) {
+                    return true;
+                }
+            }
+        } else {
+            for (std::size_t pos : m_positions) {
+                if (predicate(static_cast<ObjectIndex>(pos / m_num_objects), static_cast<ObjectIndex>(pos % m_num_objects))) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// @brief Returns the adjacency index of this role denotation. The index
+    ///        is built on first access and kept for the lifetime of the denotation.
+    ///        Only call this on interned denotations that are not modified anymore,
+    ///        e.g., the ones in DenotationsCaches. Concurrent first accesses are safe.
+    const RoleAdjacency& get_adjacency() const;
+
+    /// @brief Returns the pairwise distances along the pairs of this role denotation.
+    ///        The same conditions as for get_adjacency apply. The distances are
+    ///        counted in the memory usage of this denotation once computed.
+    const PairwiseDistances& get_pairwise_distances() const;
+
+    /// @brief Returns true iff the pairwise distances were computed.
+    bool has_pairwise_distances() const;
+
+    /// @brief Returns true iff the pairs are stored in a bitset over all pairs.
+    bool is_dense() const;
+
+    int get_num_objects() const;
+};
+
+/// @brief A compressed sparse row index of a role denotation that
+///        stores the successors and predecessors of each object in ascending order.
+class RoleAdjacency {
+private:
+    std::vector<int> m_successor_offsets;
+    ObjectIndices m_successors;
+    std::vector<int> m_predecessor_offsets;
+    ObjectIndices m_predecessors;
+
+public:
+    /// @brief Constructs the index of the empty role over zero objects.
+    RoleAdjacency();
+    explicit RoleAdjacency(const RoleDenotation& denotation);
+
+    /// @brief Rebuilds the index for the role denotation and reuses the
+    ///        storage of the previous index.
+    void compute(const RoleDenotation& denotation);
+
+    /// @brief Returns all b with (object,b) in the role denotation.
+    std::span<const ObjectIndex> get_successors(ObjectIndex object) const;
+
+    /// @brief Returns all a with (a,object) in the role denotation.
+    std::span<const ObjectIndex> get_predecessors(ObjectIndex object) const;
+
     int get_num_objects() const;
 };
 
+/// @brief Stores the concept denotations of a sequence of states as one
+///        contiguous bit matrix with a block-aligned row per state.
+///
+/// Batch operations stream over all rows at once instead of touching a
+/// separately allocated denotation per state. Rows may belong to instances
+/// with different numbers of objects.
+///
+/// The generator keeps the cached per-state denotations, which its
+/// fingerprints and subset sketches read, and policies evaluate one state
+/// at a time, so neither of them builds batches.
+class ConceptDenotationBatch : public Base<ConceptDenotationBatch> {
+private:
+    std::vector<int> m_num_objects;
+    std::size_t m_blocks_per_row;
+    std::vector<std::uint64_t> m_blocks;
+
+    /// @brief Resets the padding bits behind the last object of each row.
+    void clear_padding();
+
+    friend std::size_t compute_memory_usage(const ConceptDenotationBatch& batch);
+
+public:
+    /// @brief Creates an empty denotation for each state.
+    explicit ConceptDenotationBatch(const States& states);
+    /// @brief Packs the given per state denotations.
+    explicit ConceptDenotationBatch(const ConceptDenotations& denotations);
+    ConceptDenotationBatch(const ConceptDenotationBatch& other);
+    ConceptDenotationBatch& operator=(const ConceptDenotationBatch& other);
+    ConceptDenotationBatch(ConceptDenotationBatch&& other);
+    ConceptDenotationBatch& operator=(ConceptDenotationBatch&& other);
+    ~ConceptDenotationBatch();
+
+    bool are_equal_impl(const ConceptDenotationBatch& other) const;
+    void str_impl(std::stringstream& out) const;
+    std::size_t hash_impl() const;
+
+    ConceptDenotationBatch& operator&=(const ConceptDenotationBatch& other);
+    ConceptDenotationBatch& operator|=(const ConceptDenotationBatch& other);
+    ConceptDenotationBatch& operator-=(const ConceptDenotationBatch& other);
+    ConceptDenotationBatch& operator~();
+
+    bool contains(int row, ObjectIndex value) const;
+    void set(int row);
+    /// @brief Replaces the given row by the denotation.
+    void assign(int row, const ConceptDenotation& denotation);
+    void insert(int row, ObjectIndex value);
+    void erase(int row, ObjectIndex value);
+
+    /// @brief Returns the number of objects in each row.
+    NumericalDenotations count() const;
+    /// @brief Returns for each row whether it contains no object.
+    BooleanDenotations empty() const;
+
+    /// @brief Materializes the denotation of the given row.
+    ConceptDenotation get_denotation(int row) const;
+
+    /// @brief Calls the given function on each object index of the given row
+    ///        in ascending order.
+    /// @param function A callable with signature void(ObjectIndex).
+    template<typename F>
+    void for_each(int row, F&& function) const {
+        const std::uint64_t* blocks = &m_blocks[row * m_blocks_per_row];
+        for (std::size_t b = 0; b < m_blocks_per_row; ++b) {
+            for (std::uint64_t block = blocks[b]; block; block &= block - 1) {
+                function(static_cast<ObjectIndex>(b * 64 + std::countr_zero(block)));
+            }
+        }
+    }
+
+    int get_num_rows() const;
+    int get_num_objects(int row) const;
+};
+
 /// @brief Encapsulates a key to store and retrieve denotations from the cache.
 struct DenotationsCacheKey {
     ElementIndex element;
@@ -218,12 +454,121 @@ struct DenotationsCacheKey {
 };
 
 
+/// @brief Estimates the number of bytes used by denotations.
+extern std::size_t compute_memory_usage(const ConceptDenotation& denotation);
+extern std::size_t compute_memory_usage(const RoleDenotation& denotation);
+extern std::size_t compute_memory_usage(const ConceptDenotationBatch& batch);
+
+
+/// @brief Measurements of the evaluations of a single element.
+struct ElementProfile {
+    ElementIndex index;
+    std::string repr;
+    std::uint64_t num_calls = 0;
+    std::uint64_t num_hits = 0;
+    std::uint64_t num_misses = 0;
+    // Time spent in evaluations including and excluding nested evaluations.
+    std::chrono::nanoseconds cumulative_time{0};
+    std::chrono::nanoseconds self_time{0};
+    // Estimated bytes of the denotations computed on misses.
+    std::size_t num_bytes = 0;
+};
+
+
+/// @brief Records measurements per element of evaluations with caches.
+///        Profiling is enabled by setting DenotationsCaches::profiler and
+///        costs a single check per evaluation otherwise. Threads can share
+///        a profiler. Elements are identified by their index, hence all
+///        profiled elements must stem from the same factory.
+class EvaluationProfiler {
+public:
+    /// @brief Measures a single evaluation of an element on the calling
+    ///        thread. The evaluation counts as hit unless miss is called.
+    ///        Does nothing if the profiler is nullptr.
+    class Scope {
+    private:
+        EvaluationProfiler* m_profiler;
+        ElementIndex m_index;
+        const void* m_element;
+        std::string (*m_compute_repr)(const void*);
+        Scope* m_parent;
+        std::chrono::steady_clock::time_point m_start;
+        std::chrono::nanoseconds m_nested_time;
+        bool m_is_hit;
+        std::size_t m_num_bytes;
+
+        void start();
+        void stop();
+
+        friend class EvaluationProfiler;
+
+    public:
+        template<typename E>
+        Scope(EvaluationProfiler* profiler, const E& element)
+            : m_profiler(profiler) {
+            if (!m_profiler) return;
+            m_index = element.get_index();
+            m_element = &element;
+            m_compute_repr = [](const void* element) { return static_cast<const E*>(element)->str(); };
+            start();
+        }
+        ~Scope() {
+            if (m_profiler) stop();
+        }
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+
+        /// @brief Records that the denotation was computed and passes it on.
+        template<typename T>
+        T&& miss(T&& denotation) {
+            if (m_profiler) {
+                using dlplan::compute_memory_usage;
+                m_is_hit = false;
+                m_num_bytes += compute_memory_usage(denotation);
+            }
+            return std::forward<T>(denotation);
+        }
+    };
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<ElementIndex, ElementProfile> m_profiles;
+
+    void record(const Scope& scope, std::chrono::nanoseconds cumulative_time);
+
+public:
+    EvaluationProfiler();
+    ~EvaluationProfiler();
+    EvaluationProfiler(const EvaluationProfiler& other) = delete;
+    EvaluationProfiler& operator=(const EvaluationProfiler& other) = delete;
+
+    /// @brief Returns the profiles ordered by decreasing self time.
+    std::vector<ElementProfile> get_profiles() const;
+
+    void clear();
+
+    /// @brief Writes the profiles as JSON array of objects.
+    void write_json(std::ostream& out) const;
+    /// @brief Writes the profiles as CSV with a header row.
+    void write_csv(std::ostream& out) const;
+};
+
+
 /// @brief Encapsulates caches for denotations and provides functionality to
 ///        insert and retrieve denotations into and respectively from the cache.
 class DenotationsCaches {
 public:
 
     DenotationsCaches();
+    /// @brief Creates caches that threads can share during evaluation
+    ///        if num_shards is greater than one.
+    explicit DenotationsCaches(std::size_t num_shards);
+    /// @brief Creates caches that keep the denotations of non-static
+    ///        elements in single states within memory_budget bytes.
+    ///        All other denotations are kept until the caches are destroyed.
+    ///        Each shard of the bounded cache gets an equal share
+    ///        of memory_budget.
+    DenotationsCaches(std::size_t num_shards, std::size_t memory_budget);
     ~DenotationsCaches();
     DenotationsCaches(const DenotationsCaches& other) = delete;
     DenotationsCaches& operator=(const DenotationsCaches& other) = delete;
@@ -239,7 +584,56 @@ public:
         ConceptDenotations,
         RoleDenotations,
         BooleanDenotations,
-        NumericalDenotations> data;
+        NumericalDenotations,
+        ConceptDenotationBatch> data;
+
+    // Caches denotations of non-static elements in single states within
+    // a memory budget, nullptr if the caches are unbounded.
+    std::unique_ptr<EvictingObjectCache<DenotationsCacheKey,
+        ConceptDenotation,
+        RoleDenotation,
+        bool,
+        int>> per_state_data;
+
+    // Records evaluations if not nullptr, not owned.
+    EvaluationProfiler* profiler = nullptr;
+
+    /// @brief Returns true iff threads can share the caches during evaluation.
+    bool is_thread_safe() const;
+};
+
+
+/// @brief Runs independent tasks, e.g., to evaluate elements in parallel.
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /// @brief Runs all tasks and returns after all of them finished.
+    ///        Rethrows the first exception thrown by a task.
+    virtual void run(const std::vector<std::function<void()>>& tasks) = 0;
+
+    virtual int get_num_threads() const = 0;
+};
+
+
+/// @brief Runs tasks on a pool of worker threads. Tasks must not run
+///        tasks on the same executor because they would wait for workers
+///        that are all busy.
+class ThreadPoolExecutor : public Executor {
+private:
+    std::unique_ptr<utils::threadpool::ThreadPool> m_thread_pool;
+    int m_num_threads;
+
+public:
+    /// @brief Creates a pool with num_threads worker threads.
+    explicit ThreadPoolExecutor(int num_threads);
+    ThreadPoolExecutor(const ThreadPoolExecutor& other) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor& other) = delete;
+    ~ThreadPoolExecutor() override;
+
+    void run(const std::vector<std::function<void()>>& tasks) override;
+
+    int get_num_threads() const override;
 };
 
 
@@ -431,6 +825,16 @@ private:
     std::unordered_map<std::string, ObjectIndex> m_object_name_to_index;
     std::vector<Object> m_objects;
 
+    // Indices of atoms and static atoms grouped by predicate index.
+    std::vector<AtomIndices> m_predicate_to_atom_indices;
+    std::vector<AtomIndices> m_predicate_to_static_atom_indices;
+
+    // Static parts of primitive denotations, computed on first request.
+    struct StaticDenotations;
+    std::unique_ptr<StaticDenotations> m_static_denotations;
+
+    void clear_static_denotations();
+
     const Atom& add_atom(PredicateIndex predicate_index, const ObjectIndices& object_indices, bool is_static);
     const Atom& add_atom(const Predicate& predicate, const std::vector<Object>& objects, bool is_static);
     const Atom& add_atom(const std::string& predicate_name, const std::vector<std::string>& object_names, bool is_static);
@@ -476,6 +880,18 @@ public:
     const std::vector<Object>& get_objects() const;
     const Atom& get_atom(const std::string& name) const;
     const Object& get_object(const std::string& name) const;
+
+    /// @brief Returns the indices of the atoms with the given predicate.
+    const AtomIndices& get_atom_indices_by_predicate(PredicateIndex predicate_index) const;
+    /// @brief Returns the indices of the static atoms with the given predicate.
+    const AtomIndices& get_static_atom_indices_by_predicate(PredicateIndex predicate_index) const;
+
+    /// @brief Returns the objects at position pos of all static atoms with the
+    ///        given predicate. Computed once and reused until the instance changes.
+    const ConceptDenotation& get_static_concept_denotation(PredicateIndex predicate_index, int pos) const;
+    /// @brief Returns the pairs of objects at positions pos_1 and pos_2 of all static
+    ///        atoms with the given predicate. Computed once and reused until the instance changes.
+    const RoleDenotation& get_static_role_denotation(PredicateIndex predicate_index, int pos_1, int pos_2) const;
 };
 
 
@@ -486,6 +902,11 @@ private:
     std::shared_ptr<InstanceInfo> m_instance_info;
     AtomIndices m_atom_indices;
 
+    // Atom indices grouped by predicate, built in one pass on first request
+    // and shared between copies.
+    struct PredicateAtomIndices;
+    mutable std::atomic<std::shared_ptr<const PredicateAtomIndices>> m_predicate_atom_indices;
+
 public:
     State(StateIndex index, std::shared_ptr<InstanceInfo> instance_info, const std::vector<Atom>& atoms);
     State(StateIndex index, std::shared_ptr<InstanceInfo> instance_info, const AtomIndices& atom_indices);
@@ -502,9 +923,163 @@ public:
 
     std::shared_ptr<InstanceInfo> get_instance_info() const;
     const AtomIndices& get_atom_indices() const;
+
+    /// @brief Returns the indices of the atoms of this state with the given predicate
+    ///        in ascending order.
+    std::span<const AtomIndex> get_atom_indices_by_predicate(PredicateIndex predicate_index) const;
+};
+
+
+/// @brief Represents a successor state by its parent state and the atoms
+///        that the transition adds and deletes. Evaluating elements on a
+///        transition with caches reuses the denotations of the parent state
+///        for elements that do not depend on a changed predicate.
+class StateTransition {
+private:
+    State m_parent_state;
+    State m_state;
+    AtomIndices m_add_atom_indices;
+    AtomIndices m_delete_atom_indices;
+    // Indices of the predicates of added or deleted atoms, sorted.
+    std::vector<PredicateIndex> m_changed_predicate_indices;
+
+    void compute_changed_predicate_indices();
+
+public:
+    /// @brief Computes the atoms that differ between the parent state and the state.
+    StateTransition(const State& parent_state, const State& state);
+    /// @brief Creates the successor state with the given index from the parent state
+    ///        by removing the deleted atoms and inserting the added atoms.
+    StateTransition(const State& parent_state, StateIndex index, const AtomIndices& add_atom_indices, const AtomIndices& delete_atom_indices);
+    StateTransition(const StateTransition& other);
+    StateTransition& operator=(const StateTransition& other);
+    StateTransition(StateTransition&& other);
+    StateTransition& operator=(StateTransition&& other);
+    ~StateTransition();
+
+    /// @brief Returns true iff an atom over one of the given sorted predicates
+    ///        is added or deleted.
+    bool is_changed(const std::vector<PredicateIndex>& predicate_indices) const;
+
+    const State& get_parent_state() const;
+    const State& get_state() const;
+    /// @brief Returns the atoms in the state but not in the parent state, sorted.
+    const AtomIndices& get_add_atom_indices() const;
+    /// @brief Returns the atoms in the parent state but not in the state, sorted.
+    const AtomIndices& get_delete_atom_indices() const;
+    const std::vector<PredicateIndex>& get_changed_predicate_indices() const;
+
+    /// @brief Makes the transition current in the calling thread during its lifetime.
+    class Activation {
+    private:
+        const StateTransition* m_previous;
+
+    public:
+        explicit Activation(const StateTransition& transition);
+        Activation(const Activation& other) = delete;
+        Activation& operator=(const Activation& other) = delete;
+        ~Activation();
+    };
+
+    /// @brief Returns the transition that is current in the calling thread
+    ///        if its successor state is the given state and nullptr otherwise.
+    static const StateTransition* get_current(const State& state);
+};
+
+
+/// @brief Holds reusable bitset storage for concept and role denotations by size.
+///
+/// While a workspace is current in a thread, denotations constructed in that
+/// thread take their bitsets from it and return them on destruction. Repeated
+/// evaluations without caches on states of one instance then allocate no
+/// bitsets after the first evaluation. The same holds for the pair lists of
+/// sparse role denotations and for the bit matrices of compositions and
+/// transitive closures. The distance numericals and r_til_c still allocate
+/// their adjacency indices, distances and search queues, which only an
+/// EvaluationProgram reuses across evaluations. A workspace must outlive its
+/// activations. Activations are per thread: tasks that an Executor runs on
+/// other threads do not use the workspace of the submitting thread.
+class EvaluationWorkspace {
+private:
+    // Free storage by capacity in blocks.
+    std::unordered_map<std::size_t, std::vector<std::vector<std::uint64_t>>> m_free_storage;
+    std::size_t m_num_allocations;
+
+public:
+    EvaluationWorkspace();
+    EvaluationWorkspace(const EvaluationWorkspace& other) = delete;
+    EvaluationWorkspace& operator=(const EvaluationWorkspace& other) = delete;
+    ~EvaluationWorkspace();
+
+    /// @brief Returns empty storage with a capacity of at least the given number
+    ///        of blocks and allocates it only if no such storage is free.
+    std::vector<std::uint64_t> acquire(std::size_t num_blocks);
+
+    /// @brief Makes the storage available to later calls of acquire
+    ///        or frees it if enough storage of its capacity is free.
+    void release(std::vector<std::uint64_t>&& storage);
+
+    /// @brief Frees all storage.
+    void clear();
+
+    /// @brief Returns the number of times that acquire allocated storage.
+    std::size_t get_num_allocations() const;
+
+    /// @brief Makes the workspace current in the calling thread during its lifetime.
+    class Activation {
+    private:
+        EvaluationWorkspace* m_previous;
+
+    public:
+        explicit Activation(EvaluationWorkspace& workspace);
+        Activation(const Activation& other) = delete;
+        Activation& operator=(const Activation& other) = delete;
+        ~Activation();
+    };
+
+    /// @brief Returns the workspace that is current in the calling thread or nullptr.
+    static EvaluationWorkspace* get_current();
 };
 
 
+/// @brief Evaluates the elements on consecutive chunks of the states with the
+///        executor. Returns the results by chunk and element, each in the order
+///        of the states. Tasks share the caches if they are thread-safe and
+///        use scratch caches otherwise.
+template<typename ElementType>
+auto evaluate_in_chunks(const std::vector<const ElementType*>& elements, const States& states, DenotationsCaches& caches, Executor& executor) {
+    using Result = decltype(elements.front()->evaluate(states.front(), caches));
+    // Bounds the size of scratch caches.
+    const std::size_t max_chunk_size = 4096;
+    std::size_t num_chunks = std::min(states.size(), std::max<std::size_t>(
+        4 * executor.get_num_threads(), (states.size() + max_chunk_size - 1) / max_chunk_size));
+    std::vector<std::vector<std::vector<Result>>> results(num_chunks, std::vector<std::vector<Result>>(elements.size()));
+    const bool share_caches = caches.is_thread_safe();
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(num_chunks);
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        tasks.push_back([&, chunk]() {
+            std::size_t begin = states.size() * chunk / num_chunks;
+            std::size_t end = states.size() * (chunk + 1) / num_chunks;
+            DenotationsCaches scratch_caches;
+            scratch_caches.profiler = caches.profiler;
+            DenotationsCaches& task_caches = share_caches ? caches : scratch_caches;
+            auto& chunk_results = results[chunk];
+            for (auto& element_results : chunk_results) {
+                element_results.reserve(end - begin);
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                for (std::size_t j = 0; j < elements.size(); ++j) {
+                    chunk_results[j].push_back(elements[j]->evaluate(states[i], task_caches));
+                }
+            }
+        });
+    }
+    executor.run(tasks);
+    return results;
+}
+
+
 /// @brief Represents the abstract base class of an element
 ///        with functionality for computing some metric scores.
 template<typename Derived>
@@ -512,10 +1087,12 @@ class BaseElement : public Base<Derived> {
 protected:
     std::shared_ptr<VocabularyInfo> m_vocabulary_info;
     bool m_is_static;
+    // Indices of the predicates that the element depends on, sorted.
+    std::vector<PredicateIndex> m_predicate_indices;
 
 public:
-    BaseElement(int index, std::shared_ptr<VocabularyInfo> vocabulary_info, bool is_static)
-        : Base<Derived>(index), m_vocabulary_info(vocabulary_info), m_is_static(is_static) { }
+    BaseElement(int index, std::shared_ptr<VocabularyInfo> vocabulary_info, bool is_static, std::vector<PredicateIndex> predicate_indices)
+        : Base<Derived>(index), m_vocabulary_info(vocabulary_info), m_is_static(is_static), m_predicate_indices(std::move(predicate_indices)) { }
 
     ~BaseElement() { }
 
@@ -534,15 +1111,19 @@ public:
     /* Getters. */
     std::shared_ptr<VocabularyInfo> get_vocabulary_info() const { return m_vocabulary_info; }
     bool is_static() const { return m_is_static; }
+    const std::vector<PredicateIndex>& get_predicate_indices() const { return m_predicate_indices; }
 };
 
 
 
-template<typename Denotation, typename DenotationList>
-class Element : public BaseElement<Element<Denotation, DenotationList>> {
+/// @brief Represents the abstract base class of concepts and roles.
+///        DenotationBatch is the representation of the denotations of
+///        a sequence of states computed by evaluate_batch.
+template<typename Denotation, typename DenotationList, typename DenotationBatch = DenotationList>
+class Element : public BaseElement<Element<Denotation, DenotationList, DenotationBatch>> {
 protected:
-    Element(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, bool is_static)
-       : BaseElement<Element<Denotation, DenotationList>>(index, vocabulary_info, is_static) { }
+    Element(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, bool is_static, std::vector<PredicateIndex> predicate_indices)
+       : BaseElement<Element<Denotation, DenotationList, DenotationBatch>>(index, vocabulary_info, is_static, std::move(predicate_indices)) { }
 
     // protected copy/move to prevent accidental object slicing when passed by value
     Element(const Element& other) = default;
@@ -553,6 +1134,33 @@ protected:
     virtual Denotation evaluate_impl(const State& , DenotationsCaches& ) const = 0;
     virtual DenotationList evaluate_impl(const States& , DenotationsCaches& ) const = 0;
 
+    /// @brief Evaluates the element on the successor state of the transition,
+    ///        in which a predicate of the element changed. Elements that can
+    ///        patch their denotation in the parent state override this.
+    virtual Denotation evaluate_incrementally_impl(const StateTransition& transition, DenotationsCaches& caches) const {
+        return evaluate_impl(transition.get_state(), caches);
+    }
+
+    /// @brief Evaluates the element state by state directly into the rows of
+    ///        the batch without a list of interned denotations. Elements with
+    ///        batch kernels override this.
+    virtual DenotationBatch evaluate_batch_impl(const States& states, DenotationsCaches& caches) const {
+        if constexpr (std::is_same_v<DenotationBatch, DenotationList>) {
+            return *evaluate(states, caches);
+        } else {
+            DenotationBatch batch(states);
+            for (size_t i = 0; i < states.size(); ++i) {
+                if (this->is_static()) {
+                    // Computed once for all states.
+                    batch.assign(i, *evaluate(states[i], caches));
+                } else {
+                    batch.assign(i, evaluate_impl(states[i], caches));
+                }
+            }
+            return batch;
+        }
+    }
+
 public:
     virtual ~Element() = default;
 
@@ -564,28 +1172,119 @@ public:
 
     virtual Denotation evaluate(const State& ) const = 0;
     std::shared_ptr<const Denotation> evaluate(const State& state, DenotationsCaches& caches) const {
-        auto key = DenotationsCacheKey{ Base<Element<Denotation, DenotationList>>::get_index(), state.get_instance_info()->get_index(), BaseElement<Element<Denotation, DenotationList>>::is_static() ? -1 : state.get_index() };
+        EvaluationProfiler::Scope scope(caches.profiler, *this);
+        auto key = DenotationsCacheKey{ Base<Element<Denotation, DenotationList, DenotationBatch>>::get_index(), state.get_instance_info()->get_index(), BaseElement<Element<Denotation, DenotationList, DenotationBatch>>::is_static() ? -1 : state.get_index() };
+        if (caches.per_state_data && key.state != -1) {
+            auto cached = caches.per_state_data->get<Denotation>(key);
+            if (cached) return cached;
+            const StateTransition* transition = StateTransition::get_current(state);
+            if (!transition) return caches.per_state_data->insert(key, scope.miss(evaluate_impl(state, caches)));
+            if (!transition->is_changed(this->get_predicate_indices())) {
+                return caches.per_state_data->insert_shared(key, evaluate(transition->get_parent_state(), caches));
+            }
+            return caches.per_state_data->insert(key, scope.miss(evaluate_incrementally_impl(*transition, caches)));
+        }
         auto cached = caches.data.get<Denotation>(key);
         if (cached) return cached;
-        auto denotation = caches.data.insert_unique(evaluate_impl(state, caches));
-        caches.data.insert_mapping(key, denotation);
-        return denotation;
+        const StateTransition* transition = (key.state != -1) ? StateTransition::get_current(state) : nullptr;
+        CacheHandle handle;
+        if (!transition) {
+            handle = caches.data.insert_unique_handle(scope.miss(evaluate_impl(state, caches)));
+        } else if (!transition->is_changed(this->get_predicate_indices())) {
+            // Share the denotation of the parent state.
+            const State& parent_state = transition->get_parent_state();
+            evaluate(parent_state, caches);
+            handle = caches.data.get_handle<Denotation>(DenotationsCacheKey{ key.element, key.instance, parent_state.get_index() });
+        } else {
+            handle = caches.data.insert_unique_handle(scope.miss(evaluate_incrementally_impl(*transition, caches)));
+        }
+        handle = caches.data.insert_or_get_mapping<Denotation>(key, handle);
+        return caches.data.get<Denotation>(handle);
+    }
+    /// @brief Evaluates the element on the successor state of the transition.
+    ///        Only elements that depend on a changed predicate are evaluated,
+    ///        all others share their denotation in the parent state.
+    std::shared_ptr<const Denotation> evaluate(const StateTransition& transition, DenotationsCaches& caches) const {
+        StateTransition::Activation activation(transition);
+        return evaluate(transition.get_state(), caches);
     }
     std::shared_ptr<const DenotationList> evaluate(const States& states, DenotationsCaches& caches) const {
-        auto key = DenotationsCacheKey{ Base<Element<Denotation, DenotationList>>::get_index(), -1, -1 };
+        EvaluationProfiler::Scope scope(caches.profiler, *this);
+        auto key = DenotationsCacheKey{ Base<Element<Denotation, DenotationList, DenotationBatch>>::get_index(), -1, -1 };
         auto cached = caches.data.get<DenotationList>(key);
         if (cached) return cached;
-        auto result_denotations = caches.data.insert_unique(evaluate_impl(states, caches));
-        caches.data.insert_mapping(key, result_denotations);
-        return result_denotations;
+        auto handle = caches.data.insert_unique_handle(scope.miss(evaluate_impl(states, caches)));
+        handle = caches.data.insert_or_get_mapping<DenotationList>(key, handle);
+        return caches.data.get<DenotationList>(handle);
+    }
+    /// @brief Returns the cached denotations of all states
+    ///        or nullptr if there are none. Nothing is evaluated.
+    std::shared_ptr<const DenotationList> get_cached_denotations(DenotationsCaches& caches) const {
+        return caches.data.get<DenotationList>(DenotationsCacheKey{ Base<Element<Denotation, DenotationList, DenotationBatch>>::get_index(), -1, -1 });
+    }
+    /// @brief Evaluates the element on all states into a single batch.
+    ///        Elements without a dedicated batch representation return
+    ///        the result of evaluate(states, caches). A batch packed from
+    ///        cached denotations is not cached to avoid a second copy.
+    std::shared_ptr<const DenotationBatch> evaluate_batch(const States& states, DenotationsCaches& caches) const {
+        if constexpr (std::is_same_v<DenotationBatch, DenotationList>) {
+            return evaluate(states, caches);
+        } else {
+            EvaluationProfiler::Scope scope(caches.profiler, *this);
+            auto key = DenotationsCacheKey{ Base<Element<Denotation, DenotationList, DenotationBatch>>::get_index(), -1, -1 };
+            auto cached = caches.data.get<DenotationBatch>(key);
+            if (cached) return cached;
+            // Packing is cheaper than evaluating again.
+            auto list = caches.data.get<DenotationList>(key);
+            if (list) return std::make_shared<const DenotationBatch>(*list);
+            auto handle = caches.data.insert_unique_handle(scope.miss(evaluate_batch_impl(states, caches)));
+            handle = caches.data.insert_or_get_mapping<DenotationBatch>(key, handle);
+            return caches.data.get<DenotationBatch>(handle);
+        }
+    }
+    /// @brief Evaluates the element on the states in parallel, see evaluate_elements.
+    std::shared_ptr<const DenotationList> evaluate(const States& states, DenotationsCaches& caches, Executor& executor) const {
+        return evaluate_elements({this}, states, caches, executor).front();
+    }
+
+    /// @brief Evaluates each element on all states in parallel by chunks of
+    ///        states. The result is the same as from evaluate(states, caches)
+    ///        for each element. Denotations computed in scratch caches are
+    ///        interned into caches in the order of the states.
+    static std::vector<std::shared_ptr<const DenotationList>> evaluate_elements(const std::vector<const Element*>& elements, const States& states, DenotationsCaches& caches, Executor& executor) {
+        std::vector<std::shared_ptr<const DenotationList>> result(elements.size());
+        std::vector<const Element*> missing_elements;
+        for (size_t i = 0; i < elements.size(); ++i) {
+            result[i] = caches.data.get<DenotationList>(DenotationsCacheKey{ elements[i]->get_index(), -1, -1 });
+            if (!result[i]) missing_elements.push_back(elements[i]);
+        }
+        if (missing_elements.empty()) return result;
+        auto chunk_results = evaluate_in_chunks(missing_elements, states, caches, executor);
+        const bool is_interned = caches.is_thread_safe();
+        for (size_t i = 0, j = 0; i < elements.size(); ++i) {
+            if (result[i]) continue;
+            DenotationList denotations;
+            denotations.reserve(states.size());
+            for (auto& element_results : chunk_results) {
+                for (auto& denotation : element_results[j]) {
+                    denotations.push_back(is_interned ? std::move(denotation) : caches.data.insert_unique(Denotation(*denotation)));
+                }
+            }
+            auto key = DenotationsCacheKey{ elements[i]->get_index(), -1, -1 };
+            auto handle = caches.data.insert_unique_handle(std::move(denotations));
+            handle = caches.data.insert_or_get_mapping<DenotationList>(key, handle);
+            result[i] = caches.data.get<DenotationList>(handle);
+            ++j;
+        }
+        return result;
     }
 };
 
 template<typename Denotation, typename DenotationList>
 class ElementLight : public BaseElement<ElementLight<Denotation, DenotationList>> {
 protected:
-    ElementLight(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, bool is_static)
-       : BaseElement<ElementLight<Denotation, DenotationList>>(index, vocabulary_info, is_static) { }
+    ElementLight(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, bool is_static, std::vector<PredicateIndex> predicate_indices)
+       : BaseElement<ElementLight<Denotation, DenotationList>>(index, vocabulary_info, is_static, std::move(predicate_indices)) { }
 
     // protected copy/move to prevent accidental object slicing when passed by value
     ElementLight(const ElementLight& other) = default;
@@ -607,29 +1306,87 @@ public:
 
     virtual Denotation evaluate(const State& ) const = 0;
     Denotation evaluate(const State& state, DenotationsCaches& caches) const {
+        EvaluationProfiler::Scope scope(caches.profiler, *this);
         auto key = DenotationsCacheKey{ Base<ElementLight<Denotation, DenotationList>>::get_index(), state.get_instance_info()->get_index(), BaseElement<ElementLight<Denotation, DenotationList>>::is_static() ? -1 : state.get_index() };
-        auto cached = caches.data.get<Denotation>(key);
-        // ElementLight dereferences the denotation because it is cheap to copy,
-        // e.g. std::shared_ptr<const int> -> int
-        if (cached) return *cached;  // dereference the cached value
-        auto denotation = caches.data.insert_unique(evaluate_impl(state, caches));
-        caches.data.insert_mapping(key, denotation);
-        return *denotation;  // dereference the newly inserted denoation
+        // ElementLight copies the denotation because it is cheap to copy,
+        // e.g. int instead of std::shared_ptr<const int>
+        if (caches.per_state_data && key.state != -1) {
+            auto cached = caches.per_state_data->get<Denotation>(key);
+            if (cached) return *cached;
+            const StateTransition* transition = StateTransition::get_current(state);
+            if (transition && !transition->is_changed(this->get_predicate_indices())) {
+                return *caches.per_state_data->insert(key, evaluate(transition->get_parent_state(), caches));
+            }
+            return *caches.per_state_data->insert(key, scope.miss(evaluate_impl(state, caches)));
+        }
+        auto cached = caches.data.get_handle<Denotation>(key);
+        if (cached != caches.data.invalid_handle) return caches.data.at<Denotation>(cached);
+        const StateTransition* transition = (key.state != -1) ? StateTransition::get_current(state) : nullptr;
+        CacheHandle handle;
+        if (transition && !transition->is_changed(this->get_predicate_indices())) {
+            // Share the denotation of the parent state.
+            const State& parent_state = transition->get_parent_state();
+            evaluate(parent_state, caches);
+            handle = caches.data.get_handle<Denotation>(DenotationsCacheKey{ key.element, key.instance, parent_state.get_index() });
+        } else {
+            handle = caches.data.insert_unique_handle(scope.miss(evaluate_impl(state, caches)));
+        }
+        handle = caches.data.insert_or_get_mapping<Denotation>(key, handle);
+        return caches.data.at<Denotation>(handle);
+    }
+    /// @brief Evaluates the element on the successor state of the transition,
+    ///        see Element::evaluate.
+    Denotation evaluate(const StateTransition& transition, DenotationsCaches& caches) const {
+        StateTransition::Activation activation(transition);
+        return evaluate(transition.get_state(), caches);
     }
     std::shared_ptr<const DenotationList> evaluate(const States& states, DenotationsCaches& caches) const {
+        EvaluationProfiler::Scope scope(caches.profiler, *this);
         auto key = DenotationsCacheKey{ Base<ElementLight<Denotation, DenotationList>>::get_index(), -1, -1 };
         auto cached = caches.data.get<DenotationList>(key);
         if (cached) return cached;
-        auto result_denotations = caches.data.insert_unique(evaluate_impl(states, caches));
-        caches.data.insert_mapping(key, result_denotations);
-        return result_denotations;
+        auto handle = caches.data.insert_unique_handle(scope.miss(evaluate_impl(states, caches)));
+        handle = caches.data.insert_or_get_mapping<DenotationList>(key, handle);
+        return caches.data.get<DenotationList>(handle);
+    }
+    /// @brief Evaluates the element on the states in parallel, see evaluate_elements.
+    std::shared_ptr<const DenotationList> evaluate(const States& states, DenotationsCaches& caches, Executor& executor) const {
+        return evaluate_elements({this}, states, caches, executor).front();
+    }
+
+    /// @brief Evaluates each element on all states in parallel by chunks of
+    ///        states. The result is the same as from evaluate(states, caches)
+    ///        for each element.
+    static std::vector<std::shared_ptr<const DenotationList>> evaluate_elements(const std::vector<const ElementLight*>& elements, const States& states, DenotationsCaches& caches, Executor& executor) {
+        std::vector<std::shared_ptr<const DenotationList>> result(elements.size());
+        std::vector<const ElementLight*> missing_elements;
+        for (size_t i = 0; i < elements.size(); ++i) {
+            result[i] = caches.data.get<DenotationList>(DenotationsCacheKey{ elements[i]->get_index(), -1, -1 });
+            if (!result[i]) missing_elements.push_back(elements[i]);
+        }
+        if (missing_elements.empty()) return result;
+        auto chunk_results = evaluate_in_chunks(missing_elements, states, caches, executor);
+        for (size_t i = 0, j = 0; i < elements.size(); ++i) {
+            if (result[i]) continue;
+            DenotationList denotations;
+            denotations.reserve(states.size());
+            for (const auto& element_results : chunk_results) {
+                denotations.insert(denotations.end(), element_results[j].begin(), element_results[j].end());
+            }
+            auto key = DenotationsCacheKey{ elements[i]->get_index(), -1, -1 };
+            auto handle = caches.data.insert_unique_handle(std::move(denotations));
+            handle = caches.data.insert_or_get_mapping<DenotationList>(key, handle);
+            result[i] = caches.data.get<DenotationList>(handle);
+            ++j;
+        }
+        return result;
     }
 };
 
 
 /// @brief Represents a concept element that evaluates to a concept denotation
 ///        on a given state. It can also make use of a cache during evaluation.
-using Concept = Element<ConceptDenotation, ConceptDenotations>;
+using Concept = Element<ConceptDenotation, ConceptDenotations, ConceptDenotationBatch>;
 
 /// @brief Represents a role element that evaluates to a role denotation
 ///        on a given state. It can also make use of a cache during evaluation.
@@ -644,7 +1401,59 @@ using Boolean = ElementLight<bool, BooleanDenotations>;
 using Numerical = ElementLight<int, NumericalDenotations>;
 
 
+/// @brief Evaluates each element on all states in parallel with the executor,
+///        e.g., to compute a feature matrix. Returns the denotations of each
+///        element in the order of the elements and states.
+extern std::vector<std::shared_ptr<const ConceptDenotations>> evaluate(const std::vector<std::shared_ptr<const Concept>>& concepts, const States& states, DenotationsCaches& caches, Executor& executor);
+extern std::vector<std::shared_ptr<const RoleDenotations>> evaluate(const std::vector<std::shared_ptr<const Role>>& roles, const States& states, DenotationsCaches& caches, Executor& executor);
+extern std::vector<std::shared_ptr<const BooleanDenotations>> evaluate(const std::vector<std::shared_ptr<const Boolean>>& booleans, const States& states, DenotationsCaches& caches, Executor& executor);
+extern std::vector<std::shared_ptr<const NumericalDenotations>> evaluate(const std::vector<std::shared_ptr<const Numerical>>& numericals, const States& states, DenotationsCaches& caches, Executor& executor);
+
+
+/// @brief Evaluates a fixed set of elements with a flat list of instructions
+///        over preallocated registers. Shared subelements are evaluated once
+///        per state, static subelements once per instance. Counts, emptiness and
+///        inclusion tests of intersections and existential restrictions are
+///        fused into single instructions that do not materialize the inner
+///        denotation. Evaluation does not use caches and is meant for evaluating
+///        the same elements on many states.
+///        A program must not be evaluated by several threads at the same time.
+class EvaluationProgram {
+private:
+    pimpl<EvaluationProgramImpl> m_pImpl;
+
+public:
+    EvaluationProgram(
+        const std::vector<std::shared_ptr<const Boolean>>& booleans,
+        const std::vector<std::shared_ptr<const Numerical>>& numericals,
+        const std::vector<std::shared_ptr<const Concept>>& concepts = {},
+        const std::vector<std::shared_ptr<const Role>>& roles = {});
+    EvaluationProgram(const EvaluationProgram& other);
+    EvaluationProgram& operator=(const EvaluationProgram& other);
+    EvaluationProgram(EvaluationProgram&& other);
+    EvaluationProgram& operator=(EvaluationProgram&& other);
+    ~EvaluationProgram();
+
+    /// @brief Evaluates all elements on the state. The results
+    ///        are valid until the next call of evaluate.
+    void evaluate(const State& state);
+
+    /// @brief Returns the result of the element at position pos
+    ///        in the respective elements given on construction.
+    bool get_boolean_value(int pos) const;
+    int get_numerical_value(int pos) const;
+    const ConceptDenotation& get_concept_denotation(int pos) const;
+    const RoleDenotation& get_role_denotation(int pos) const;
+
+    int get_num_instructions() const;
+    int get_num_registers() const;
+};
+
+
 /// @brief Provides functionality for the syntactically unique creation of elements.
+///        Elements are created in a canonical form: operands of commutative
+///        operators are ordered, and idempotence, double negation and
+///        top/bot absorption are simplified, e.g., c_and(c_top,X) yields X.
 class SyntacticElementFactory {
 private:
     pimpl<SyntacticElementFactoryImpl> m_pImpl;
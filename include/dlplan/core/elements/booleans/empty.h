@@ -36,26 +36,38 @@ private:
         return denotation;
     }
 
-    BooleanDenotations
-    evaluate_impl(const States& states, DenotationsCaches& caches) const override {
+    template<typename DENOTATIONS_TYPE>
+    BooleanDenotations compute_results(const DENOTATIONS_TYPE& element_denotations) const {
         BooleanDenotations denotations;
-        auto element_denotations = m_element->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
+        denotations.reserve(element_denotations.size());
+        for (const auto& element_denotation : element_denotations) {
             bool denotation;
-            compute_result(
-                *(*element_denotations)[i],
-                denotation);
+            compute_result(*element_denotation, denotation);
             denotations.push_back(denotation);
         }
         return denotations;
     }
 
+    BooleanDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override {
+        if constexpr (std::is_same_v<T, Concept>) {
+            // Reading cached denotations avoids packing a second copy of them.
+            auto element_denotations = m_element->get_cached_denotations(caches);
+            if (element_denotations) {
+                return compute_results(*element_denotations);
+            }
+            return m_element->evaluate_batch(states, caches)->empty();
+        } else {
+            return compute_results(*m_element->evaluate(states, caches));
+        }
+    }
+
     EmptyBoolean(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const T> element)
-        : Boolean(index, vocabulary_info, element->is_static()), m_element(element) {
+        : Boolean(index, vocabulary_info, element->is_static(), utils::collect_predicate_indices(element)), m_element(element) {
     }
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Boolean& other) const override {
@@ -55,13 +55,14 @@ private:
     }
 
     InclusionBoolean(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const T> element_left, std::shared_ptr<const T> element_right)
-    : Boolean(index, vocabulary_info, element_left->is_static() && element_right->is_static()),
+    : Boolean(index, vocabulary_info, element_left->is_static() && element_right->is_static(), utils::collect_predicate_indices(element_left, element_right)),
       m_element_left(element_left),
       m_element_right(element_right) {
     }
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Boolean& other) const override {
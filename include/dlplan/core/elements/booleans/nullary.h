@@ -32,6 +32,7 @@ private:
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Boolean& other) const override;
@@ -22,16 +22,23 @@ private:
     const std::shared_ptr<const Role> m_role;
     const std::shared_ptr<const Concept> m_concept;
 
+    // Scans the pairs of the role denotation, used if it is evaluated once.
     void compute_result(const RoleDenotation& role_denot, const ConceptDenotation& concept_denot, ConceptDenotation& result) const;
 
+    // Uses the adjacency index of an interned role denotation.
+    void compute_result(const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_denot, ConceptDenotation& result) const;
+
     ConceptDenotation evaluate_impl(const State& state, DenotationsCaches& caches) const override;
 
     ConceptDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
 
+    ConceptDenotationBatch evaluate_batch_impl(const States& states, DenotationsCaches& caches) const override;
+
     AllConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_);
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Concept& other) const override;
@@ -27,10 +27,14 @@ private:
 
     ConceptDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
 
+    ConceptDenotationBatch evaluate_batch_impl(const States& states, DenotationsCaches& caches) const override;
+
     NotConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_);
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
+    friend class SyntacticElementFactoryImpl;
 
 public:
     bool are_equal_impl(const Concept& other) const override;
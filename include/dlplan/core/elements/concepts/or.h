@@ -28,10 +28,13 @@ private:
 
     ConceptDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
 
+    ConceptDenotationBatch evaluate_batch_impl(const States& states, DenotationsCaches& caches) const override;
+
     OrConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_1, std::shared_ptr<const Concept> concept_2);
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Concept& other) const override;
@@ -29,10 +29,13 @@ private:
 
     ConceptDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
 
+    ConceptDenotation evaluate_incrementally_impl(const StateTransition& transition, DenotationsCaches& caches) const override;
+
     PrimitiveConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, const Predicate& predicate, int pos);
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Concept& other) const override;
@@ -23,8 +23,15 @@ private:
     const std::shared_ptr<const Role> m_role;
     const std::shared_ptr<const Concept> m_concept_to;
 
+    // Builds a temporary adjacency index, used if the role denotation is evaluated once.
     void compute_result(const ConceptDenotation& concept_from_denot, const RoleDenotation& role_denot, const ConceptDenotation& concept_to_denot, int& result) const;
 
+    // Uses the adjacency index of an interned role denotation.
+    void compute_result(const ConceptDenotation& concept_from_denot, const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_to_denot, int& result) const;
+
+    // Reuses the storage of distances and queue for the search.
+    void compute_result(const ConceptDenotation& concept_from_denot, const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_to_denot, utils::Distances& distances, ObjectIndices& queue, int& result) const;
+
     int evaluate_impl(const State& state, DenotationsCaches& caches) const override;
 
     NumericalDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
@@ -32,6 +39,7 @@ private:
     ConceptDistanceNumerical(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_from, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_to);
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Numerical& other) const override;
@@ -23,7 +23,11 @@ private:
     const std::shared_ptr<const Role> m_role;
     const std::shared_ptr<const Role> m_role_to;
 
-    void compute_result(const RoleDenotation& role_from_denot, const RoleDenotation& role_denot, const RoleDenotation& role_to_denot, int& result) const;
+    // Builds a temporary adjacency index, used if the role denotations are evaluated once.
+    void compute_result(const RoleDenotation& role_from_denot, const PairwiseDistances& pairwise_distances, const RoleDenotation& role_to_denot, int& result) const;
+
+    // Uses the adjacency index of interned role denotations.
+    void compute_result(const RoleAdjacency& from_adjacency, const PairwiseDistances& pairwise_distances, const RoleAdjacency& to_adjacency, int& result) const;
 
     int evaluate_impl(const State& state, DenotationsCaches& caches) const override;
 
@@ -33,6 +37,7 @@ private:
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Numerical& other) const override;
@@ -24,6 +24,9 @@ private:
 
     void compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, RoleDenotation& result) const;
 
+    // Computes in the given matrices, which keep their storage across calls.
+    void compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, RoleDenotation& result, BitMatrix& right_matrix, BitMatrix& product) const;
+
     RoleDenotation evaluate_impl(const State& state, DenotationsCaches& caches) const override;
 
     RoleDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
@@ -31,6 +34,7 @@ private:
     ComposeRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role_left, std::shared_ptr<const Role> role_right);
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Role& other) const override;
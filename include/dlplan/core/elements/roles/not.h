@@ -31,6 +31,8 @@ private:
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
+    friend class SyntacticElementFactoryImpl;
 
 public:
     bool are_equal_impl(const Role& other) const override;
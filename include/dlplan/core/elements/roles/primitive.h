@@ -27,10 +27,13 @@ private:
 
     RoleDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
 
+    RoleDenotation evaluate_incrementally_impl(const StateTransition& transition, DenotationsCaches& caches) const override;
+
     PrimitiveRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, const Predicate& predicate, int pos_1, int pos_2);
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Role& other) const override;
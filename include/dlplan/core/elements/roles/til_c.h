@@ -22,8 +22,12 @@ private:
     const std::shared_ptr<const Role> m_role;
     const std::shared_ptr<const Concept> m_concept;
 
+    // Builds a temporary adjacency index, used if the role denotation is evaluated once.
     void compute_result(const RoleDenotation &role_denot, const ConceptDenotation &concept_denot, RoleDenotation &result) const;
 
+    // Uses the adjacency index of an interned role denotation.
+    void compute_result(const RoleAdjacency &adjacency, const ConceptDenotation &concept_denot, RoleDenotation &result) const;
+
     RoleDenotation evaluate_impl(const State& state, DenotationsCaches& caches) const override;
 
     RoleDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
@@ -31,6 +35,7 @@ private:
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Role& other) const override;
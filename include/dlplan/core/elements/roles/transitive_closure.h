@@ -24,6 +24,9 @@ private:
 
     void compute_result(const RoleDenotation& denot, RoleDenotation& result) const;
 
+    // Computes in the given matrix, which keeps its storage across calls.
+    void compute_result(const RoleDenotation& denot, RoleDenotation& result, BitMatrix& matrix) const;
+
     RoleDenotation evaluate_impl(const State& state, DenotationsCaches& caches) const override;
 
     RoleDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
@@ -32,6 +35,8 @@ private:
 
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
+    friend class SyntacticElementFactoryImpl;
 
 public:
     bool are_equal_impl(const Role& other) const override;
@@ -23,6 +23,9 @@ private:
 
     void compute_result(const RoleDenotation& denot, int num_objects, RoleDenotation& result) const;
 
+    // Computes in the given matrix, which keeps its storage across calls.
+    void compute_result(const RoleDenotation& denot, int num_objects, RoleDenotation& result, BitMatrix& matrix) const;
+
     RoleDenotation evaluate_impl(const State& state, DenotationsCaches& caches) const override;
 
     RoleDenotations evaluate_impl(const States& states, DenotationsCaches& caches) const override;
@@ -30,6 +33,7 @@ private:
     TransitiveReflexiveClosureRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role);
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
+    friend class EvaluationProgramImpl;
 
 public:
     bool are_equal_impl(const Role& other) const override;
@@ -11,19 +11,120 @@ const int SCORE_QUBIC = SCORE_LINEAR * SCORE_LINEAR * SCORE_LINEAR;
 
 const int INF = std::numeric_limits<int>::max();
 
-namespace dlplan::core::utils {
+namespace dlplan::core {
+/// @brief A square bit matrix with block-aligned rows.
+///
+/// Row i holds the successors of object i of a role denotation such that
+/// graph-style kernels can combine whole rows with blockwise operations.
+/// The blocks are taken from and returned to the current EvaluationWorkspace.
+class BitMatrix {
+private:
+    int m_num_rows;
+    std::size_t m_blocks_per_row;
+    std::vector<std::uint64_t> m_blocks;
+
+public:
+    BitMatrix();
+    explicit BitMatrix(int num_rows);
+    explicit BitMatrix(const RoleDenotation& denotation);
+    BitMatrix(const BitMatrix& other) = default;
+    BitMatrix& operator=(const BitMatrix& other) = default;
+    BitMatrix(BitMatrix&& other) = default;
+    BitMatrix& operator=(BitMatrix&& other) = default;
+    ~BitMatrix();
+
+    /// @brief Resizes the matrix to the given number of rows and unsets all bits.
+    ///        Reuses the storage if it is large enough.
+    void reset(int num_rows);
+    /// @brief Overwrites the matrix with the pairs of the role denotation.
+    ///        Reuses the storage if it is large enough.
+    void assign(const RoleDenotation& denotation);
+
+    bool test(int row, int column) const;
+    void set(int row, int column);
+
+    /// @brief Bitwise-or the row other_row of other into the given row.
+    void or_row(int row, const BitMatrix& other, int other_row);
+
+    const std::uint64_t* get_row(int row) const;
+    std::size_t get_blocks_per_row() const;
+
+    /// @brief Overwrites the given role denotation with the pairs in this matrix.
+    void to_role_denotation(RoleDenotation& result) const;
+
+    int get_num_rows() const;
+};
+
+/// @brief Shortest distances between all pairs of objects along the pairs of
+///        a role denotation, computed with one breadth-first search per source
+///        that expands whole frontiers with blockwise operations on bit rows.
+class PairwiseDistances {
+private:
+    int m_num_objects;
+    std::vector<int> m_distances;
+    // The visited, frontier and next bit rows of the search.
+    std::vector<std::uint64_t> m_search_blocks;
+
+public:
+    PairwiseDistances();
+    explicit PairwiseDistances(const RoleDenotation& edges);
+
+    /// @brief Recomputes the distances along the pairs of the role denotation
+    ///        and reuses the storage of previous distances.
+    void compute(const RoleDenotation& edges);
+    /// @brief Same as compute but builds the bit matrix of the edges in the given one.
+    void compute(const RoleDenotation& edges, BitMatrix& matrix);
+
+    /// @brief Returns the distance from source to target or INF if unreachable.
+    int get_distance(ObjectIndex source, ObjectIndex target) const;
+
+    int get_num_objects() const;
+};
+
+namespace utils {
 
 using Distances = std::vector<int>;
-using PairwiseDistances = std::vector<Distances>;
+
+/// @brief Returns the sorted union of the predicate indices of the children.
+template<typename... Elements>
+std::vector<PredicateIndex> collect_predicate_indices(const Elements&... elements) {
+    std::vector<PredicateIndex> result;
+    (result.insert(result.end(), elements->get_predicate_indices().begin(), elements->get_predicate_indices().end()), ...);
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
 
 extern int path_addition(int a, int b);
 
-extern int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets);
+extern int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets);
+/// @brief Same as above but reuses the storage of distances and queue.
+extern int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets, Distances& distances, ObjectIndices& queue);
 
-extern Distances compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets);
+extern Distances compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets);
+/// @brief Same as above but writes into distances and reuses the storage of distances and queue.
+extern void compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets, Distances& distances, ObjectIndices& queue);
 
-extern PairwiseDistances compute_floyd_warshall(const RoleDenotation& edges);
+/// @brief Returns the pairwise distances of the given interned role denotation,
+///        which are computed on first request and attached to it. Caches with
+///        a memory budget count attached distances in the memory usage of the
+///        denotation.
+extern std::shared_ptr<const PairwiseDistances> get_pairwise_distances(const std::shared_ptr<const RoleDenotation>& edges, DenotationsCaches& caches);
 
+
+/// @brief Computes the transitive closure of denot into result with
+///        Warshall's algorithm over rows of a bit matrix in O(n^3 / 64).
+extern void compute_transitive_closure(const RoleDenotation& denot, RoleDenotation& result);
+/// @brief Same as above but computes in the given matrix.
+extern void compute_transitive_closure(const RoleDenotation& denot, RoleDenotation& result, BitMatrix& matrix);
+
+/// @brief Computes the composition of left and right into result as a boolean
+///        matrix product: row b of right is or-ed into row a for each (a,b) in left.
+extern void compute_composition(const RoleDenotation& left, const RoleDenotation& right, RoleDenotation& result);
+/// @brief Same as above but computes in the given matrices.
+extern void compute_composition(const RoleDenotation& left, const RoleDenotation& right, RoleDenotation& result, BitMatrix& right_matrix, BitMatrix& product);
+
+}
 }
 
 #endif
@@ -47,6 +47,33 @@ public:
         int time_limit=3600,
         int feature_limit=10000);
 
+    /// @brief Evaluates the candidates of each rule in parallel with the
+    ///        executor, which is not owned and must outlive generate.
+    ///        The generated features are the same as without executor,
+    ///        which is the default.
+    void set_executor(core::Executor* executor);
+
+    /// @brief Evaluates candidates on num_sample_states evenly spaced states
+    ///        first. Only candidates that agree with a generated feature on
+    ///        the sample are evaluated on all states before they are kept or
+    ///        discarded, the generated features are the same as without
+    ///        sample. Disabled if not positive, which is the default.
+    void set_num_sample_states(int num_sample_states);
+
+    /// @brief Skips the pairs of operands of c_and, c_or, r_and, and r_or in
+    ///        which one operand is a subset of the other in all states because
+    ///        the result equals that operand. The generated features are the
+    ///        same as without pruning. Enabled by default.
+    void set_prune_comparable_operands(bool enable);
+
+    /// @brief Writes a binary checkpoint to the file after each completed
+    ///        complexity. If the file exists when generate is called with
+    ///        the same states and enabled rules, generate reuses the completed
+    ///        complexities that the complexity limits allow and continues
+    ///        with the next one, e.g., to raise the limits after a time limit
+    ///        was reached. Disabled if empty, which is the default.
+    void set_checkpoint_file(const std::string& filename);
+
     void set_generate_empty_boolean(bool enable);
     void set_generate_inclusion_boolean(bool enable);
     void set_generate_nullary_boolean(bool enable);
@@ -18,6 +18,9 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_UNIQUE_FACTORY_HPP_
 #define DLPLAN_INCLUDE_DLPLAN_UTILS_UNIQUE_FACTORY_HPP_
 
+#include <algorithm>
+#include <bit>
+#include <type_traits>
 #include <utility>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,13 +30,350 @@
 #include <tuple>
 #include <vector>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
 
 
 namespace dlplan {
+/// @brief Estimates the number of bytes used by the object. Types with
+///        heap memory provide overloads that are found by argument
+///        dependent lookup.
+template<typename T>
+std::size_t compute_memory_usage(const T&) {
+    return sizeof(T);
+}
+
+/// @brief Counts the storage of the vector but not of the objects that its
+///        elements point to.
+template<typename T>
+std::size_t compute_memory_usage(const std::vector<T>& objects) {
+    return sizeof(std::vector<T>) + objects.capacity() * sizeof(T);
+}
+
+/// @brief Refers to an object stored in a SharedObjectCache.
+using CacheHandle = std::uint32_t;
+
+/// @brief Interns objects of the types Ts and maps keys to interned objects.
+///
+/// Objects of each type are addressed by 32-bit handles. Interning and key
+/// lookups use open addressing tables with linear probing over handles.
+/// Interned objects are bump allocated into fixed-size chunks, a pointer handed
+/// out shares ownership of the chunk of its object. The chunks are released at
+/// once by clear(), except for chunks that are still referenced by pointers,
+/// such that a retained pointer keeps at most objects_per_chunk objects alive.
+///
+/// A cache with more than one shard can be shared by threads. Keys are
+/// distributed over the shards by their hash value and objects by theirs,
+/// each shard is guarded by its own lock. The low bits of a handle encode
+/// the shard of the object. A cache with a single shard does not lock.
+/// clear() must not run concurrently with other operations.
 template<typename Key, typename... Ts>
 class SharedObjectCache {
+public:
+    static constexpr CacheHandle invalid_handle = std::numeric_limits<CacheHandle>::max();
+    static constexpr std::size_t objects_per_chunk = 256;
+
+private:
+    static std::size_t compute_slot(std::size_t hash, std::size_t capacity) {
+        // Fibonacci hashing spreads weak low bits over the whole table.
+        return (hash * 0x9E3779B97F4A7C15ull) >> (64 - std::countr_zero(capacity));
+    }
+
+    // Wraps objects in chunks, a std::vector<bool> would pack them.
+    template<typename T>
+    struct ChunkEntry {
+        T object;
+    };
+
+    template<typename T>
+    struct PerTypeCache {
+        // Objects by local handle.
+        std::vector<std::shared_ptr<const T>> objects;
+        // Chunk that new interned objects are appended to. Its capacity
+        // is reserved up front, so that objects never move.
+        std::shared_ptr<std::vector<ChunkEntry<T>>> chunk;
+        // Hash value of each object by local handle.
+        std::vector<std::size_t> hashes;
+        // Local handles of interned objects, invalid_handle marks empty slots.
+        std::vector<CacheHandle> unique;
+        // Key to handle, invalid_handle marks empty slots.
+        std::vector<std::pair<Key, CacheHandle>> mapping;
+        std::size_t num_mappings;
+
+        PerTypeCache()
+            : unique(16, invalid_handle),
+              mapping(16, std::make_pair(Key(), invalid_handle)), num_mappings(0) { }
+
+        std::size_t find_unique_slot(const T& object, std::size_t hash) const {
+            std::size_t mask = unique.size() - 1;
+            for (std::size_t slot = compute_slot(hash, unique.size()); ; slot = (slot + 1) & mask) {
+                CacheHandle handle = unique[slot];
+                if (handle == invalid_handle || (hashes[handle] == hash && *objects[handle] == object)) {
+                    return slot;
+                }
+            }
+        }
+
+        std::size_t find_mapping_slot(const Key& key, std::size_t hash) const {
+            std::size_t mask = mapping.size() - 1;
+            for (std::size_t slot = compute_slot(hash, mapping.size()); ; slot = (slot + 1) & mask) {
+                const auto& entry = mapping[slot];
+                if (entry.second == invalid_handle || entry.first == key) {
+                    return slot;
+                }
+            }
+        }
+
+        void grow_unique() {
+            std::vector<CacheHandle> old_unique(unique.size() * 2, invalid_handle);
+            std::swap(unique, old_unique);
+            std::size_t mask = unique.size() - 1;
+            for (CacheHandle handle : old_unique) {
+                if (handle == invalid_handle) continue;
+                std::size_t slot = compute_slot(hashes[handle], unique.size());
+                while (unique[slot] != invalid_handle) slot = (slot + 1) & mask;
+                unique[slot] = handle;
+            }
+        }
+
+        void grow_mapping() {
+            std::vector<std::pair<Key, CacheHandle>> old_mapping(mapping.size() * 2, std::make_pair(Key(), invalid_handle));
+            std::swap(mapping, old_mapping);
+            for (auto& entry : old_mapping) {
+                if (entry.second == invalid_handle) continue;
+                mapping[find_mapping_slot(entry.first, std::hash<Key>()(entry.first))] = std::move(entry);
+            }
+        }
+    };
+
+    // Aligned to avoid false sharing of locks between shards.
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::tuple<PerTypeCache<Ts>...> cache;
+    };
+
+    int m_shard_bits;
+    std::unique_ptr<Shard[]> m_shards;
+
+    std::size_t compute_shard(std::size_t hash) const {
+        // Use a different multiplier than compute_slot to keep the
+        // slots within a shard independent from the shard.
+        return m_shard_bits ? (hash * 0xC2B2AE3D27D4EB4Full) >> (64 - m_shard_bits) : 0;
+    }
+
+    std::unique_lock<std::mutex> lock(Shard& shard) const {
+        return m_shard_bits ? std::unique_lock<std::mutex>(shard.mutex) : std::unique_lock<std::mutex>();
+    }
+
+    CacheHandle to_handle(std::size_t shard, CacheHandle local_handle) const {
+        return (local_handle << m_shard_bits) | static_cast<CacheHandle>(shard);
+    }
+
+    std::size_t to_shard(CacheHandle handle) const {
+        return handle & ((CacheHandle(1) << m_shard_bits) - 1);
+    }
+
+    CacheHandle to_local_handle(CacheHandle handle) const {
+        return handle >> m_shard_bits;
+    }
+
+    template<typename T>
+    static CacheHandle find_mapping(const PerTypeCache<T>& t_cache, const Key& key, std::size_t hash) {
+        return t_cache.mapping[t_cache.find_mapping_slot(key, hash)].second;
+    }
+
+    /// @brief Stores the object and returns its local handle.
+    template<typename T>
+    CacheHandle emplace_object(PerTypeCache<T>& t_cache, std::shared_ptr<const T> object, std::size_t hash) {
+        if (t_cache.objects.size() >= (invalid_handle >> m_shard_bits)) {
+            throw std::runtime_error("SharedObjectCache::emplace_object - number of objects exceeds the handle range.");
+        }
+        t_cache.objects.push_back(std::move(object));
+        t_cache.hashes.push_back(hash);
+        return static_cast<CacheHandle>(t_cache.objects.size() - 1);
+    }
+
+    /// @brief Appends the object to the current chunk and returns its local handle.
+    template<typename T>
+    CacheHandle emplace_chunk_object(PerTypeCache<T>& t_cache, T&& object, std::size_t hash) {
+        if (!t_cache.chunk || t_cache.chunk->size() == objects_per_chunk) {
+            t_cache.chunk = std::make_shared<std::vector<ChunkEntry<T>>>();
+            t_cache.chunk->reserve(objects_per_chunk);
+        }
+        t_cache.chunk->push_back(ChunkEntry<T>{std::move(object)});
+        return emplace_object(t_cache, std::shared_ptr<const T>(t_cache.chunk, &t_cache.chunk->back().object), hash);
+    }
+
+    /// @brief Maps the key to the handle unless the key is mapped already.
+    ///        Returns the handle that the key is mapped to afterwards.
+    template<typename T>
+    static CacheHandle emplace_mapping(PerTypeCache<T>& t_cache, const Key& key, std::size_t hash, CacheHandle handle) {
+        std::size_t slot = t_cache.find_mapping_slot(key, hash);
+        if (t_cache.mapping[slot].second != invalid_handle) {
+            return t_cache.mapping[slot].second;
+        }
+        t_cache.mapping[slot] = std::make_pair(key, handle);
+        if (2 * ++t_cache.num_mappings > t_cache.mapping.size()) {
+            t_cache.grow_mapping();
+        }
+        return handle;
+    }
+
+public:
+    /// @brief Creates a cache with the given number of shards, which is
+    ///        rounded up to a power of two. More than one shard makes
+    ///        the cache thread-safe.
+    explicit SharedObjectCache(std::size_t num_shards = 1)
+        : m_shard_bits(std::countr_zero(std::bit_ceil(std::max<std::size_t>(num_shards, 1)))),
+          m_shards(std::make_unique<Shard[]>(std::size_t(1) << m_shard_bits)) {
+        if (m_shard_bits > 16) {
+            throw std::runtime_error("SharedObjectCache::SharedObjectCache - number of shards must not exceed 65536.");
+        }
+    }
+    SharedObjectCache(const SharedObjectCache& other) = delete;
+    SharedObjectCache& operator=(const SharedObjectCache& other) = delete;
+    SharedObjectCache(SharedObjectCache&& other) = default;
+    SharedObjectCache& operator=(SharedObjectCache&& other) = default;
+
+    /// @brief Returns the handle mapped to the key or invalid_handle.
+    template<typename T>
+    CacheHandle get_handle(const Key& key) const {
+        std::size_t hash = std::hash<Key>()(key);
+        Shard& shard = m_shards[compute_shard(hash)];
+        auto shard_lock = lock(shard);
+        return find_mapping(std::get<PerTypeCache<T>>(shard.cache), key, hash);
+    }
+
+    /// @brief Returns the object with the given handle.
+    template<typename T>
+    const T& at(CacheHandle handle) const {
+        Shard& shard = m_shards[to_shard(handle)];
+        auto shard_lock = lock(shard);
+        const auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+        assert(to_local_handle(handle) < t_cache.objects.size());
+        // Objects never move, only the pointers to them.
+        return *t_cache.objects[to_local_handle(handle)];
+    }
+
+    /// @brief Returns a pointer to the object with the given handle that
+    ///        keeps the chunk of the object alive.
+    template<typename T>
+    std::shared_ptr<const T> get(CacheHandle handle) const {
+        Shard& shard = m_shards[to_shard(handle)];
+        auto shard_lock = lock(shard);
+        const auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+        assert(to_local_handle(handle) < t_cache.objects.size());
+        return t_cache.objects[to_local_handle(handle)];
+    }
+
+    template<typename T>
+    std::shared_ptr<const T> get(const Key& key) const {
+        CacheHandle handle = get_handle<T>(key);
+        if (handle == invalid_handle) {
+            return nullptr;
+        }
+        return get<T>(handle);
+    }
+
+    template<typename T>
+    void insert_mapping(const Key& key, CacheHandle handle) {
+        std::size_t hash = std::hash<Key>()(key);
+        Shard& shard = m_shards[compute_shard(hash)];
+        auto shard_lock = lock(shard);
+        auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+        if (find_mapping(t_cache, key, hash) != invalid_handle) {
+            throw std::runtime_error("Must call get first before insertion.");
+        }
+        emplace_mapping(t_cache, key, hash, handle);
+    }
+
+    /// @brief Maps the key to the element. Elements that were not obtained
+    ///        from insert_unique are stored without interning them.
+    template<typename T>
+    void insert_mapping(const Key& key, std::shared_ptr<const T>& element) {
+        std::size_t hash = std::hash<T>()(*element);
+        std::size_t shard_index = compute_shard(hash);
+        CacheHandle handle;
+        {
+            Shard& shard = m_shards[shard_index];
+            auto shard_lock = lock(shard);
+            auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+            handle = t_cache.unique[t_cache.find_unique_slot(*element, hash)];
+            if (handle == invalid_handle || t_cache.objects[handle] != element) {
+                handle = emplace_object(t_cache, element, hash);
+            }
+        }
+        insert_mapping<T>(key, to_handle(shard_index, handle));
+    }
+
+    /// @brief Maps the key to the handle unless the key is mapped already.
+    ///        Returns the handle that the key is mapped to afterwards.
+    ///        Threads that race on the same key agree on the first handle.
+    template<typename T>
+    CacheHandle insert_or_get_mapping(const Key& key, CacheHandle handle) {
+        std::size_t hash = std::hash<Key>()(key);
+        Shard& shard = m_shards[compute_shard(hash)];
+        auto shard_lock = lock(shard);
+        return emplace_mapping(std::get<PerTypeCache<T>>(shard.cache), key, hash, handle);
+    }
+
+    /// @brief Interns the object and returns the handle of the unique copy.
+    template<typename T>
+    CacheHandle insert_unique_handle(T&& object) {
+        std::size_t hash = std::hash<T>()(object);
+        std::size_t shard_index = compute_shard(hash);
+        Shard& shard = m_shards[shard_index];
+        auto shard_lock = lock(shard);
+        auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+        std::size_t slot = t_cache.find_unique_slot(object, hash);
+        if (t_cache.unique[slot] != invalid_handle) {
+            return to_handle(shard_index, t_cache.unique[slot]);
+        }
+        CacheHandle local_handle = emplace_chunk_object(t_cache, std::move(object), hash);
+        t_cache.unique[slot] = local_handle;
+        if (2 * t_cache.hashes.size() > t_cache.unique.size()) {
+            t_cache.grow_unique();
+        }
+        return to_handle(shard_index, local_handle);
+    }
+
+    template<typename T>
+    std::shared_ptr<const T> insert_unique(T&& object) {
+        return get<T>(insert_unique_handle(std::move(object)));
+    }
+
+    /// @brief Removes all objects and mappings. Chunks that are still
+    ///        referenced by pointers are released with their last pointer.
+    void clear() {
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            m_shards[i].cache = std::tuple<PerTypeCache<Ts>...>();
+        }
+    }
+
+    std::size_t get_num_shards() const {
+        return std::size_t(1) << m_shard_bits;
+    }
+};
+
+
+/// @brief Maps keys to interned objects within a memory budget.
+///
+/// Objects are reference counted individually such that evicted objects stay
+/// valid as long as pointers to them exist. Whenever the estimated memory usage
+/// of mappings and objects exceeds the budget, mappings are evicted with the
+/// CLOCK policy, an approximation of least recently used: every mapping has a
+/// reference bit that is set when the mapping is inserted or hit, the clock
+/// hand clears set bits and evicts the first mapping whose bit is clear.
+/// Objects are released once no mapping refers to them.
+///
+/// A cache with more than one shard can be shared by threads. Keys are
+/// distributed over the shards by their hash value. Each shard has its own
+/// lock, clock and an equal share of the budget, and interns the objects of
+/// its keys. A cache with a single shard does not lock.
+template<typename Key, typename... Ts>
+class EvictingObjectCache {
 private:
-    // @brief Hashing of the underlying object.
     template<typename T>
     struct ValueHash {
         std::size_t operator()(const std::shared_ptr<const T>& ptr) const {
@@ -41,7 +381,6 @@ private:
         }
     };
 
-    /// @brief Equality comparison of the objects underlying the pointers.
     template<typename T>
     struct ValueEqual {
         bool operator()(const std::shared_ptr<const T>& left, const std::shared_ptr<const T>& right) const {
@@ -49,47 +388,244 @@ private:
         }
     };
 
+    struct UniqueEntry {
+        std::size_t num_mappings;
+        std::size_t memory_usage;
+    };
+
+    template<typename T>
+    struct MappingEntry {
+        std::shared_ptr<const T> object;
+        std::size_t clock_slot;
+    };
+
     template<typename T>
     struct PerTypeCache {
-        std::unordered_set<std::shared_ptr<const T>, ValueHash<T>, ValueEqual<T>> unique;
-        std::unordered_map<Key, std::shared_ptr<const T>> mapping;
+        std::unordered_map<std::shared_ptr<const T>, UniqueEntry, ValueHash<T>, ValueEqual<T>> unique;
+        std::unordered_map<Key, MappingEntry<T>> mapping;
+    };
+
+    struct ClockSlot {
+        Key key;
+        // Index of the type in Ts, free_slot if the slot is unused.
+        std::size_t type;
+        bool referenced;
+    };
+
+    static constexpr std::size_t free_slot = sizeof...(Ts);
+
+    // Bookkeeping of a mapping: hash node, key, entry and clock slot.
+    static constexpr std::size_t mapping_memory_usage =
+        2 * sizeof(void*) + sizeof(Key) + sizeof(MappingEntry<int>) + sizeof(ClockSlot);
+
+    // Bookkeeping of an object: hash node, control block and entry.
+    static constexpr std::size_t unique_memory_usage =
+        4 * sizeof(void*) + sizeof(std::shared_ptr<const int>) + sizeof(UniqueEntry);
+
+    // Aligned to avoid false sharing of locks between shards.
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::tuple<PerTypeCache<Ts>...> cache;
+        std::vector<ClockSlot> clock;
+        std::vector<std::size_t> free_slots;
+        std::size_t hand = 0;
+
+        std::size_t memory_usage = 0;
+        std::size_t num_hits = 0;
+        std::size_t num_misses = 0;
+        std::size_t num_evictions = 0;
     };
 
-    std::tuple<PerTypeCache<Ts>...> m_cache;
+    int m_shard_bits;
+    std::unique_ptr<Shard[]> m_shards;
+    std::size_t m_memory_budget;
+    std::size_t m_shard_memory_budget;
+
+    std::size_t compute_shard(const Key& key) const {
+        return m_shard_bits ? (std::hash<Key>()(key) * 0xC2B2AE3D27D4EB4Full) >> (64 - m_shard_bits) : 0;
+    }
+
+    std::unique_lock<std::mutex> lock(Shard& shard) const {
+        return m_shard_bits ? std::unique_lock<std::mutex>(shard.mutex) : std::unique_lock<std::mutex>();
+    }
+
+    template<typename T, std::size_t... Is>
+    static constexpr std::size_t compute_type_index(std::index_sequence<Is...>) {
+        return ((std::is_same_v<T, Ts> ? Is : 0) + ...);
+    }
+
+    template<typename T>
+    static constexpr std::size_t type_index = compute_type_index<T>(std::index_sequence_for<Ts...>());
+
+    template<typename T>
+    static void erase_mapping(Shard& shard, const Key& key) {
+        auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+        auto it = t_cache.mapping.find(key);
+        assert(it != t_cache.mapping.end());
+        auto unique_it = t_cache.unique.find(it->second.object);
+        assert(unique_it != t_cache.unique.end());
+        if (--unique_it->second.num_mappings == 0) {
+            shard.memory_usage -= unique_it->second.memory_usage;
+            t_cache.unique.erase(unique_it);
+        }
+        t_cache.mapping.erase(it);
+        shard.memory_usage -= mapping_memory_usage;
+    }
+
+    template<std::size_t... Is>
+    static void erase_mapping(Shard& shard, const Key& key, std::size_t type, std::index_sequence<Is...>) {
+        ((type == Is ? erase_mapping<Ts>(shard, key) : void()), ...);
+    }
+
+    void evict(Shard& shard) {
+        while (shard.memory_usage > m_shard_memory_budget && shard.free_slots.size() < shard.clock.size()) {
+            if (shard.hand >= shard.clock.size()) {
+                shard.hand = 0;
+            }
+            ClockSlot& slot = shard.clock[shard.hand];
+            if (slot.type != free_slot) {
+                if (slot.referenced) {
+                    slot.referenced = false;
+                } else {
+                    erase_mapping(shard, slot.key, slot.type, std::index_sequence_for<Ts...>());
+                    slot.type = free_slot;
+                    shard.free_slots.push_back(shard.hand);
+                    ++shard.num_evictions;
+                }
+            }
+            ++shard.hand;
+        }
+    }
+
+    template<typename F>
+    std::size_t sum(F&& function) const {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            auto shard_lock = lock(m_shards[i]);
+            result += function(m_shards[i]);
+        }
+        return result;
+    }
 
 public:
-    SharedObjectCache()  { }
+    /// @brief Creates a cache with the given number of shards, which is
+    ///        rounded up to a power of two. More than one shard makes
+    ///        the cache thread-safe.
+    EvictingObjectCache(std::size_t memory_budget, std::size_t num_shards = 1)
+        : m_shard_bits(std::countr_zero(std::bit_ceil(std::max<std::size_t>(num_shards, 1)))),
+          m_shards(std::make_unique<Shard[]>(std::size_t(1) << m_shard_bits)),
+          m_memory_budget(memory_budget),
+          m_shard_memory_budget(memory_budget >> m_shard_bits) {
+        if (m_shard_bits > 16) {
+            throw std::runtime_error("EvictingObjectCache::EvictingObjectCache - number of shards must not exceed 65536.");
+        }
+    }
+    EvictingObjectCache(const EvictingObjectCache& other) = delete;
+    EvictingObjectCache& operator=(const EvictingObjectCache& other) = delete;
+    EvictingObjectCache(EvictingObjectCache&& other) = default;
+    EvictingObjectCache& operator=(EvictingObjectCache&& other) = default;
 
+    /// @brief Returns the object mapped to the key or nullptr.
     template<typename T>
-    std::shared_ptr<const T> get(const Key& key) const {
-        auto& t_mapping = std::get<PerTypeCache<T>>(m_cache).mapping;
-        auto it = t_mapping.find(key);
-        if (it == t_mapping.end()) {
+    std::shared_ptr<const T> get(const Key& key) {
+        Shard& shard = m_shards[compute_shard(key)];
+        auto shard_lock = lock(shard);
+        auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+        auto it = t_cache.mapping.find(key);
+        if (it == t_cache.mapping.end()) {
+            ++shard.num_misses;
             return nullptr;
         }
-        return it->second;
+        ++shard.num_hits;
+        shard.clock[it->second.clock_slot].referenced = true;
+        return it->second.object;
     }
 
+    /// @brief Interns the object and maps the key to it unless the key is
+    ///        mapped already. Returns the object that the key is mapped to.
     template<typename T>
-    void insert_mapping(const Key& key, std::shared_ptr<const T>& element) {
-        auto& t_cache = std::get<PerTypeCache<T>>(m_cache);
-        auto& t_mapping = t_cache.mapping;
-        if (get<T>(key)) {
-            throw std::runtime_error("Must call get first before insertion.");
+    std::shared_ptr<const T> insert(const Key& key, T&& object) {
+        return insert_shared(key, std::make_shared<const T>(std::move(object)));
+    }
+
+    /// @brief Same as insert but takes an object that is already shared,
+    ///        e.g., the object of another key that may be evicted meanwhile.
+    template<typename T>
+    std::shared_ptr<const T> insert_shared(const Key& key, std::shared_ptr<const T> object) {
+        Shard& shard = m_shards[compute_shard(key)];
+        auto shard_lock = lock(shard);
+        auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+        auto it = t_cache.mapping.find(key);
+        if (it != t_cache.mapping.end()) {
+            return it->second.object;
+        }
+        std::size_t object_memory_usage = unique_memory_usage + compute_memory_usage(*object);
+        auto result = t_cache.unique.emplace(std::move(object), UniqueEntry{0, object_memory_usage});
+        if (result.second) {
+            shard.memory_usage += object_memory_usage;
         }
-        t_mapping.emplace(key, element);
+        ++result.first->second.num_mappings;
+        std::shared_ptr<const T> interned = result.first->first;
+
+        std::size_t clock_slot;
+        if (shard.free_slots.empty()) {
+            clock_slot = shard.clock.size();
+            shard.clock.push_back(ClockSlot{key, type_index<T>, true});
+        } else {
+            clock_slot = shard.free_slots.back();
+            shard.free_slots.pop_back();
+            shard.clock[clock_slot] = ClockSlot{key, type_index<T>, true};
+        }
+        t_cache.mapping.emplace(key, MappingEntry<T>{interned, clock_slot});
+        shard.memory_usage += mapping_memory_usage;
+        evict(shard);
+        return interned;
     }
 
+    /// @brief Recomputes the memory usage of the interned object after data
+    ///        was attached to it, e.g., lazily computed distances, and evicts
+    ///        mappings if the budget is exceeded. Ignores objects that are
+    ///        not interned, e.g., because they were evicted meanwhile.
     template<typename T>
-    std::shared_ptr<const T> insert_unique(T&& object) {
-        auto& t_cache = std::get<PerTypeCache<T>>(m_cache);
-        auto& t_unique = t_cache.unique;
-        auto result = t_unique.insert(std::make_shared<T>(std::move(object)));
-        return *result.first;
+    void update_memory_usage(const std::shared_ptr<const T>& object) {
+        // The object may be interned by several shards.
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            Shard& shard = m_shards[i];
+            auto shard_lock = lock(shard);
+            auto& t_cache = std::get<PerTypeCache<T>>(shard.cache);
+            auto it = t_cache.unique.find(object);
+            if (it == t_cache.unique.end() || it->first != object) {
+                continue;
+            }
+            std::size_t object_memory_usage = unique_memory_usage + compute_memory_usage(*object);
+            shard.memory_usage = shard.memory_usage - it->second.memory_usage + object_memory_usage;
+            it->second.memory_usage = object_memory_usage;
+            evict(shard);
+        }
     }
-};
 
+    /// @brief Removes all mappings. The counters are kept.
+    void clear() {
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            Shard& shard = m_shards[i];
+            auto shard_lock = lock(shard);
+            shard.cache = std::tuple<PerTypeCache<Ts>...>();
+            shard.clock.clear();
+            shard.free_slots.clear();
+            shard.hand = 0;
+            shard.memory_usage = 0;
+        }
+    }
+
+    std::size_t get_memory_budget() const { return m_memory_budget; }
+    std::size_t get_memory_usage() const { return sum([](const Shard& shard) { return shard.memory_usage; }); }
+    std::size_t get_num_mappings() const { return sum([](const Shard& shard) { return shard.clock.size() - shard.free_slots.size(); }); }
+    std::size_t get_num_hits() const { return sum([](const Shard& shard) { return shard.num_hits; }); }
+    std::size_t get_num_misses() const { return sum([](const Shard& shard) { return shard.num_misses; }); }
+    std::size_t get_num_evictions() const { return sum([](const Shard& shard) { return shard.num_evictions; }); }
+    std::size_t get_num_shards() const { return std::size_t(1) << m_shard_bits; }
+};
 }
 
 
-#endif
\ No newline at end of file
+#endif
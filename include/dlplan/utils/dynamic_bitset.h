@@ -3,17 +3,55 @@
 
 #include "hash.h"
 
+#include <bit>
 #include <cassert>
+#include <cstdint>
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 
+namespace dlplan {
 /*
-  Poor man's version of boost::dynamic_bitset, mostly copied from there.
+  Set algebra over arrays of 64-bit blocks.
+
+  The implementation is selected once at load time depending on the
+  instruction sets supported by the CPU, with a scalar fallback.
+  See src/utils/dynamic_bitset.cpp.
 */
-namespace dlplan {
+namespace bitset_kernels {
+enum class InstructionSet {
+    SCALAR,
+    AVX2,
+    AVX512,
+};
 
-template<typename Block = unsigned int>
+extern void bitwise_and(std::uint64_t* dst, const std::uint64_t* src, std::size_t num_blocks);
+extern void bitwise_or(std::uint64_t* dst, const std::uint64_t* src, std::size_t num_blocks);
+extern void bitwise_and_not(std::uint64_t* dst, const std::uint64_t* src, std::size_t num_blocks);
+extern void bitwise_not(std::uint64_t* dst, std::size_t num_blocks);
+extern bool intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+extern bool is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+extern bool equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+
+/// @brief Returns true iff the CPU supports the given instruction set.
+extern bool is_supported(InstructionSet instruction_set);
+/// @brief Returns the instruction set of the currently active kernels.
+extern InstructionSet get_instruction_set();
+/// @brief Switches the active kernels, e.g., for benchmarking.
+///        Throws if the instruction set is not supported.
+///        Not thread-safe with respect to concurrent set operations.
+extern void set_instruction_set(InstructionSet instruction_set);
+}
+
+
+/*
+  Poor man's version of boost::dynamic_bitset, mostly copied from there.
+
+  With 64-bit blocks, set operations on large bitsets are delegated
+  to the vectorized bitset_kernels.
+*/
+template<typename Block = std::uint64_t>
 class DynamicBitset {
     static_assert(
         !std::numeric_limits<Block>::is_signed,
@@ -27,6 +65,15 @@ class DynamicBitset {
 
     static const int bits_per_block = std::numeric_limits<Block>::digits;
 
+    // Below this number of blocks the inlined scalar loops beat the indirect kernel call.
+    static const std::size_t min_blocks_for_kernels = 8;
+
+    static constexpr bool has_kernels = std::is_same_v<Block, std::uint64_t>;
+
+    bool use_kernels() const {
+        return has_kernels && blocks.size() >= min_blocks_for_kernels;
+    }
+
     static int compute_num_blocks(std::size_t num_bits) {
         return num_bits / bits_per_block +
                static_cast<int>(num_bits % bits_per_block != 0);
@@ -44,6 +91,15 @@ class DynamicBitset {
         return Block(1) << bit_index(pos);
     }
 
+    std::size_t find_from_block(std::size_t first_block) const {
+        for (std::size_t i = first_block; i < blocks.size(); ++i) {
+            if (blocks[i]) {
+                return i * bits_per_block + std::countr_zero(blocks[i]);
+            }
+        }
+        return npos;
+    }
+
     int count_bits_in_last_block() const {
         return bit_index(num_bits);
     }
@@ -61,29 +117,85 @@ class DynamicBitset {
     //DynamicBitset() : blocks(std::vector<Block>()), num_bits(0) { }
 
 public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
     explicit DynamicBitset(std::size_t num_bits)
         : blocks(compute_num_blocks(num_bits), zeros),
           num_bits(num_bits) {
     }
 
+    /// @brief Creates a bitset with all bits unset in the given storage,
+    ///        which avoids an allocation if its capacity suffices.
+    DynamicBitset(std::size_t num_bits, std::vector<Block>&& storage)
+        : blocks(std::move(storage)),
+          num_bits(num_bits) {
+        blocks.assign(compute_num_blocks(num_bits), zeros);
+    }
+
+    /// @brief Creates a copy of other in the given storage.
+    DynamicBitset(const DynamicBitset& other, std::vector<Block>&& storage)
+        : blocks(std::move(storage)),
+          num_bits(other.num_bits) {
+        blocks.assign(other.blocks.begin(), other.blocks.end());
+    }
+
+    DynamicBitset(const DynamicBitset& other) = default;
+    DynamicBitset& operator=(const DynamicBitset& other) = default;
+    DynamicBitset(DynamicBitset&& other) = default;
+    DynamicBitset& operator=(DynamicBitset&& other) = default;
+
+    /// @brief Moves the storage out of the bitset, which is empty afterwards.
+    std::vector<Block> release_storage() {
+        std::vector<Block> storage = std::move(blocks);
+        blocks.clear();
+        num_bits = 0;
+        return storage;
+    }
+
+    /// @brief Returns the number of blocks that store the given number of bits.
+    static std::size_t get_num_blocks(std::size_t num_bits) {
+        return compute_num_blocks(num_bits);
+    }
+
     std::size_t size() const {
         return num_bits;
     }
 
     /*
-      Count the number of set bits.
-
-      The computation could be made faster by using a more sophisticated
-      algorithm (see https://en.wikipedia.org/wiki/Hamming_weight).
+      Count the number of set bits blockwise.
+      Unused bits in the last block are always zero.
     */
     int count() const {
         int result = 0;
-        for (std::size_t pos = 0; pos < num_bits; ++pos) {
-            result += static_cast<int>(test(pos));
+        for (const Block block : blocks) {
+            result += std::popcount(block);
         }
         return result;
     }
 
+    /*
+      Return the position of the first set bit or npos if there is none.
+    */
+    std::size_t find_first() const {
+        return find_from_block(0);
+    }
+
+    /*
+      Return the position of the first set bit after pos or npos if there is none.
+    */
+    std::size_t find_next(std::size_t pos) const {
+        ++pos;
+        if (pos >= num_bits) {
+            return npos;
+        }
+        const std::size_t i = block_index(pos);
+        const Block remaining = blocks[i] & (ones << bit_index(pos));
+        if (remaining) {
+            return i * bits_per_block + std::countr_zero(remaining);
+        }
+        return find_from_block(i + 1);
+    }
+
     bool none() const {
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             if (blocks[i]) return false;
@@ -115,13 +227,65 @@ public:
         return (blocks[block_index(pos)] & bit_mask(pos)) != 0;
     }
 
+    /*
+      Copy the bits in [pos, pos + count) to dst starting at bit 0.
+      dst must provide space for ceil(count / bits_per_block) blocks.
+    */
+    void read_range(std::size_t pos, std::size_t count, Block* dst) const {
+        assert(pos + count <= num_bits);
+        const std::size_t num_dst_blocks = compute_num_blocks(count);
+        const std::size_t offset = bit_index(pos);
+        std::size_t src = block_index(pos);
+        for (std::size_t i = 0; i < num_dst_blocks; ++i, ++src) {
+            Block value = blocks[src] >> offset;
+            if (offset != 0 && src + 1 < blocks.size()) {
+                value |= blocks[src + 1] << (bits_per_block - offset);
+            }
+            dst[i] = value;
+        }
+        const std::size_t rest = count % bits_per_block;
+        if (rest != 0) {
+            dst[num_dst_blocks - 1] &= ~(ones << rest);
+        }
+    }
+
+    /*
+      Bitwise-or the first count bits of src into [pos, pos + count).
+    */
+    void or_range(std::size_t pos, std::size_t count, const Block* src) {
+        assert(pos + count <= num_bits);
+        const std::size_t num_src_blocks = compute_num_blocks(count);
+        const std::size_t offset = bit_index(pos);
+        const std::size_t rest = count % bits_per_block;
+        std::size_t dst = block_index(pos);
+        for (std::size_t i = 0; i < num_src_blocks; ++i, ++dst) {
+            Block value = src[i];
+            if (rest != 0 && i + 1 == num_src_blocks) {
+                value &= ~(ones << rest);
+            }
+            blocks[dst] |= value << offset;
+            if (offset != 0) {
+                const Block high = value >> (bits_per_block - offset);
+                if (high) blocks[dst + 1] |= high;
+            }
+        }
+    }
+
     bool operator[](std::size_t pos) const {
         return test(pos);
     }
 
     bool operator==(const DynamicBitset& other) const {
         if (this != &other) {
-            return (blocks == other.blocks) && (num_bits == other.num_bits);
+            if (num_bits != other.num_bits) {
+                return false;
+            }
+            if constexpr (has_kernels) {
+                if (use_kernels()) {
+                    return bitset_kernels::equal(blocks.data(), other.blocks.data(), blocks.size());
+                }
+            }
+            return blocks == other.blocks;
         }
         return true;
     }
@@ -132,6 +296,12 @@ public:
 
     DynamicBitset& operator&=(const DynamicBitset& other) {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                bitset_kernels::bitwise_and(blocks.data(), other.blocks.data(), blocks.size());
+                return *this;
+            }
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] &= other.blocks[i];
         }
@@ -140,6 +310,12 @@ public:
 
     DynamicBitset& operator|=(const DynamicBitset& other) {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                bitset_kernels::bitwise_or(blocks.data(), other.blocks.data(), blocks.size());
+                return *this;
+            }
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] |= other.blocks[i];
         }
@@ -148,6 +324,12 @@ public:
 
     DynamicBitset& operator-=(const DynamicBitset& other) {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                bitset_kernels::bitwise_and_not(blocks.data(), other.blocks.data(), blocks.size());
+                return *this;
+            }
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] = blocks[i] & ~other.blocks[i];
         }
@@ -155,6 +337,13 @@ public:
     }
 
     DynamicBitset& operator~() {
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                bitset_kernels::bitwise_not(blocks.data(), blocks.size());
+                zero_unused_bits();
+                return *this;
+            }
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] = ~blocks[i];
         }
@@ -164,6 +353,11 @@ public:
 
     bool intersects(const DynamicBitset &other) const {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                return bitset_kernels::intersects(blocks.data(), other.blocks.data(), blocks.size());
+            }
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             if (blocks[i] & other.blocks[i])
                 return true;
@@ -173,6 +367,11 @@ public:
 
     bool is_subset_of(const DynamicBitset &other) const {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                return bitset_kernels::is_subset_of(blocks.data(), other.blocks.data(), blocks.size());
+            }
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             if (blocks[i] & ~other.blocks[i])
                 return false;
@@ -180,6 +379,30 @@ public:
         return true;
     }
 
+    /*
+      Count the number of bits set in both bitsets blockwise.
+    */
+    int count_intersection(const DynamicBitset &other) const {
+        assert(size() == other.size());
+        int result = 0;
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            result += std::popcount(static_cast<Block>(blocks[i] & other.blocks[i]));
+        }
+        return result;
+    }
+
+    /*
+      Return true iff the intersection with other is a subset of superset.
+    */
+    bool is_intersection_subset_of(const DynamicBitset &other, const DynamicBitset &superset) const {
+        assert(size() == other.size() && size() == superset.size());
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            if (blocks[i] & other.blocks[i] & ~superset.blocks[i])
+                return false;
+        }
+        return true;
+    }
+
     std::size_t hash() const {
         return hash_vector(blocks);
     }
@@ -1,3 +1,5 @@
+#include "evaluation_workspace.h"
+
 #include "../../include/dlplan/core.h"
 
 #include "../utils/logging.h"
@@ -13,9 +15,10 @@
 namespace dlplan::core {
 // we assign index undefined since we do not care
 ConceptDenotation::ConceptDenotation(int num_objects)
-    : Base<ConceptDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_data(DynamicBitset<unsigned>(num_objects)) { }
+    : Base<ConceptDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_data(make_bitset(num_objects)) { }
 
-ConceptDenotation::ConceptDenotation(const ConceptDenotation& other) = default;
+ConceptDenotation::ConceptDenotation(const ConceptDenotation& other)
+    : Base<ConceptDenotation>(other), m_num_objects(other.m_num_objects), m_data(copy_bitset(other.m_data)) { }
 
 ConceptDenotation& ConceptDenotation::operator=(const ConceptDenotation& other) = default;
 
@@ -23,7 +26,9 @@ ConceptDenotation::ConceptDenotation(ConceptDenotation&& other) = default;
 
 ConceptDenotation& ConceptDenotation::operator=(ConceptDenotation&& other) = default;
 
-ConceptDenotation::~ConceptDenotation() = default;
+ConceptDenotation::~ConceptDenotation() {
+    release_bitset(m_data);
+}
 
 bool ConceptDenotation::are_equal_impl(const ConceptDenotation& other) const {
     if (this != &other) {
@@ -72,6 +77,10 @@ void ConceptDenotation::set() {
     m_data.set();
 }
 
+void ConceptDenotation::clear() {
+    m_data.reset();
+}
+
 void ConceptDenotation::insert(ObjectIndex value) {
     assert(value >= 0 && value < m_num_objects);
     m_data.set(value);
@@ -98,6 +107,14 @@ bool ConceptDenotation::is_subset_of(const ConceptDenotation& other) const {
     return m_data.is_subset_of(other.m_data);
 }
 
+int ConceptDenotation::intersection_size(const ConceptDenotation& other) const {
+    return m_data.count_intersection(other.m_data);
+}
+
+bool ConceptDenotation::intersection_is_subset_of(const ConceptDenotation& other, const ConceptDenotation& superset) const {
+    return m_data.is_intersection_subset_of(other.m_data, superset.m_data);
+}
+
 ObjectIndices ConceptDenotation::to_vector() const {
     // In the case of bitset, the to_sorted_vector has best runtime complexity.
     return to_sorted_vector();
@@ -105,13 +122,8 @@ ObjectIndices ConceptDenotation::to_vector() const {
 
 ObjectIndices ConceptDenotation::to_sorted_vector() const {
     ObjectIndices result;
-    result.reserve(m_num_objects);
-    for (ObjectIndex i = 0; i < m_num_objects; ++i) {
-        if (m_data.test(i)) {
-            result.push_back(i);
-        }
-    }
-    result.shrink_to_fit();
+    result.reserve(size());
+    for_each([&](ObjectIndex i) { result.push_back(i); });
     return result;
 }
 
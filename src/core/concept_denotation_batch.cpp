@@ -0,0 +1,188 @@
+#include "../../include/dlplan/core.h"
+
+#include "../utils/logging.h"
+#include "../../include/dlplan/utils/hash.h"
+#include "../../include/dlplan/utils/dynamic_bitset.h"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+
+namespace dlplan::core {
+static std::size_t compute_blocks_per_row(const std::vector<int>& num_objects) {
+    int max_num_objects = num_objects.empty() ? 0 : *std::max_element(num_objects.begin(), num_objects.end());
+    return (max_num_objects + 63) / 64;
+}
+
+static std::vector<int> compute_num_objects(const States& states) {
+    std::vector<int> num_objects;
+    num_objects.reserve(states.size());
+    for (const auto& state : states) {
+        num_objects.push_back(state.get_instance_info()->get_objects().size());
+    }
+    return num_objects;
+}
+
+static std::vector<int> compute_num_objects(const ConceptDenotations& denotations) {
+    std::vector<int> num_objects;
+    num_objects.reserve(denotations.size());
+    for (const auto& denotation : denotations) {
+        num_objects.push_back(denotation->get_num_objects());
+    }
+    return num_objects;
+}
+
+// we assign index undefined since we do not care
+ConceptDenotationBatch::ConceptDenotationBatch(const States& states)
+    : Base<ConceptDenotationBatch>(std::numeric_limits<int>::max()),
+      m_num_objects(compute_num_objects(states)),
+      m_blocks_per_row(compute_blocks_per_row(m_num_objects)),
+      m_blocks(m_num_objects.size() * m_blocks_per_row, 0) { }
+
+ConceptDenotationBatch::ConceptDenotationBatch(const ConceptDenotations& denotations)
+    : Base<ConceptDenotationBatch>(std::numeric_limits<int>::max()),
+      m_num_objects(compute_num_objects(denotations)),
+      m_blocks_per_row(compute_blocks_per_row(m_num_objects)),
+      m_blocks(m_num_objects.size() * m_blocks_per_row, 0) {
+    for (size_t row = 0; row < denotations.size(); ++row) {
+        denotations[row]->m_data.read_range(0, m_num_objects[row], &m_blocks[row * m_blocks_per_row]);
+    }
+}
+
+ConceptDenotationBatch::ConceptDenotationBatch(const ConceptDenotationBatch& other) = default;
+
+ConceptDenotationBatch& ConceptDenotationBatch::operator=(const ConceptDenotationBatch& other) = default;
+
+ConceptDenotationBatch::ConceptDenotationBatch(ConceptDenotationBatch&& other) = default;
+
+ConceptDenotationBatch& ConceptDenotationBatch::operator=(ConceptDenotationBatch&& other) = default;
+
+ConceptDenotationBatch::~ConceptDenotationBatch() = default;
+
+void ConceptDenotationBatch::clear_padding() {
+    for (size_t row = 0; row < m_num_objects.size(); ++row) {
+        std::uint64_t* blocks = &m_blocks[row * m_blocks_per_row];
+        std::size_t num_objects = m_num_objects[row];
+        std::size_t first_padding_block = num_objects / 64;
+        if (first_padding_block < m_blocks_per_row && num_objects % 64) {
+            blocks[first_padding_block] &= (std::uint64_t(1) << (num_objects % 64)) - 1;
+            ++first_padding_block;
+        }
+        std::fill(blocks + first_padding_block, blocks + m_blocks_per_row, 0);
+    }
+}
+
+bool ConceptDenotationBatch::are_equal_impl(const ConceptDenotationBatch& other) const {
+    if (this != &other) {
+        return m_num_objects == other.m_num_objects && m_blocks == other.m_blocks;
+    }
+    return true;
+}
+
+void ConceptDenotationBatch::str_impl(std::stringstream& out) const {
+    out << "ConceptDenotationBatch(";
+    for (int row = 0; row < get_num_rows(); ++row) {
+        if (row > 0) out << ", ";
+        out << get_denotation(row).str();
+    }
+    out << ")";
+}
+
+std::size_t ConceptDenotationBatch::hash_impl() const {
+    return hash_combine(hash_vector(m_num_objects), hash_vector(m_blocks));
+}
+
+ConceptDenotationBatch& ConceptDenotationBatch::operator&=(const ConceptDenotationBatch& other) {
+    assert(m_num_objects == other.m_num_objects);
+    bitset_kernels::bitwise_and(m_blocks.data(), other.m_blocks.data(), m_blocks.size());
+    return *this;
+}
+
+ConceptDenotationBatch& ConceptDenotationBatch::operator|=(const ConceptDenotationBatch& other) {
+    assert(m_num_objects == other.m_num_objects);
+    bitset_kernels::bitwise_or(m_blocks.data(), other.m_blocks.data(), m_blocks.size());
+    return *this;
+}
+
+ConceptDenotationBatch& ConceptDenotationBatch::operator-=(const ConceptDenotationBatch& other) {
+    assert(m_num_objects == other.m_num_objects);
+    bitset_kernels::bitwise_and_not(m_blocks.data(), other.m_blocks.data(), m_blocks.size());
+    return *this;
+}
+
+ConceptDenotationBatch& ConceptDenotationBatch::operator~() {
+    bitset_kernels::bitwise_not(m_blocks.data(), m_blocks.size());
+    clear_padding();
+    return *this;
+}
+
+bool ConceptDenotationBatch::contains(int row, ObjectIndex value) const {
+    return (m_blocks[row * m_blocks_per_row + value / 64] >> (value % 64)) & 1;
+}
+
+void ConceptDenotationBatch::set(int row) {
+    std::uint64_t* blocks = &m_blocks[row * m_blocks_per_row];
+    std::fill(blocks, blocks + m_blocks_per_row, ~std::uint64_t(0));
+    std::size_t num_objects = m_num_objects[row];
+    std::size_t num_full_blocks = num_objects / 64;
+    if (num_full_blocks < m_blocks_per_row) {
+        blocks[num_full_blocks] = (std::uint64_t(1) << (num_objects % 64)) - 1;
+        std::fill(blocks + num_full_blocks + 1, blocks + m_blocks_per_row, 0);
+    }
+}
+
+void ConceptDenotationBatch::assign(int row, const ConceptDenotation& denotation) {
+    assert(denotation.get_num_objects() == m_num_objects[row]);
+    std::uint64_t* blocks = &m_blocks[row * m_blocks_per_row];
+    std::fill(blocks, blocks + m_blocks_per_row, 0);
+    denotation.m_data.read_range(0, m_num_objects[row], blocks);
+}
+
+void ConceptDenotationBatch::insert(int row, ObjectIndex value) {
+    m_blocks[row * m_blocks_per_row + value / 64] |= std::uint64_t(1) << (value % 64);
+}
+
+void ConceptDenotationBatch::erase(int row, ObjectIndex value) {
+    m_blocks[row * m_blocks_per_row + value / 64] &= ~(std::uint64_t(1) << (value % 64));
+}
+
+NumericalDenotations ConceptDenotationBatch::count() const {
+    NumericalDenotations result;
+    result.reserve(m_num_objects.size());
+    for (size_t row = 0; row < m_num_objects.size(); ++row) {
+        const std::uint64_t* blocks = &m_blocks[row * m_blocks_per_row];
+        int count = 0;
+        for (std::size_t b = 0; b < m_blocks_per_row; ++b) {
+            count += std::popcount(blocks[b]);
+        }
+        result.push_back(count);
+    }
+    return result;
+}
+
+BooleanDenotations ConceptDenotationBatch::empty() const {
+    BooleanDenotations result;
+    result.reserve(m_num_objects.size());
+    for (size_t row = 0; row < m_num_objects.size(); ++row) {
+        const std::uint64_t* blocks = &m_blocks[row * m_blocks_per_row];
+        result.push_back(std::all_of(blocks, blocks + m_blocks_per_row, [](std::uint64_t block) { return block == 0; }));
+    }
+    return result;
+}
+
+ConceptDenotation ConceptDenotationBatch::get_denotation(int row) const {
+    ConceptDenotation result(m_num_objects[row]);
+    result.m_data.or_range(0, m_num_objects[row], &m_blocks[row * m_blocks_per_row]);
+    return result;
+}
+
+int ConceptDenotationBatch::get_num_rows() const {
+    return m_num_objects.size();
+}
+
+int ConceptDenotationBatch::get_num_objects(int row) const {
+    return m_num_objects[row];
+}
+
+}
@@ -1,6 +1,7 @@
 #include "../../include/dlplan/core.h"
 
 #include "element_factory.h"
+#include "evaluation_program.h"
 #include "../../include/dlplan/utils/hash.h"
 
 
@@ -32,6 +33,9 @@ namespace std {
     size_t hash<dlplan::core::RoleDenotations>::operator()(const dlplan::core::RoleDenotations& denotations) const {
         return dlplan::hash_vector(denotations);
     }
+    size_t hash<dlplan::core::ConceptDenotationBatch>::operator()(const dlplan::core::ConceptDenotationBatch& batch) const {
+        return batch.hash();
+    }
     size_t hash<dlplan::core::DenotationsCacheKey>::operator()(const dlplan::core::DenotationsCacheKey& key) const {
         return key.hash();
     }
@@ -255,8 +259,89 @@ std::shared_ptr<const Role>SyntacticElementFactory::make_transitive_reflexive_cl
     return m_pImpl->make_transitive_reflexive_closure(role);
 }
 
+std::vector<std::shared_ptr<const ConceptDenotations>> evaluate(const std::vector<std::shared_ptr<const Concept>>& concepts, const States& states, DenotationsCaches& caches, Executor& executor) {
+    std::vector<const Concept*> elements;
+    for (const auto& concept_ : concepts) elements.push_back(concept_.get());
+    return Concept::evaluate_elements(elements, states, caches, executor);
+}
+
+std::vector<std::shared_ptr<const RoleDenotations>> evaluate(const std::vector<std::shared_ptr<const Role>>& roles, const States& states, DenotationsCaches& caches, Executor& executor) {
+    std::vector<const Role*> elements;
+    for (const auto& role : roles) elements.push_back(role.get());
+    return Role::evaluate_elements(elements, states, caches, executor);
+}
+
+std::vector<std::shared_ptr<const BooleanDenotations>> evaluate(const std::vector<std::shared_ptr<const Boolean>>& booleans, const States& states, DenotationsCaches& caches, Executor& executor) {
+    std::vector<const Boolean*> elements;
+    for (const auto& boolean : booleans) elements.push_back(boolean.get());
+    return Boolean::evaluate_elements(elements, states, caches, executor);
+}
+
+std::vector<std::shared_ptr<const NumericalDenotations>> evaluate(const std::vector<std::shared_ptr<const Numerical>>& numericals, const States& states, DenotationsCaches& caches, Executor& executor) {
+    std::vector<const Numerical*> elements;
+    for (const auto& numerical : numericals) elements.push_back(numerical.get());
+    return Numerical::evaluate_elements(elements, states, caches, executor);
+}
+
+
+EvaluationProgram::EvaluationProgram(
+    const std::vector<std::shared_ptr<const Boolean>>& booleans,
+    const std::vector<std::shared_ptr<const Numerical>>& numericals,
+    const std::vector<std::shared_ptr<const Concept>>& concepts,
+    const std::vector<std::shared_ptr<const Role>>& roles)
+    : m_pImpl(EvaluationProgramImpl(booleans, numericals, concepts, roles)) { }
+
+EvaluationProgram::EvaluationProgram(const EvaluationProgram& other) : m_pImpl(*other.m_pImpl) { }
+
+EvaluationProgram& EvaluationProgram::operator=(const EvaluationProgram& other) {
+    if (this != &other) {
+        *m_pImpl = *other.m_pImpl;
+    }
+    return *this;
+}
+
+EvaluationProgram::EvaluationProgram(EvaluationProgram&& other)
+    : m_pImpl(std::move(*other.m_pImpl)) { }
+
+EvaluationProgram& EvaluationProgram::operator=(EvaluationProgram&& other) {
+    if (this != &other) {
+        std::swap(*m_pImpl, *other.m_pImpl);
+    }
+    return *this;
+}
+
+EvaluationProgram::~EvaluationProgram() = default;
+
+void EvaluationProgram::evaluate(const State& state) {
+    m_pImpl->evaluate(state);
+}
+
+bool EvaluationProgram::get_boolean_value(int pos) const {
+    return m_pImpl->get_boolean_value(pos);
+}
+
+int EvaluationProgram::get_numerical_value(int pos) const {
+    return m_pImpl->get_numerical_value(pos);
+}
+
+const ConceptDenotation& EvaluationProgram::get_concept_denotation(int pos) const {
+    return m_pImpl->get_concept_denotation(pos);
+}
+
+const RoleDenotation& EvaluationProgram::get_role_denotation(int pos) const {
+    return m_pImpl->get_role_denotation(pos);
+}
+
+int EvaluationProgram::get_num_instructions() const {
+    return m_pImpl->get_num_instructions();
+}
+
+int EvaluationProgram::get_num_registers() const {
+    return m_pImpl->get_num_registers();
+}
+
 // Explicit template instantiations
-template class Element<ConceptDenotation, ConceptDenotations>;
+template class Element<ConceptDenotation, ConceptDenotations, ConceptDenotationBatch>;
 template class Element<RoleDenotation, RoleDenotations>;
 template class ElementLight<bool, BooleanDenotations>;
 template class ElementLight<int, NumericalDenotations>;
@@ -271,5 +356,11 @@ template class SharedObjectCache<core::DenotationsCacheKey,
     core::ConceptDenotations,
     core::RoleDenotations,
     core::BooleanDenotations,
-    core::NumericalDenotations>;
+    core::NumericalDenotations,
+    core::ConceptDenotationBatch>;
+template class EvictingObjectCache<core::DenotationsCacheKey,
+    core::ConceptDenotation,
+    core::RoleDenotation,
+    bool,
+    int>;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../../include/dlplan/core.h"
+#include "../../include/dlplan/core/elements/utils.h"
 
 #include "../../include/dlplan/utils/hash.h"
 
@@ -7,12 +8,24 @@ namespace dlplan::core {
 
 DenotationsCaches::DenotationsCaches() = default;
 
+DenotationsCaches::DenotationsCaches(std::size_t num_shards)
+    : data(num_shards) { }
+
+DenotationsCaches::DenotationsCaches(std::size_t num_shards, std::size_t memory_budget)
+    : DenotationsCaches(num_shards) {
+    per_state_data = std::make_unique<decltype(per_state_data)::element_type>(memory_budget, data.get_num_shards());
+}
+
 DenotationsCaches::~DenotationsCaches() = default;
 
 DenotationsCaches::DenotationsCaches(DenotationsCaches&& other) = default;
 
 DenotationsCaches& DenotationsCaches::operator=(DenotationsCaches&& other) = default;
 
+bool DenotationsCaches::is_thread_safe() const {
+    return data.get_num_shards() > 1;
+}
+
 bool DenotationsCacheKey::operator==(const DenotationsCacheKey& other) const {
     return (element == other.element) &&
            (instance == other.instance) &&
@@ -23,4 +36,26 @@ size_t DenotationsCacheKey::hash() const {
     return hash_combine(element, instance, state);
 }
 
+std::size_t compute_memory_usage(const ConceptDenotation& denotation) {
+    return sizeof(ConceptDenotation) + (denotation.get_num_objects() + 63) / 64 * sizeof(std::uint64_t);
+}
+
+std::size_t compute_memory_usage(const RoleDenotation& denotation) {
+    std::size_t num_pairs = static_cast<std::size_t>(denotation.get_num_objects()) * denotation.get_num_objects();
+    std::size_t result = sizeof(RoleDenotation);
+    if (!denotation.m_is_dense) {
+        result += denotation.m_positions.capacity() * sizeof(std::uint64_t);
+    } else {
+        result += (num_pairs + 63) / 64 * sizeof(std::uint64_t);
+    }
+    if (denotation.m_pairwise_distances.load(std::memory_order_acquire)) {
+        result += sizeof(PairwiseDistances) + num_pairs * sizeof(int);
+    }
+    return result;
+}
+
+std::size_t compute_memory_usage(const ConceptDenotationBatch& batch) {
+    return sizeof(ConceptDenotationBatch) + batch.m_num_objects.capacity() * sizeof(int) + batch.m_blocks.capacity() * sizeof(std::uint64_t);
+}
+
 }
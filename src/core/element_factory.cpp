@@ -13,10 +13,28 @@ using namespace dlplan;
 
 namespace dlplan::core {
 
+/// @brief Returns the element as T if its dynamic type is T and nullptr otherwise.
+template<typename T, typename E>
+static const T* as(const std::shared_ptr<const E>& element) {
+    return dynamic_cast<const T*>(element.get());
+}
+
 SyntacticElementFactoryImpl::SyntacticElementFactoryImpl(std::shared_ptr<VocabularyInfo> vocabulary_info)
     : m_vocabulary_info(vocabulary_info) {
 }
 
+bool SyntacticElementFactoryImpl::is_complement(const std::shared_ptr<const Concept>& concept_left, const std::shared_ptr<const Concept>& concept_right) {
+    const auto not_left = as<NotConcept>(concept_left);
+    const auto not_right = as<NotConcept>(concept_right);
+    return (not_left && not_left->m_concept == concept_right) || (not_right && not_right->m_concept == concept_left);
+}
+
+bool SyntacticElementFactoryImpl::is_complement(const std::shared_ptr<const Role>& role_left, const std::shared_ptr<const Role>& role_right) {
+    const auto not_left = as<NotRole>(role_left);
+    const auto not_right = as<NotRole>(role_right);
+    return (not_left && not_left->m_role == role_right) || (not_right && not_right->m_role == role_left);
+}
+
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::parse_concept(SyntacticElementFactory& parent,
     const std::string &description, const std::string& filename) {
     iterator_type iter(description.begin());
@@ -190,10 +208,14 @@ std::shared_ptr<const Boolean> SyntacticElementFactoryImpl::make_nullary_boolean
 }
 
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_all_concept(const std::shared_ptr<const Role>& role, const std::shared_ptr<const Concept>& concept_) {
+    if (as<TopConcept>(concept_)) return concept_;
     return m_cache.get_or_create<AllConcept>(m_vocabulary_info, role, concept_).object;
 }
 
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_and_concept(const std::shared_ptr<const Concept>& concept_left, const std::shared_ptr<const Concept>& concept_right) {
+    if (concept_left == concept_right || as<TopConcept>(concept_right) || as<BotConcept>(concept_left)) return concept_left;
+    if (as<TopConcept>(concept_left) || as<BotConcept>(concept_right)) return concept_right;
+    if (is_complement(concept_left, concept_right)) return make_bot_concept();
     return m_cache.get_or_create<AndConcept>(m_vocabulary_info, concept_left, concept_right).object;
 }
 
@@ -202,14 +224,21 @@ std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_bot_concept() {
 }
 
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_diff_concept(const std::shared_ptr<const Concept>& concept_left, const std::shared_ptr<const Concept>& concept_right) {
+    if (concept_left == concept_right || as<TopConcept>(concept_right)) return make_bot_concept();
+    if (as<BotConcept>(concept_left) || as<BotConcept>(concept_right)) return concept_left;
+    if (as<TopConcept>(concept_left)) return make_not_concept(concept_right);
     return m_cache.get_or_create<DiffConcept>(m_vocabulary_info, concept_left, concept_right).object;
 }
 
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_equal_concept(const std::shared_ptr<const Role>& role_left, const std::shared_ptr<const Role>& role_right) {
+    if (role_left == role_right) return make_top_concept();
     return m_cache.get_or_create<EqualConcept>(m_vocabulary_info, role_left, role_right).object;
 }
 
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_not_concept(const std::shared_ptr<const Concept>& concept_) {
+    if (const auto not_concept = as<NotConcept>(concept_)) return not_concept->m_concept;
+    if (as<TopConcept>(concept_)) return make_bot_concept();
+    if (as<BotConcept>(concept_)) return make_top_concept();
     return m_cache.get_or_create<NotConcept>(m_vocabulary_info, concept_).object;
 }
 
@@ -218,6 +247,9 @@ std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_one_of_concept(
 }
 
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_or_concept(const std::shared_ptr<const Concept>& concept_left, const std::shared_ptr<const Concept>& concept_right) {
+    if (concept_left == concept_right || as<BotConcept>(concept_right) || as<TopConcept>(concept_left)) return concept_left;
+    if (as<BotConcept>(concept_left) || as<TopConcept>(concept_right)) return concept_right;
+    if (is_complement(concept_left, concept_right)) return make_top_concept();
     return m_cache.get_or_create<OrConcept>(m_vocabulary_info, concept_left, concept_right).object;
 }
 
@@ -230,6 +262,7 @@ std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_primitive_conce
 }
 
 std::shared_ptr<const Concept> SyntacticElementFactoryImpl::make_some_concept(const std::shared_ptr<const Role>& role, const std::shared_ptr<const Concept>& concept_) {
+    if (as<BotConcept>(concept_)) return concept_;
     return m_cache.get_or_create<SomeConcept>(m_vocabulary_info, role, concept_).object;
 }
 
@@ -266,6 +299,8 @@ std::shared_ptr<const Numerical> SyntacticElementFactoryImpl::make_sum_role_dist
 }
 
 std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_and_role(const std::shared_ptr<const Role>& role_left, const std::shared_ptr<const Role>& role_right) {
+    if (role_left == role_right || as<TopRole>(role_right)) return role_left;
+    if (as<TopRole>(role_left)) return role_right;
     return m_cache.get_or_create<AndRole>(m_vocabulary_info, role_left, role_right).object;
 }
 
@@ -282,14 +317,20 @@ std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_identity_role(cons
 }
 
 std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_inverse_role(const std::shared_ptr<const Role>& role) {
+    if (const auto inverse_role = as<InverseRole>(role)) return inverse_role->m_role;
+    if (as<TopRole>(role)) return role;
     return m_cache.get_or_create<InverseRole>(m_vocabulary_info, role).object;
 }
 
 std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_not_role(const std::shared_ptr<const Role>& role) {
+    if (const auto not_role = as<NotRole>(role)) return not_role->m_role;
     return m_cache.get_or_create<NotRole>(m_vocabulary_info, role).object;
 }
 
 std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_or_role(const std::shared_ptr<const Role>& role_left, const std::shared_ptr<const Role>& role_right) {
+    if (role_left == role_right || as<TopRole>(role_left)) return role_left;
+    if (as<TopRole>(role_right)) return role_right;
+    if (is_complement(role_left, role_right)) return make_top_role();
     return m_cache.get_or_create<OrRole>(m_vocabulary_info, role_left, role_right).object;
 }
 
@@ -298,6 +339,7 @@ std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_primitive_role(con
 }
 
 std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_restrict_role(const std::shared_ptr<const Role>& role, const std::shared_ptr<const Concept>& concept_) {
+    if (as<TopConcept>(concept_)) return role;
     return m_cache.get_or_create<RestrictRole>(m_vocabulary_info, role, concept_).object;
 }
 
@@ -310,10 +352,13 @@ std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_top_role() {
 }
 
 std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_transitive_closure(const std::shared_ptr<const Role>& role) {
+    if (as<TransitiveClosureRole>(role) || as<TopRole>(role)) return role;
     return m_cache.get_or_create<TransitiveClosureRole>(m_vocabulary_info, role).object;
 }
 
 std::shared_ptr<const Role> SyntacticElementFactoryImpl::make_transitive_reflexive_closure(const std::shared_ptr<const Role>& role) {
+    if (as<TransitiveReflexiveClosureRole>(role) || as<TopRole>(role)) return role;
+    if (const auto transitive_closure = as<TransitiveClosureRole>(role)) return make_transitive_reflexive_closure(transitive_closure->m_role);
     return m_cache.get_or_create<TransitiveReflexiveClosureRole>(m_vocabulary_info, role).object;
 }
 
@@ -86,6 +86,10 @@ private:
         , TransitiveClosureRole
         , TransitiveReflexiveClosureRole> m_cache;
 
+    /// @brief Returns true iff one of the elements is the negation of the other.
+    static bool is_complement(const std::shared_ptr<const Concept>& concept_left, const std::shared_ptr<const Concept>& concept_right);
+    static bool is_complement(const std::shared_ptr<const Role>& role_left, const std::shared_ptr<const Role>& role_right);
+
 public:
     SyntacticElementFactoryImpl(std::shared_ptr<VocabularyInfo> vocabulary_info);
 
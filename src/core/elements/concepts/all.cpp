@@ -5,9 +5,20 @@ namespace dlplan::core {
 void AllConcept::compute_result(const RoleDenotation& role_denot, const ConceptDenotation& concept_denot, ConceptDenotation& result) const {
     // find counterexamples b : exists b . (a,b) in R and b notin C
     result.set();
-    for (const auto& pair : role_denot.to_vector()) {
-        if (!concept_denot.contains(pair.second)) {
-            result.erase(pair.first);
+    role_denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        if (!concept_denot.contains(second)) {
+            result.erase(first);
+        }
+    });
+}
+
+void AllConcept::compute_result(const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_denot, ConceptDenotation& result) const {
+    result.set();
+    for (ObjectIndex second = 0; second < role_adjacency.get_num_objects(); ++second) {
+        if (!concept_denot.contains(second)) {
+            for (ObjectIndex first : role_adjacency.get_predecessors(second)) {
+                result.erase(first);
+            }
         }
     }
 }
@@ -15,7 +26,7 @@ void AllConcept::compute_result(const RoleDenotation& role_denot, const ConceptD
 ConceptDenotation AllConcept::evaluate_impl(const State& state, DenotationsCaches& caches) const {
     ConceptDenotation denotation(state.get_instance_info()->get_objects().size());
     compute_result(
-        *m_role->evaluate(state, caches),
+        m_role->evaluate(state, caches)->get_adjacency(),
         *m_concept->evaluate(state, caches),
         denotation);
     return denotation;
@@ -29,7 +40,7 @@ ConceptDenotations AllConcept::evaluate_impl(const States& states, DenotationsCa
     for (size_t i = 0; i < states.size(); ++i) {
         ConceptDenotation denotation(states[i].get_instance_info()->get_objects().size());
         compute_result(
-            *(*role_denotations)[i],
+            (*role_denotations)[i]->get_adjacency(),
             *(*concept_denotations)[i],
             denotation);
         denotations.push_back(caches.data.insert_unique<ConceptDenotation>(std::move(denotation)));
@@ -37,8 +48,26 @@ ConceptDenotations AllConcept::evaluate_impl(const States& states, DenotationsCa
     return denotations;
 }
 
+ConceptDenotationBatch AllConcept::evaluate_batch_impl(const States& states, DenotationsCaches& caches) const {
+    ConceptDenotationBatch batch(states);
+    auto role_denotations = m_role->evaluate(states, caches);
+    auto concept_batch = m_concept->evaluate_batch(states, caches);
+    for (size_t i = 0; i < states.size(); ++i) {
+        const RoleAdjacency& adjacency = (*role_denotations)[i]->get_adjacency();
+        batch.set(i);
+        for (ObjectIndex second = 0; second < adjacency.get_num_objects(); ++second) {
+            if (!concept_batch->contains(i, second)) {
+                for (ObjectIndex first : adjacency.get_predecessors(second)) {
+                    batch.erase(i, first);
+                }
+            }
+        }
+    }
+    return batch;
+}
+
 AllConcept::AllConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_)
-    : Concept(index, vocabulary_info, role->is_static() && concept_->is_static()), m_role(role), m_concept(concept_) { }
+    : Concept(index, vocabulary_info, role->is_static() && concept_->is_static(), utils::collect_predicate_indices(role, concept_)), m_role(role), m_concept(concept_) { }
 
 bool AllConcept::are_equal_impl(const Concept& other) const {
     if (typeid(*this) == typeid(other)) {
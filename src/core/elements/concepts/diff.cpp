@@ -33,7 +33,7 @@ ConceptDenotations DiffConcept::evaluate_impl(const States& states, DenotationsC
 }
 
 DiffConcept::DiffConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_1, std::shared_ptr<const Concept> concept_2)
-    : Concept(index, vocabulary_info, concept_1->is_static() && concept_2->is_static()), m_concept_left(concept_1), m_concept_right(concept_2) { }
+    : Concept(index, vocabulary_info, concept_1->is_static() && concept_2->is_static(), utils::collect_predicate_indices(concept_1, concept_2)), m_concept_left(concept_1), m_concept_right(concept_2) { }
 
 bool DiffConcept::are_equal_impl(const Concept& other) const {
     if (typeid(*this) == typeid(other)) {
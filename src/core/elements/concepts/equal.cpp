@@ -5,12 +5,12 @@ namespace dlplan::core {
 void EqualConcept::compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, ConceptDenotation& result) const {
     // find counterexample [(a,b) in R and (a,b) not in S] or [(a,b) not in R and (a,b) in S]
     result.set();
-    for (const auto& pair : left_denot.to_vector()) {
-        if (!right_denot.contains(pair)) result.erase(pair.first);
-    }
-    for (const auto& pair : right_denot.to_vector()) {
-        if (!left_denot.contains(pair)) result.erase(pair.first);
-    }
+    left_denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        if (!right_denot.contains({first, second})) result.erase(first);
+    });
+    right_denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        if (!left_denot.contains({first, second})) result.erase(first);
+    });
 }
 
 ConceptDenotation EqualConcept::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -40,8 +40,9 @@ ConceptDenotations EqualConcept::evaluate_impl(const States& states, Denotations
 }
 
 EqualConcept::EqualConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role_left, std::shared_ptr<const Role> role_right)
-    : Concept(index, vocabulary_info, role_left->is_static() && role_right->is_static()),
-        m_role_left(role_left), m_role_right(role_right) { }
+    : Concept(index, vocabulary_info, role_left->is_static() && role_right->is_static(), utils::collect_predicate_indices(role_left, role_right)),
+        m_role_left(role_left->get_index() < role_right->get_index() ? role_left : role_right),
+        m_role_right(role_left->get_index() < role_right->get_index() ? role_right : role_left) { }
 
 bool EqualConcept::are_equal_impl(const Concept& other) const {
     if (typeid(*this) == typeid(other)) {
@@ -31,8 +31,14 @@ ConceptDenotations NotConcept::evaluate_impl(const States& states, DenotationsCa
     return denotations;
 }
 
+ConceptDenotationBatch NotConcept::evaluate_batch_impl(const States& states, DenotationsCaches& caches) const {
+    ConceptDenotationBatch batch(*m_concept->evaluate_batch(states, caches));
+    ~batch;
+    return batch;
+}
+
 NotConcept::NotConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_)
-    : Concept(index, vocabulary_info, concept_->is_static()), m_concept(concept_){ }
+    : Concept(index, vocabulary_info, concept_->is_static(), utils::collect_predicate_indices(concept_)), m_concept(concept_){ }
 
 bool NotConcept::are_equal_impl(const Concept& other) const {
     if (typeid(*this) == typeid(other)) {
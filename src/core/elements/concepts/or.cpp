@@ -33,8 +33,14 @@ ConceptDenotations OrConcept::evaluate_impl(const States& states, DenotationsCac
     return denotations;
 }
 
+ConceptDenotationBatch OrConcept::evaluate_batch_impl(const States& states, DenotationsCaches& caches) const {
+    ConceptDenotationBatch batch(*m_concept_left->evaluate_batch(states, caches));
+    batch |= *m_concept_right->evaluate_batch(states, caches);
+    return batch;
+}
+
 OrConcept::OrConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_1, std::shared_ptr<const Concept> concept_2)
-    : Concept(index, vocabulary_info, concept_1->is_static() && concept_2->is_static()),
+    : Concept(index, vocabulary_info, concept_1->is_static() && concept_2->is_static(), utils::collect_predicate_indices(concept_1, concept_2)),
     m_concept_left(concept_1->get_index() < concept_2->get_index() ? concept_1 : concept_2),
     m_concept_right(concept_1->get_index() < concept_2->get_index() ? concept_2 : concept_1) { }
 
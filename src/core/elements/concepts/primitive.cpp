@@ -7,18 +7,13 @@ namespace dlplan::core {
 void PrimitiveConcept::compute_result(const State& state, ConceptDenotation& result) const {
     const auto& instance_info = *state.get_instance_info();
     const auto& atoms = instance_info.get_atoms();
-    for (int atom_idx : state.get_atom_indices()) {
+    for (int atom_idx : state.get_atom_indices_by_predicate(m_predicate.get_index())) {
         const auto& atom = atoms[atom_idx];
-        if (atom.get_predicate_index() == m_predicate.get_index()) {
-            assert(dlplan::utils::in_bounds(m_pos, atom.get_object_indices()));
-            result.insert(atom.get_object_indices()[m_pos]);
-        }
+        assert(dlplan::utils::in_bounds(m_pos, atom.get_object_indices()));
+        result.insert(atom.get_object_indices()[m_pos]);
     }
-    for (const auto &atom : state.get_instance_info()->get_static_atoms()) {
-        if (atom.get_predicate_index() == m_predicate.get_index()) {
-            assert(dlplan::utils::in_bounds(m_pos, atom.get_object_indices()));
-            result.insert(atom.get_object_indices()[m_pos]);
-        }
+    if (!instance_info.get_static_atom_indices_by_predicate(m_predicate.get_index()).empty()) {
+        result |= instance_info.get_static_concept_denotation(m_predicate.get_index(), m_pos);
     }
 }
 
@@ -43,8 +38,33 @@ ConceptDenotations PrimitiveConcept::evaluate_impl(const States& states, Denotat
     return denotations;
 }
 
+ConceptDenotation PrimitiveConcept::evaluate_incrementally_impl(const StateTransition& transition, DenotationsCaches& caches) const {
+    const auto& instance_info = *transition.get_state().get_instance_info();
+    // Patching the denotation in the parent state is only sound
+    // if each object stems from a single non-static atom.
+    if (m_predicate.get_arity() != 1
+        || !instance_info.get_static_atom_indices_by_predicate(m_predicate.get_index()).empty()) {
+        return evaluate_impl(transition.get_state(), caches);
+    }
+    ConceptDenotation denotation(*Concept::evaluate(transition.get_parent_state(), caches));
+    const auto& atoms = instance_info.get_atoms();
+    for (int atom_idx : transition.get_delete_atom_indices()) {
+        const auto& atom = atoms[atom_idx];
+        if (atom.get_predicate_index() == m_predicate.get_index()) {
+            denotation.erase(atom.get_object_indices()[m_pos]);
+        }
+    }
+    for (int atom_idx : transition.get_add_atom_indices()) {
+        const auto& atom = atoms[atom_idx];
+        if (atom.get_predicate_index() == m_predicate.get_index()) {
+            denotation.insert(atom.get_object_indices()[m_pos]);
+        }
+    }
+    return denotation;
+}
+
 PrimitiveConcept::PrimitiveConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, const Predicate& predicate, int pos)
-    : Concept(index, vocabulary_info, predicate.is_static()), m_predicate(predicate), m_pos(pos) {
+    : Concept(index, vocabulary_info, predicate.is_static(), {predicate.get_index()}), m_predicate(predicate), m_pos(pos) {
     if (m_pos >= m_predicate.get_arity()) {
         throw std::runtime_error("PrimitiveConcept::PrimitiveConcept - object index does not match predicate arity ("s + std::to_string(m_pos) + " > " + std::to_string(predicate.get_arity()) + ").");
     }
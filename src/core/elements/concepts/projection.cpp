@@ -3,10 +3,10 @@
 
 namespace dlplan::core {
 void ProjectionConcept::compute_result(const RoleDenotation& denot, ConceptDenotation& result) const {
-    for (const auto& pair : denot.to_vector()) {
-        if (m_pos == 0) result.insert(pair.first);
-        else if (m_pos == 1) result.insert(pair.second);
-    }
+    denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        if (m_pos == 0) result.insert(first);
+        else if (m_pos == 1) result.insert(second);
+    });
 }
 
 ConceptDenotation ProjectionConcept::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -32,7 +32,7 @@ ConceptDenotations ProjectionConcept::evaluate_impl(const States& states, Denota
 }
 
 ProjectionConcept::ProjectionConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, const std::shared_ptr<const Role>& role, int pos)
-: Concept(index, vocabulary_info, role->is_static()), m_role(role), m_pos(pos) {
+: Concept(index, vocabulary_info, role->is_static(), utils::collect_predicate_indices(role)), m_role(role), m_pos(pos) {
     if (pos < 0 || pos > 1) {
         throw std::runtime_error("ProjectionConcept::ProjectionConcept - projection index out of range, should be 0 or 1 ("s + std::to_string(pos) + ")");
     }
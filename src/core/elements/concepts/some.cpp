@@ -4,17 +4,25 @@
 namespace dlplan::core {
 void SomeConcept::compute_result(const RoleDenotation& role_denot, const ConceptDenotation& concept_denot, ConceptDenotation& result) const {
     // find examples a : exists b . (a,b) in R and b in C
-    for (const auto& pair : role_denot.to_vector()) {
-        if (concept_denot.contains(pair.second)) {
-            result.insert(pair.first);
+    role_denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        if (concept_denot.contains(second)) {
+            result.insert(first);
         }
-    }
+    });
+}
+
+void SomeConcept::compute_result(const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_denot, ConceptDenotation& result) const {
+    concept_denot.for_each([&](ObjectIndex second) {
+        for (ObjectIndex first : role_adjacency.get_predecessors(second)) {
+            result.insert(first);
+        }
+    });
 }
 
 ConceptDenotation SomeConcept::evaluate_impl(const State& state, DenotationsCaches& caches) const {
     ConceptDenotation denotation(state.get_instance_info()->get_objects().size());
     compute_result(
-        *m_role->evaluate(state, caches),
+        m_role->evaluate(state, caches)->get_adjacency(),
         *m_concept->evaluate(state, caches),
         denotation);
     return denotation;
@@ -28,7 +36,7 @@ ConceptDenotations SomeConcept::evaluate_impl(const States& states, DenotationsC
     for (size_t i = 0; i < states.size(); ++i) {
         ConceptDenotation denotation(states[i].get_instance_info()->get_objects().size());
         compute_result(
-            *(*role_denotations)[i],
+            (*role_denotations)[i]->get_adjacency(),
             *(*concept_denotations)[i],
             denotation);
         denotations.push_back(caches.data.insert_unique(std::move(denotation)));
@@ -36,8 +44,23 @@ ConceptDenotations SomeConcept::evaluate_impl(const States& states, DenotationsC
     return denotations;
 }
 
+ConceptDenotationBatch SomeConcept::evaluate_batch_impl(const States& states, DenotationsCaches& caches) const {
+    ConceptDenotationBatch batch(states);
+    auto role_denotations = m_role->evaluate(states, caches);
+    auto concept_batch = m_concept->evaluate_batch(states, caches);
+    for (size_t i = 0; i < states.size(); ++i) {
+        const RoleAdjacency& adjacency = (*role_denotations)[i]->get_adjacency();
+        concept_batch->for_each(i, [&](ObjectIndex second) {
+            for (ObjectIndex first : adjacency.get_predecessors(second)) {
+                batch.insert(i, first);
+            }
+        });
+    }
+    return batch;
+}
+
 SomeConcept::SomeConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_)
-    : Concept(index, vocabulary_info, role->is_static() && concept_->is_static()), m_role(role), m_concept(concept_) { }
+    : Concept(index, vocabulary_info, role->is_static() && concept_->is_static(), utils::collect_predicate_indices(role, concept_)), m_role(role), m_concept(concept_) { }
 
 bool SomeConcept::are_equal_impl(const Concept& other) const {
     if (typeid(*this) == typeid(other)) {
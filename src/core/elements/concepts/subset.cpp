@@ -5,9 +5,9 @@ namespace dlplan::core {
 void SubsetConcept::compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, ConceptDenotation& result) const {
     // find counterexamples a : exists b . (a,b) in R and (a,b) notin S
     result.set();
-    for (const auto& pair : left_denot.to_vector()) {
-        if (!right_denot.contains(pair)) result.erase(pair.first);
-    }
+    left_denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        if (!right_denot.contains({first, second})) result.erase(first);
+    });
 }
 
 ConceptDenotation SubsetConcept::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -37,7 +37,7 @@ ConceptDenotations SubsetConcept::evaluate_impl(const States& states, Denotation
 }
 
 SubsetConcept::SubsetConcept(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role_left, std::shared_ptr<const Role> role_right)
-    : Concept(index, vocabulary_info, role_left->is_static() && role_right->is_static()), m_role_left(role_left), m_role_right(role_right) { }
+    : Concept(index, vocabulary_info, role_left->is_static() && role_right->is_static(), utils::collect_predicate_indices(role_left, role_right)), m_role_left(role_left), m_role_right(role_right) { }
 
 bool SubsetConcept::are_equal_impl(const Concept& other) const {
     if (typeid(*this) == typeid(other)) {
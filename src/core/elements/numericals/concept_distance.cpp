@@ -3,7 +3,15 @@
 
 namespace dlplan::core {
 void ConceptDistanceNumerical::compute_result(const ConceptDenotation& concept_from_denot, const RoleDenotation& role_denot, const ConceptDenotation& concept_to_denot, int& result) const {
-    result = utils::compute_multi_source_multi_target_shortest_distance(concept_from_denot, role_denot, concept_to_denot);
+    compute_result(concept_from_denot, RoleAdjacency(role_denot), concept_to_denot, result);
+}
+
+void ConceptDistanceNumerical::compute_result(const ConceptDenotation& concept_from_denot, const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_to_denot, int& result) const {
+    result = utils::compute_multi_source_multi_target_shortest_distance(concept_from_denot, role_adjacency, concept_to_denot);
+}
+
+void ConceptDistanceNumerical::compute_result(const ConceptDenotation& concept_from_denot, const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_to_denot, utils::Distances& distances, ObjectIndices& queue, int& result) const {
+    result = utils::compute_multi_source_multi_target_shortest_distance(concept_from_denot, role_adjacency, concept_to_denot, distances, queue);
 }
 
 int ConceptDistanceNumerical::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -22,7 +30,7 @@ int ConceptDistanceNumerical::evaluate_impl(const State& state, DenotationsCache
     int denotation;
     compute_result(
         *concept_from_denot,
-        *role_denot,
+        role_denot->get_adjacency(),
         *concept_to_denot, denotation);
     return denotation;
 }
@@ -49,7 +57,7 @@ NumericalDenotations ConceptDistanceNumerical::evaluate_impl(const States& state
         int denotation;
         compute_result(
             *(*concept_from_denots)[i],
-            *(*role_denots)[i],
+            (*role_denots)[i]->get_adjacency(),
             *(*concept_to_denots)[i],
             denotation);
         denotations.push_back(denotation);
@@ -58,7 +66,7 @@ NumericalDenotations ConceptDistanceNumerical::evaluate_impl(const States& state
 }
 
 ConceptDistanceNumerical::ConceptDistanceNumerical(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_from, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_to)
-    : Numerical(index, vocabulary_info, concept_from->is_static() && role->is_static() && concept_to->is_static()),
+    : Numerical(index, vocabulary_info, concept_from->is_static() && role->is_static() && concept_to->is_static(), utils::collect_predicate_indices(concept_from, role, concept_to)),
         m_concept_from(concept_from), m_role(role), m_concept_to(concept_to) { }
 
 bool ConceptDistanceNumerical::are_equal_impl(const Numerical& other) const {
@@ -2,18 +2,17 @@
 
 
 namespace dlplan::core {
-void RoleDistanceNumerical::compute_result(const RoleDenotation& role_from_denot, const RoleDenotation& role_denot, const RoleDenotation& role_to_denot, int& result) const {
-    utils::PairwiseDistances pairwise_distances = utils::compute_floyd_warshall(role_denot);
+void RoleDistanceNumerical::compute_result(const RoleDenotation& role_from_denot, const PairwiseDistances& pairwise_distances, const RoleDenotation& role_to_denot, int& result) const {
+    compute_result(RoleAdjacency(role_from_denot), pairwise_distances, RoleAdjacency(role_to_denot), result);
+}
+
+void RoleDistanceNumerical::compute_result(const RoleAdjacency& from_adjacency, const PairwiseDistances& pairwise_distances, const RoleAdjacency& to_adjacency, int& result) const {
     result = INF;
-    int num_objects = role_denot.get_num_objects();
+    int num_objects = pairwise_distances.get_num_objects();
     for (int k = 0; k < num_objects; ++k) {  // property
-        for (int i = 0; i < num_objects; ++i) {  // source
-            if (role_from_denot.contains(std::make_pair(k, i))) {
-                for (int j = 0; j < num_objects; ++j) {  // target
-                    if (role_to_denot.contains(std::make_pair(k, j))) {
-                        result = std::min<int>(result, pairwise_distances[i][j]);
-                    }
-                }
+        for (int i : from_adjacency.get_successors(k)) {  // source
+            for (int j : to_adjacency.get_successors(k)) {  // target
+                result = std::min<int>(result, pairwise_distances.get_distance(i, j));
             }
         }
     }
@@ -30,7 +29,7 @@ int RoleDistanceNumerical::evaluate_impl(const State& state, DenotationsCaches&
     }
     auto role_denot = m_role->evaluate(state, caches);
     int denotation;
-    compute_result(*role_from_denot, *role_denot, *role_to_denot, denotation);
+    compute_result(role_from_denot->get_adjacency(), *utils::get_pairwise_distances(role_denot, caches), role_to_denot->get_adjacency(), denotation);
     return denotation;
 }
 
@@ -51,9 +50,9 @@ NumericalDenotations RoleDistanceNumerical::evaluate_impl(const States& states,
         }
         int denotation;
         compute_result(
-            *(*role_from_denots)[i],
-            *(*role_denots)[i],
-            *(*role_to_denots)[i],
+            (*role_from_denots)[i]->get_adjacency(),
+            *utils::get_pairwise_distances((*role_denots)[i], caches),
+            (*role_to_denots)[i]->get_adjacency(),
             denotation);
         denotations.push_back(denotation);
     }
@@ -61,7 +60,7 @@ NumericalDenotations RoleDistanceNumerical::evaluate_impl(const States& states,
 }
 
 RoleDistanceNumerical::RoleDistanceNumerical(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role_from, std::shared_ptr<const Role> role, std::shared_ptr<const Role> role_to)
-    : Numerical(index, vocabulary_info, role_from->is_static() && role->is_static() && role_to->is_static()),
+    : Numerical(index, vocabulary_info, role_from->is_static() && role->is_static() && role_to->is_static(), utils::collect_predicate_indices(role_from, role, role_to)),
         m_role_from(role_from), m_role(role), m_role_to(role_to) { }
 
 bool RoleDistanceNumerical::are_equal_impl(const Numerical& other) const {
@@ -90,7 +89,7 @@ int RoleDistanceNumerical::evaluate(const State& state) const {
     }
     auto role_denot = m_role->evaluate(state);
     int denotation;
-    compute_result(role_from_denot, role_denot, role_to_denot, denotation);
+    compute_result(role_from_denot, PairwiseDistances(role_denot), role_to_denot, denotation);
     return denotation;
 }
 
@@ -3,11 +3,21 @@
 
 namespace dlplan::core {
 void SumConceptDistanceNumerical::compute_result(const ConceptDenotation& concept_from_denot, const RoleDenotation& role_denot, const ConceptDenotation& concept_to_denot, int& result) const {
+    compute_result(concept_from_denot, RoleAdjacency(role_denot), concept_to_denot, result);
+}
+
+void SumConceptDistanceNumerical::compute_result(const ConceptDenotation& concept_from_denot, const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_to_denot, int& result) const {
+    utils::Distances distances;
+    ObjectIndices queue;
+    compute_result(concept_from_denot, role_adjacency, concept_to_denot, distances, queue, result);
+}
+
+void SumConceptDistanceNumerical::compute_result(const ConceptDenotation& concept_from_denot, const RoleAdjacency& role_adjacency, const ConceptDenotation& concept_to_denot, utils::Distances& distances, ObjectIndices& queue, int& result) const {
     result = 0;
-    utils::Distances source_distances = utils::compute_multi_source_multi_target_shortest_distances(concept_from_denot, role_denot, concept_to_denot);
-    for (const auto target : concept_to_denot.to_vector()) {
-        result = utils::path_addition(result, source_distances[target]);
-    }
+    utils::compute_multi_source_multi_target_shortest_distances(concept_from_denot, role_adjacency, concept_to_denot, distances, queue);
+    concept_to_denot.for_each([&](ObjectIndex target) {
+        result = utils::path_addition(result, distances[target]);
+    });
 }
 
 int SumConceptDistanceNumerical::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -26,7 +36,7 @@ int SumConceptDistanceNumerical::evaluate_impl(const State& state, DenotationsCa
     int denotation;
     compute_result(
         *concept_from_denot,
-        *role_denot,
+        role_denot->get_adjacency(),
         *concept_to_denot, denotation);
     return denotation;
 }
@@ -49,7 +59,7 @@ NumericalDenotations SumConceptDistanceNumerical::evaluate_impl(const States& st
         int denotation;
         compute_result(
             *(*concept_from_denots)[i],
-            *(*role_denots)[i],
+            (*role_denots)[i]->get_adjacency(),
             *(*concept_to_denots)[i],
             denotation);
         denotations.push_back(denotation);
@@ -58,7 +68,7 @@ NumericalDenotations SumConceptDistanceNumerical::evaluate_impl(const States& st
 }
 
 SumConceptDistanceNumerical::SumConceptDistanceNumerical(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_from, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_to)
-    : Numerical(index, vocabulary_info, concept_from->is_static() && role->is_static() && concept_to->is_static()),
+    : Numerical(index, vocabulary_info, concept_from->is_static() && role->is_static() && concept_to->is_static(), utils::collect_predicate_indices(concept_from, role, concept_to)),
         m_concept_from(concept_from), m_role(role), m_concept_to(concept_to) { }
 
 bool SumConceptDistanceNumerical::are_equal_impl(const Numerical& other) const {
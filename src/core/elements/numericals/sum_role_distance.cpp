@@ -2,21 +2,20 @@
 
 
 namespace dlplan::core {
-void SumRoleDistanceNumerical::compute_result(const RoleDenotation& role_from_denot, const RoleDenotation& role_denot, const RoleDenotation& role_to_denot, int& result) const {
-    utils::PairwiseDistances pairwise_distances = utils::compute_floyd_warshall(role_denot);
+void SumRoleDistanceNumerical::compute_result(const RoleDenotation& role_from_denot, const PairwiseDistances& pairwise_distances, const RoleDenotation& role_to_denot, int& result) const {
+    compute_result(RoleAdjacency(role_from_denot), pairwise_distances, RoleAdjacency(role_to_denot), result);
+}
+
+void SumRoleDistanceNumerical::compute_result(const RoleAdjacency& from_adjacency, const PairwiseDistances& pairwise_distances, const RoleAdjacency& to_adjacency, int& result) const {
     result = 0;
-    int num_objects = role_denot.get_num_objects();
+    int num_objects = pairwise_distances.get_num_objects();
     for (int k = 0; k < num_objects; ++k) {  // property
-        for (int i = 0; i < num_objects; ++i) {  // source
-            if (role_from_denot.contains(std::make_pair(k, i))) {
-                int min_distance = INF;
-                for (int j = 0; j < num_objects; ++j) {  // target
-                    if (role_to_denot.contains(std::make_pair(k, j))) {
-                        min_distance = std::min<int>(min_distance, pairwise_distances[i][j]);
-                    }
-                }
-                result = utils::path_addition(result, min_distance);
+        for (int i : from_adjacency.get_successors(k)) {  // source
+            int min_distance = INF;
+            for (int j : to_adjacency.get_successors(k)) {  // target
+                min_distance = std::min<int>(min_distance, pairwise_distances.get_distance(i, j));
             }
+            result = utils::path_addition(result, min_distance);
         }
     }
 }
@@ -32,7 +31,7 @@ int SumRoleDistanceNumerical::evaluate_impl(const State& state, DenotationsCache
     }
     auto role_denot = m_role->evaluate(state, caches);
     int denotation;
-    compute_result(*role_from_denot, *role_denot, *role_to_denot, denotation);
+    compute_result(role_from_denot->get_adjacency(), *utils::get_pairwise_distances(role_denot, caches), role_to_denot->get_adjacency(), denotation);
     return denotation;
 }
 
@@ -53,9 +52,9 @@ NumericalDenotations SumRoleDistanceNumerical::evaluate_impl(const States& state
         }
         int denotation;
         compute_result(
-            *(*role_from_denots)[i],
-            *(*role_denots)[i],
-            *(*role_to_denots)[i],
+            (*role_from_denots)[i]->get_adjacency(),
+            *utils::get_pairwise_distances((*role_denots)[i], caches),
+            (*role_to_denots)[i]->get_adjacency(),
             denotation);
         denotations.push_back(denotation);
     }
@@ -63,7 +62,7 @@ NumericalDenotations SumRoleDistanceNumerical::evaluate_impl(const States& state
 }
 
 SumRoleDistanceNumerical::SumRoleDistanceNumerical(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role_from, std::shared_ptr<const Role> role, std::shared_ptr<const Role> role_to)
-    : Numerical(index, vocabulary_info, role_from->is_static() && role->is_static() && role_to->is_static()),
+    : Numerical(index, vocabulary_info, role_from->is_static() && role->is_static() && role_to->is_static(), utils::collect_predicate_indices(role_from, role, role_to)),
         m_role_from(role_from), m_role(role), m_role_to(role_to) { }
 
 bool SumRoleDistanceNumerical::are_equal_impl(const Numerical& other) const {
@@ -92,7 +91,7 @@ int SumRoleDistanceNumerical::evaluate(const State& state) const {
     }
     auto role_denot = m_role->evaluate(state);
     int denotation;
-    compute_result(role_from_denot, role_denot, role_to_denot, denotation);
+    compute_result(role_from_denot, PairwiseDistances(role_denot), role_to_denot, denotation);
     return denotation;
 }
 
@@ -34,7 +34,7 @@ RoleDenotations AndRole::evaluate_impl(const States& states, DenotationsCaches&
 }
 
 AndRole::AndRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role_1, std::shared_ptr<const Role> role_2)
-    : Role(index, vocabulary_info, role_1->is_static() && role_2->is_static()),
+    : Role(index, vocabulary_info, role_1->is_static() && role_2->is_static(), utils::collect_predicate_indices(role_1, role_2)),
     m_role_left(role_1->get_index() < role_2->get_index() ? role_1 : role_2),
     m_role_right(role_1->get_index() < role_2->get_index() ? role_2 : role_1) { }
 
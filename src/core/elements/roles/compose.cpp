@@ -3,16 +3,11 @@
 
 namespace dlplan::core {
 void ComposeRole::compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, RoleDenotation& result) const {
-    // Compute sparse representation.
-    PairsOfObjectIndices left_pairs = left_denot.to_vector();
-    PairsOfObjectIndices right_pairs = right_denot.to_vector();
-    for (const auto& left_pair : left_pairs) {  // source
-        for (const auto& right_pair : right_pairs) {  // target
-            if (left_pair.second == right_pair.first) {
-                result.insert(std::make_pair(left_pair.first, right_pair.second));
-            }
-        }
-    }
+    utils::compute_composition(left_denot, right_denot, result);
+}
+
+void ComposeRole::compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, RoleDenotation& result, BitMatrix& right_matrix, BitMatrix& product) const {
+    utils::compute_composition(left_denot, right_denot, result, right_matrix, product);
 }
 
 RoleDenotation ComposeRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -41,7 +36,7 @@ RoleDenotations ComposeRole::evaluate_impl(const States& states, DenotationsCach
 }
 
 ComposeRole::ComposeRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role_left, std::shared_ptr<const Role> role_right)
-    : Role(index, vocabulary_info, role_left->is_static() && role_right->is_static()), m_role_left(role_left), m_role_right(role_right)  { }
+    : Role(index, vocabulary_info, role_left->is_static() && role_right->is_static(), utils::collect_predicate_indices(role_left, role_right)), m_role_left(role_left), m_role_right(role_right)  { }
 
 bool ComposeRole::are_equal_impl(const Role& other) const {
     if (typeid(*this) == typeid(other)) {
@@ -3,9 +3,9 @@
 
 namespace dlplan::core {
 void IdentityRole::compute_result(const ConceptDenotation& denot, RoleDenotation& result) const {
-    for (const auto& single : denot.to_vector()) {
+    denot.for_each([&](ObjectIndex single) {
         result.insert(std::make_pair(single, single));
-    }
+    });
 }
 
 RoleDenotation IdentityRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -31,7 +31,7 @@ RoleDenotations IdentityRole::evaluate_impl(const States& states, DenotationsCac
 }
 
 IdentityRole::IdentityRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Concept> concept_)
-    : Role(index, vocabulary_info, concept_->is_static()), m_concept(concept_) { }
+    : Role(index, vocabulary_info, concept_->is_static(), utils::collect_predicate_indices(concept_)), m_concept(concept_) { }
 
 bool IdentityRole::are_equal_impl(const Role& other) const {
     if (typeid(*this) == typeid(other)) {
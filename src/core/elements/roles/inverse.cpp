@@ -3,9 +3,9 @@
 
 namespace dlplan::core {
 void InverseRole::compute_result(const RoleDenotation& denot, RoleDenotation& result) const {
-    for (const auto& pair : denot.to_vector()) {
-        result.insert(std::make_pair(pair.second, pair.first));
-    }
+    denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        result.insert(std::make_pair(second, first));
+    });
 }
 
 RoleDenotation InverseRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -31,7 +31,7 @@ RoleDenotations InverseRole::evaluate_impl(const States& states, DenotationsCach
 }
 
 InverseRole::InverseRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role)
-    : Role(index, vocabulary_info, role->is_static()), m_role(role) { }
+    : Role(index, vocabulary_info, role->is_static(), utils::collect_predicate_indices(role)), m_role(role) { }
 
 bool InverseRole::are_equal_impl(const Role& other) const {
     if (typeid(*this) == typeid(other)) {
@@ -30,7 +30,7 @@ RoleDenotations NotRole::evaluate_impl(const States& states, DenotationsCaches&
 }
 
 NotRole::NotRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role)
-    : Role(index, vocabulary_info, role->is_static()), m_role(role) { }
+    : Role(index, vocabulary_info, role->is_static(), utils::collect_predicate_indices(role)), m_role(role) { }
 
 bool NotRole::are_equal_impl(const Role& other) const {
     if (typeid(*this) == typeid(other)) {
@@ -10,20 +10,14 @@ namespace dlplan::core {
 void PrimitiveRole::compute_result(const State& state, RoleDenotation& result) const {
     const auto& instance_info = *state.get_instance_info();
     const auto& atoms = instance_info.get_atoms();
-    for (int atom_idx : state.get_atom_indices()) {
+    for (int atom_idx : state.get_atom_indices_by_predicate(m_predicate.get_index())) {
         const auto& atom = atoms[atom_idx];
-        if (atom.get_predicate_index() == m_predicate.get_index()) {
-            assert(dlplan::utils::in_bounds(m_pos_1, atom.get_object_indices()));
-            assert(dlplan::utils::in_bounds(m_pos_2, atom.get_object_indices()));
-            result.insert(std::make_pair(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]));
-        }
+        assert(dlplan::utils::in_bounds(m_pos_1, atom.get_object_indices()));
+        assert(dlplan::utils::in_bounds(m_pos_2, atom.get_object_indices()));
+        result.insert(std::make_pair(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]));
     }
-    for (const auto& atom : state.get_instance_info()->get_static_atoms()) {
-        if (atom.get_predicate_index() == m_predicate.get_index()) {
-            assert(dlplan::utils::in_bounds(m_pos_1, atom.get_object_indices()));
-            assert(dlplan::utils::in_bounds(m_pos_2, atom.get_object_indices()));
-            result.insert(std::make_pair(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]));
-        }
+    if (!instance_info.get_static_atom_indices_by_predicate(m_predicate.get_index()).empty()) {
+        result |= instance_info.get_static_role_denotation(m_predicate.get_index(), m_pos_1, m_pos_2);
     }
 }
 
@@ -49,8 +43,33 @@ RoleDenotations PrimitiveRole::evaluate_impl(const States& states, DenotationsCa
 }
 
 
+RoleDenotation PrimitiveRole::evaluate_incrementally_impl(const StateTransition& transition, DenotationsCaches& caches) const {
+    const auto& instance_info = *transition.get_state().get_instance_info();
+    // Patching the denotation in the parent state is only sound
+    // if each pair stems from a single non-static atom.
+    if (m_predicate.get_arity() != 2 || m_pos_1 == m_pos_2
+        || !instance_info.get_static_atom_indices_by_predicate(m_predicate.get_index()).empty()) {
+        return evaluate_impl(transition.get_state(), caches);
+    }
+    RoleDenotation denotation(*Role::evaluate(transition.get_parent_state(), caches));
+    const auto& atoms = instance_info.get_atoms();
+    for (int atom_idx : transition.get_delete_atom_indices()) {
+        const auto& atom = atoms[atom_idx];
+        if (atom.get_predicate_index() == m_predicate.get_index()) {
+            denotation.erase(std::make_pair(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]));
+        }
+    }
+    for (int atom_idx : transition.get_add_atom_indices()) {
+        const auto& atom = atoms[atom_idx];
+        if (atom.get_predicate_index() == m_predicate.get_index()) {
+            denotation.insert(std::make_pair(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]));
+        }
+    }
+    return denotation;
+}
+
 PrimitiveRole::PrimitiveRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, const Predicate& predicate, int pos_1, int pos_2)
-: Role(index, vocabulary_info, predicate.is_static()), m_predicate(predicate), m_pos_1(pos_1), m_pos_2(pos_2) {
+: Role(index, vocabulary_info, predicate.is_static(), {predicate.get_index()}), m_predicate(predicate), m_pos_1(pos_1), m_pos_2(pos_2) {
     if (m_pos_1 >= m_predicate.get_arity() || m_pos_2 >= m_predicate.get_arity()) {
         throw std::runtime_error("PrimitiveRole::evaluate_impl - object index does not match predicate arity ("s + std::to_string(m_pos_1) + " or " + std::to_string(m_pos_2)  + " > " + std::to_string(predicate.get_arity()) + ").");
     }
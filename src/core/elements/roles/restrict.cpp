@@ -3,12 +3,13 @@
 
 namespace dlplan::core {
 void RestrictRole::compute_result(const RoleDenotation& role_denot, const ConceptDenotation& concept_denot, RoleDenotation& result) const {
-    result = role_denot;
-    for (const auto& pair : role_denot.to_vector()) {
-        if (!concept_denot.contains(pair.second)) {
-            result.erase(pair);
+    // Pairs are inserted in ascending order, which is cheap in both representations.
+    result.clear();
+    role_denot.for_each([&](ObjectIndex first, ObjectIndex second) {
+        if (concept_denot.contains(second)) {
+            result.insert(std::make_pair(first, second));
         }
-    }
+    });
 }
 
 RoleDenotation RestrictRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -37,7 +38,7 @@ RoleDenotations RestrictRole::evaluate_impl(const States& states, DenotationsCac
 }
 
 RestrictRole::RestrictRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_)
-: Role(index, vocabulary_info, role->is_static() && concept_->is_static()), m_role(role), m_concept(concept_) { }
+: Role(index, vocabulary_info, role->is_static() && concept_->is_static(), utils::collect_predicate_indices(role, concept_)), m_role(role), m_concept(concept_) { }
 
 bool RestrictRole::are_equal_impl(const Role& other) const {
     if (typeid(*this) == typeid(other)) {
@@ -5,29 +5,38 @@ namespace dlplan::core
 
     void TilCRole::compute_result(const RoleDenotation &role_denot, const ConceptDenotation &concept_denot, RoleDenotation &result) const
     {
-        auto concept_object_indicies = concept_denot.to_vector();
-
-        std::unordered_set<ObjectIndex> current(concept_object_indicies.begin(), concept_object_indicies.end()), next;
-        std::unordered_set<ObjectIndex> visited(concept_object_indicies.begin(), concept_object_indicies.end());
-
-        std::unordered_map<ObjectIndex, std::unordered_set<ObjectIndex>> inv_edges;
-
-        for(auto& pair : role_denot.to_vector()) {
-            auto& [from, to] = pair;
-            inv_edges[to].insert(from);
-        }
+        compute_result(RoleAdjacency(role_denot), concept_denot, result);
+    }
 
+    void TilCRole::compute_result(const RoleAdjacency &adjacency, const ConceptDenotation &concept_denot, RoleDenotation &result) const
+    {
+        std::vector<ObjectIndex> current, next;
+        std::vector<bool> visited(adjacency.get_num_objects(), false);
+        concept_denot.for_each([&](ObjectIndex object) {
+            current.push_back(object);
+            visited[object] = true;
+        });
+
+        // Objects discovered in a round are only marked visited after the round
+        // such that all their edges into the current layer are added.
+        std::vector<bool> discovered(adjacency.get_num_objects(), false);
         while(current.size() > 0) {
-            for(auto& to : current) {
-                for(auto& from : inv_edges[to]) {
-                    if(! visited.contains(from)) {
+            for(auto to : current) {
+                for(auto from : adjacency.get_predecessors(to)) {
+                    if(! visited[from]) {
                         result.insert(std::make_pair(from, to));
-                        next.insert(from);
+                        if (!discovered[from]) {
+                            discovered[from] = true;
+                            next.push_back(from);
+                        }
                     }
                 }
             }
-            visited.insert(next.begin(), next.end());
-            current = next;
+            for (auto object : next) {
+                visited[object] = true;
+                discovered[object] = false;
+            }
+            current.swap(next);
             next.clear();
         }
     }
@@ -36,7 +45,7 @@ namespace dlplan::core
     {
         RoleDenotation denotation(state.get_instance_info()->get_objects().size());
         compute_result(
-            *m_role->evaluate(state, caches),
+            m_role->evaluate(state, caches)->get_adjacency(),
             *m_concept->evaluate(state, caches),
             denotation);
         return denotation;
@@ -52,7 +61,7 @@ namespace dlplan::core
         {
             RoleDenotation denotation(states[i].get_instance_info()->get_objects().size());
             compute_result(
-                *(*role_denotations)[i],
+                (*role_denotations)[i]->get_adjacency(),
                 *(*concept_denotations)[i],
                 denotation);
             denotations.push_back(caches.data.insert_unique(std::move(denotation)));
@@ -61,7 +70,7 @@ namespace dlplan::core
     }
 
     TilCRole::TilCRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role, std::shared_ptr<const Concept> concept_)
-        : Role(index, vocabulary_info, role->is_static() && concept_->is_static()),
+        : Role(index, vocabulary_info, role->is_static() && concept_->is_static(), utils::collect_predicate_indices(role, concept_)),
           m_role(role), m_concept(concept_) {}
 
     bool TilCRole::are_equal_impl(const Role &other) const
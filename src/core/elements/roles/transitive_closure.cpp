@@ -4,20 +4,11 @@
 namespace dlplan::core {
 // https://stackoverflow.com/questions/3517524/what-is-the-best-known-transitive-closure-algorithm-for-a-directed-graph
 void TransitiveClosureRole::compute_result(const RoleDenotation& denot, RoleDenotation& result) const {
-    result = denot;
-    bool changed = false;
-    do {
-        RoleDenotation tmp_result = result;
-        PairsOfObjectIndices pairs = tmp_result.to_vector();
-        for (const auto& pair_1 : pairs) {
-            for (const auto& pair_2 : pairs) {
-                if (pair_1.second == pair_2.first) {
-                    result.insert(std::make_pair(pair_1.first, pair_2.second));
-                }
-            }
-        }
-        changed = (result.size() != tmp_result.size());
-    } while (changed);
+    utils::compute_transitive_closure(denot, result);
+}
+
+void TransitiveClosureRole::compute_result(const RoleDenotation& denot, RoleDenotation& result, BitMatrix& matrix) const {
+    utils::compute_transitive_closure(denot, result, matrix);
 }
 
 RoleDenotation TransitiveClosureRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -43,7 +34,7 @@ RoleDenotations TransitiveClosureRole::evaluate_impl(const States& states, Denot
 }
 
 TransitiveClosureRole::TransitiveClosureRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role)
-    : Role(index, vocabulary_info, role->is_static()), m_role(role) { }
+    : Role(index, vocabulary_info, role->is_static(), utils::collect_predicate_indices(role)), m_role(role) { }
 
 bool TransitiveClosureRole::are_equal_impl(const Role& other) const {
     if (typeid(*this) == typeid(other)) {
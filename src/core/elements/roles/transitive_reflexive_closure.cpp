@@ -3,20 +3,12 @@
 
 namespace dlplan::core {
 void TransitiveReflexiveClosureRole::compute_result(const RoleDenotation& denot, int num_objects, RoleDenotation& result) const {
-    result = denot;
-    bool changed = false;
-    do {
-        RoleDenotation tmp_result = result;
-        PairsOfObjectIndices pairs = tmp_result.to_vector();
-        for (const auto& pair_1 : pairs) {
-            for (const auto& pair_2 : pairs) {
-                if (pair_1.second == pair_2.first) {
-                    result.insert(std::make_pair(pair_1.first, pair_2.second));
-                }
-            }
-        }
-        changed = (result.size() != tmp_result.size());
-    } while (changed);
+    BitMatrix matrix;
+    compute_result(denot, num_objects, result, matrix);
+}
+
+void TransitiveReflexiveClosureRole::compute_result(const RoleDenotation& denot, int num_objects, RoleDenotation& result, BitMatrix& matrix) const {
+    utils::compute_transitive_closure(denot, result, matrix);
     // add reflexive part
     for (int i = 0; i < num_objects; ++i) {
         result.insert(std::make_pair(i, i));
@@ -48,7 +40,7 @@ RoleDenotations TransitiveReflexiveClosureRole::evaluate_impl(const States& stat
 }
 
 TransitiveReflexiveClosureRole::TransitiveReflexiveClosureRole(ElementIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info, std::shared_ptr<const Role> role)
-    : Role(index, vocabulary_info, role->is_static()), m_role(role) { }
+    : Role(index, vocabulary_info, role->is_static(), utils::collect_predicate_indices(role)), m_role(role) { }
 
 bool TransitiveReflexiveClosureRole::are_equal_impl(const Role& other) const {
     if (typeid(*this) == typeid(other)) {
@@ -1,12 +1,159 @@
 #include "../../../include/dlplan/core/elements/utils.h"
 
-#include <deque>
+#include "../evaluation_workspace.h"
+
 #include <iostream>
 
 
-namespace dlplan::core::utils {
+namespace dlplan::core {
+
+static void or_blocks(std::uint64_t* dst, const std::uint64_t* src, std::size_t num_blocks) {
+    if (num_blocks < 8) {
+        // Short rows: inlined loop beats the indirect kernel call.
+        for (std::size_t i = 0; i < num_blocks; ++i) dst[i] |= src[i];
+    } else {
+        bitset_kernels::bitwise_or(dst, src, num_blocks);
+    }
+}
+
+BitMatrix::BitMatrix() : m_num_rows(0), m_blocks_per_row(0) { }
+
+BitMatrix::BitMatrix(int num_rows) : BitMatrix() {
+    reset(num_rows);
+}
+
+BitMatrix::BitMatrix(const RoleDenotation& denotation) : BitMatrix() {
+    assign(denotation);
+}
+
+BitMatrix::~BitMatrix() {
+    release_storage(m_blocks);
+}
+
+void BitMatrix::reset(int num_rows) {
+    m_num_rows = num_rows;
+    m_blocks_per_row = (num_rows + 63) / 64;
+    const std::size_t num_blocks = num_rows * m_blocks_per_row;
+    if (m_blocks.capacity() < num_blocks) {
+        release_storage(m_blocks);
+        m_blocks = acquire_storage(num_blocks);
+    }
+    m_blocks.assign(num_blocks, 0);
+}
+
+void BitMatrix::assign(const RoleDenotation& denotation) {
+    reset(denotation.get_num_objects());
+    if (denotation.m_is_dense) {
+        for (int row = 0; row < m_num_rows; ++row) {
+            denotation.m_data.read_range(row * m_num_rows, m_num_rows, &m_blocks[row * m_blocks_per_row]);
+        }
+    } else {
+        denotation.for_each([&](ObjectIndex first, ObjectIndex second) { set(first, second); });
+    }
+}
+
+bool BitMatrix::test(int row, int column) const {
+    return (m_blocks[row * m_blocks_per_row + column / 64] >> (column % 64)) & 1;
+}
+
+void BitMatrix::set(int row, int column) {
+    m_blocks[row * m_blocks_per_row + column / 64] |= std::uint64_t(1) << (column % 64);
+}
+
+void BitMatrix::or_row(int row, const BitMatrix& other, int other_row) {
+    assert(m_blocks_per_row == other.m_blocks_per_row);
+    or_blocks(&m_blocks[row * m_blocks_per_row], other.get_row(other_row), m_blocks_per_row);
+}
+
+void BitMatrix::to_role_denotation(RoleDenotation& result) const {
+    assert(result.get_num_objects() == m_num_rows);
+    result.assert_unindexed();
+    if (result.m_is_dense) {
+        result.m_data.reset();
+    } else {
+        result.m_positions.clear();
+        result.to_dense();
+    }
+    for (int row = 0; row < m_num_rows; ++row) {
+        result.m_data.or_range(row * m_num_rows, m_num_rows, &m_blocks[row * m_blocks_per_row]);
+    }
+    result.update_dense();
+}
+
+const std::uint64_t* BitMatrix::get_row(int row) const {
+    return &m_blocks[row * m_blocks_per_row];
+}
+
+std::size_t BitMatrix::get_blocks_per_row() const {
+    return m_blocks_per_row;
+}
+
+int BitMatrix::get_num_rows() const {
+    return m_num_rows;
+}
+
+
+PairwiseDistances::PairwiseDistances() : m_num_objects(0) { }
+
+PairwiseDistances::PairwiseDistances(const RoleDenotation& edges) : PairwiseDistances() {
+    compute(edges);
+}
+
+void PairwiseDistances::compute(const RoleDenotation& edges) {
+    BitMatrix matrix;
+    compute(edges, matrix);
+}
+
+void PairwiseDistances::compute(const RoleDenotation& edges, BitMatrix& matrix) {
+    m_num_objects = edges.get_num_objects();
+    m_distances.assign(m_num_objects * m_num_objects, INF);
+    matrix.assign(edges);
+    const std::size_t num_blocks = matrix.get_blocks_per_row();
+    m_search_blocks.resize(3 * num_blocks);
+    std::uint64_t* visited = m_search_blocks.data();
+    std::uint64_t* frontier = visited + num_blocks;
+    std::uint64_t* next = frontier + num_blocks;
+    for (int source = 0; source < m_num_objects; ++source) {
+        int* distances = &m_distances[source * m_num_objects];
+        distances[source] = 0;
+        std::fill(visited, visited + num_blocks, 0);
+        std::fill(frontier, frontier + num_blocks, 0);
+        visited[source / 64] = frontier[source / 64] = std::uint64_t(1) << (source % 64);
+        for (int distance = 1; ; ++distance) {
+            // next = (union of successor rows of the frontier) - visited
+            std::fill(next, next + num_blocks, 0);
+            for (std::size_t b = 0; b < num_blocks; ++b) {
+                for (std::uint64_t block = frontier[b]; block; block &= block - 1) {
+                    or_blocks(next, matrix.get_row(b * 64 + std::countr_zero(block)), num_blocks);
+                }
+            }
+            bool expanded = false;
+            for (std::size_t b = 0; b < num_blocks; ++b) {
+                next[b] &= ~visited[b];
+                visited[b] |= next[b];
+                for (std::uint64_t block = next[b]; block; block &= block - 1) {
+                    distances[b * 64 + std::countr_zero(block)] = distance;
+                    expanded = true;
+                }
+            }
+            if (!expanded) {
+                break;
+            }
+            std::swap(frontier, next);
+        }
+    }
+}
+
+int PairwiseDistances::get_distance(ObjectIndex source, ObjectIndex target) const {
+    return m_distances[source * m_num_objects + target];
+}
+
+int PairwiseDistances::get_num_objects() const {
+    return m_num_objects;
+}
 
-using AdjList = std::vector<std::vector<int>>;
+
+namespace utils {
 
 int path_addition(int a, int b) {
     if (a == INF || b == INF) {
@@ -21,61 +168,33 @@ int path_addition(int a, int b) {
 }
 
 
-AdjList compute_adjacency_list(const RoleDenotation& role_denot, bool forward=true) {
-    int num_objects = role_denot.get_num_objects();
-    AdjList adjacency_list(num_objects);
-    for (const auto& pair : role_denot.to_vector()) {
-        if (forward) adjacency_list[pair.first].push_back(pair.second);
-        else adjacency_list[pair.second].push_back(pair.first);
-    }
-    return adjacency_list;
-}
-
-
-Distances compute_distances_from_state(const AdjList& adj_list, int source) {
-    Distances distances(adj_list.size(), INF);
-    distances[source] = 0;
-    std::deque<int> queue;
-    queue.push_back(source);
-    while (!queue.empty()) {
-        int s = queue.front();
-        queue.pop_front();
-        for (int t : adj_list[s]) {
-            int alt = distances[s] + 1;
-            if (distances[t] > alt) {
-                queue.push_back(t);
-                distances[t] = alt;
-            }
-        }
-    }
-    return distances;
+int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets) {
+    Distances distances;
+    ObjectIndices queue;
+    return compute_multi_source_multi_target_shortest_distance(sources, adjacency, targets, distances, queue);
 }
 
-
-int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets) {
-    int num_objects = targets.get_num_objects();
-    Distances distances(num_objects, INF);
-    std::deque<int> queue;
-    for (int source : sources.to_vector()) {
+int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets, Distances& distances, ObjectIndices& queue) {
+    if (sources.intersects(targets)) {
+        return 0;
+    }
+    distances.assign(targets.get_num_objects(), INF);
+    queue.clear();
+    sources.for_each([&](ObjectIndex source) {
         distances[source] = 0;
         queue.push_back(source);
-        if (targets.contains(source)) {
-            return 0;
-        }
-    }
-    while (!queue.empty()) {
-        int source = queue.front();
-        queue.pop_front();
-        for (int target = 0; target < num_objects; ++target) {
-            if (edges.contains(std::make_pair(source,target))) {
-                int alt = distances[source] + 1;
-                if (distances[target] > alt) {
-                    if (targets.contains(target)) {
-                        return alt;
-                    }
-                    queue.push_back(target);
-                    distances[target] = alt;
+    });
+    // Every object enters the queue at most once, so the queue is a vector with a head index.
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int source = queue[head];
+        for (int target : adjacency.get_successors(source)) {
+            int alt = distances[source] + 1;
+            if (distances[target] > alt) {
+                if (targets.contains(target)) {
+                    return alt;
                 }
+                queue.push_back(target);
+                distances[target] = alt;
             }
         }
     }
@@ -83,53 +202,80 @@ int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation&
 }
 
 
-Distances compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets) {
-    int num_objects = targets.get_num_objects();
-    Distances distances(num_objects, INF);
-    std::deque<int> queue;
-    for (int source : sources.to_vector()) {
+Distances compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets) {
+    Distances distances;
+    ObjectIndices queue;
+    compute_multi_source_multi_target_shortest_distances(sources, adjacency, targets, distances, queue);
+    return distances;
+}
+
+void compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleAdjacency& adjacency, const ConceptDenotation& targets, Distances& distances, ObjectIndices& queue) {
+    distances.assign(targets.get_num_objects(), INF);
+    queue.clear();
+    sources.for_each([&](ObjectIndex source) {
         distances[source] = 0;
         queue.push_back(source);
-    }
-    while (!queue.empty()) {
-        int source = queue.front();
-        queue.pop_front();
-        for (int target = 0; target < num_objects; ++target) {
-            if (edges.contains(std::make_pair(source, target))) {
-                int alt = distances[source] + 1;
-                if (distances[target] > alt) {
-                    queue.push_back(target);
-                    distances[target] = alt;
-                }
+    });
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int source = queue[head];
+        for (int target : adjacency.get_successors(source)) {
+            int alt = distances[source] + 1;
+            if (distances[target] > alt) {
+                queue.push_back(target);
+                distances[target] = alt;
             }
         }
     }
-    return distances;
 }
 
 
-PairwiseDistances compute_floyd_warshall(const RoleDenotation& edges) {
-    int num_objects = edges.get_num_objects();
-    AdjList adj_list = compute_adjacency_list(edges);
-    PairwiseDistances dist(num_objects, Distances(num_objects, INF));
-    // initialize edge costs
-    for (int source = 0; source < num_objects; ++source) {
-        for (int target : adj_list[source]) {
-            dist[source][target] = 1;
-        }
-        dist[source][source] = 0;
+std::shared_ptr<const PairwiseDistances> get_pairwise_distances(const std::shared_ptr<const RoleDenotation>& edges, DenotationsCaches& caches) {
+    const bool was_computed = edges->has_pairwise_distances();
+    const PairwiseDistances& distances = edges->get_pairwise_distances();
+    if (!was_computed && caches.per_state_data) {
+        // The distances count against the memory budget and are evicted with the denotation.
+        caches.per_state_data->update_memory_usage(edges);
     }
-    // main loop
+    // The distances share the lifetime of the interned role denotation.
+    return std::shared_ptr<const PairwiseDistances>(edges, &distances);
+}
+
+
+void compute_transitive_closure(const RoleDenotation& denot, RoleDenotation& result) {
+    BitMatrix matrix;
+    compute_transitive_closure(denot, result, matrix);
+}
+
+void compute_transitive_closure(const RoleDenotation& denot, RoleDenotation& result, BitMatrix& matrix) {
+    matrix.assign(denot);
+    const int num_objects = matrix.get_num_rows();
+    // Warshall: after iteration k, row i contains every object reachable
+    // from i over intermediate objects in {0, ..., k}.
     for (int k = 0; k < num_objects; ++k) {
         for (int i = 0; i < num_objects; ++i) {
-            for (int j = 0; j < num_objects; ++j) {
-                if (dist[i][j] > path_addition(dist[i][k], dist[k][j])) {
-                    dist[i][j] = path_addition(dist[i][k], dist[k][j]);
-                }
+            if (i != k && matrix.test(i, k)) {
+                matrix.or_row(i, matrix, k);
             }
         }
     }
-    return dist;
+    matrix.to_role_denotation(result);
+}
+
+void compute_composition(const RoleDenotation& left, const RoleDenotation& right, RoleDenotation& result) {
+    BitMatrix right_matrix;
+    BitMatrix product;
+    compute_composition(left, right, result, right_matrix, product);
+}
+
+void compute_composition(const RoleDenotation& left, const RoleDenotation& right, RoleDenotation& result, BitMatrix& right_matrix, BitMatrix& product) {
+    right_matrix.assign(right);
+    product.reset(right_matrix.get_num_rows());
+    left.for_each([&](ObjectIndex first, ObjectIndex second) {
+        product.or_row(first, right_matrix, second);
+    });
+    product.to_role_denotation(result);
+}
+
 }
 
 }
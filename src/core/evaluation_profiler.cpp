@@ -0,0 +1,122 @@
+#include "../../include/dlplan/core.h"
+
+#include <algorithm>
+#include <iomanip>
+
+
+namespace dlplan::core {
+
+// The innermost scope of the calling thread.
+static thread_local EvaluationProfiler::Scope* current_scope = nullptr;
+
+void EvaluationProfiler::Scope::start() {
+    m_parent = current_scope;
+    current_scope = this;
+    m_nested_time = std::chrono::nanoseconds(0);
+    m_is_hit = true;
+    m_num_bytes = 0;
+    m_start = std::chrono::steady_clock::now();
+}
+
+void EvaluationProfiler::Scope::stop() {
+    auto cumulative_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+    current_scope = m_parent;
+    if (m_parent) {
+        m_parent->m_nested_time += cumulative_time;
+    }
+    m_profiler->record(*this, cumulative_time);
+}
+
+EvaluationProfiler::EvaluationProfiler() = default;
+
+EvaluationProfiler::~EvaluationProfiler() = default;
+
+void EvaluationProfiler::record(const Scope& scope, std::chrono::nanoseconds cumulative_time) {
+    std::lock_guard<std::mutex> hold(m_mutex);
+    auto result = m_profiles.try_emplace(scope.m_index);
+    auto& profile = result.first->second;
+    if (result.second) {
+        profile.index = scope.m_index;
+        profile.repr = scope.m_compute_repr(scope.m_element);
+    }
+    ++profile.num_calls;
+    if (scope.m_is_hit) {
+        ++profile.num_hits;
+    } else {
+        ++profile.num_misses;
+    }
+    profile.cumulative_time += cumulative_time;
+    profile.self_time += cumulative_time - scope.m_nested_time;
+    profile.num_bytes += scope.m_num_bytes;
+}
+
+std::vector<ElementProfile> EvaluationProfiler::get_profiles() const {
+    std::vector<ElementProfile> profiles;
+    {
+        std::lock_guard<std::mutex> hold(m_mutex);
+        profiles.reserve(m_profiles.size());
+        for (const auto& pair : m_profiles) {
+            profiles.push_back(pair.second);
+        }
+    }
+    std::sort(profiles.begin(), profiles.end(), [](const ElementProfile& left, const ElementProfile& right) {
+        if (left.self_time != right.self_time) return left.self_time > right.self_time;
+        return left.index < right.index;
+    });
+    return profiles;
+}
+
+void EvaluationProfiler::clear() {
+    std::lock_guard<std::mutex> hold(m_mutex);
+    m_profiles.clear();
+}
+
+/// @brief Writes the string as JSON string literal.
+static void write_json_string(std::ostream& out, const std::string& str) {
+    out << "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+            out << c;
+        }
+    }
+    out << "\"";
+}
+
+void EvaluationProfiler::write_json(std::ostream& out) const {
+    auto profiles = get_profiles();
+    out << "[";
+    for (std::size_t i = 0; i < profiles.size(); ++i) {
+        const auto& profile = profiles[i];
+        if (i > 0) out << ",";
+        out << "\n  {\"index\": " << profile.index
+            << ", \"repr\": ";
+        write_json_string(out, profile.repr);
+        out << ", \"num_calls\": " << profile.num_calls
+            << ", \"num_hits\": " << profile.num_hits
+            << ", \"num_misses\": " << profile.num_misses
+            << ", \"cumulative_time_ns\": " << profile.cumulative_time.count()
+            << ", \"self_time_ns\": " << profile.self_time.count()
+            << ", \"num_bytes\": " << profile.num_bytes << "}";
+    }
+    out << (profiles.empty() ? "]\n" : "\n]\n");
+}
+
+void EvaluationProfiler::write_csv(std::ostream& out) const {
+    out << "index,repr,num_calls,num_hits,num_misses,cumulative_time_ns,self_time_ns,num_bytes\n";
+    for (const auto& profile : get_profiles()) {
+        // Element descriptions contain commas but no quotes.
+        out << profile.index << ",\"" << profile.repr << "\","
+            << profile.num_calls << ","
+            << profile.num_hits << ","
+            << profile.num_misses << ","
+            << profile.cumulative_time.count() << ","
+            << profile.self_time.count() << ","
+            << profile.num_bytes << "\n";
+    }
+}
+
+}
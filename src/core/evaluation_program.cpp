@@ -0,0 +1,505 @@
+#include "evaluation_program.h"
+
+#include "element_factory.h"
+
+#include <stdexcept>
+
+
+namespace dlplan::core {
+
+static int to_index(RegisterType type) {
+    return static_cast<int>(type);
+}
+
+template<typename T>
+static const T* kernel(const Instruction& instruction) {
+    return static_cast<const T*>(instruction.element);
+}
+
+/// @brief Returns the child as T if the element is its only use such that a
+///        fused instruction can read the arguments of the child instead.
+template<typename T, typename Compilation, typename E>
+static const T* fuse(const Compilation& compilation, const std::shared_ptr<const E>& child) {
+    if (compilation.is_counting || compilation.num_uses.at(child.get()) > 1) {
+        return nullptr;
+    }
+    return dynamic_cast<const T*>(child.get());
+}
+
+Register EvaluationProgramImpl::emit(Compilation& compilation, bool is_static, Opcode opcode, const void* element, RegisterType result_type, std::initializer_list<Register> arguments) {
+    Instruction instruction{ opcode, element, Register{ result_type, compilation.num_registers[to_index(result_type)]++ }, { no_register, no_register, no_register } };
+    std::copy(arguments.begin(), arguments.end(), instruction.arguments.begin());
+    (is_static ? m_static_instructions : m_instructions).push_back(instruction);
+    return instruction.result;
+}
+
+Register EvaluationProgramImpl::compile(Compilation& compilation, const Boolean& element) {
+    if (compilation.is_counting) {
+        ++compilation.num_uses[&element];
+    }
+    auto it = compilation.registers.find(&element);
+    if (it != compilation.registers.end()) {
+        return it->second;
+    }
+    const bool is_static = element.is_static();
+    Register result;
+    if (const auto* e = dynamic_cast<const EmptyBoolean<Concept>*>(&element)) {
+        if (const auto* some = fuse<SomeConcept>(compilation, e->m_element)) {
+            result = emit(compilation, is_static, Opcode::EMPTY_SOME_CONCEPT, e, RegisterType::BOOLEAN, { compile(compilation, *some->m_role), compile(compilation, *some->m_concept) });
+        } else {
+            result = emit(compilation, is_static, Opcode::EMPTY_BOOLEAN_CONCEPT, e, RegisterType::BOOLEAN, { compile(compilation, *e->m_element) });
+        }
+    } else if (const auto* e = dynamic_cast<const EmptyBoolean<Role>*>(&element)) {
+        result = emit(compilation, is_static, Opcode::EMPTY_BOOLEAN_ROLE, e, RegisterType::BOOLEAN, { compile(compilation, *e->m_element) });
+    } else if (const auto* e = dynamic_cast<const InclusionBoolean<Concept>*>(&element)) {
+        if (const auto* left = fuse<AndConcept>(compilation, e->m_element_left)) {
+            result = emit(compilation, is_static, Opcode::INCLUSION_AND_CONCEPT, e, RegisterType::BOOLEAN, { compile(compilation, *left->m_concept_left), compile(compilation, *left->m_concept_right), compile(compilation, *e->m_element_right) });
+        } else {
+            result = emit(compilation, is_static, Opcode::INCLUSION_BOOLEAN_CONCEPT, e, RegisterType::BOOLEAN, { compile(compilation, *e->m_element_left), compile(compilation, *e->m_element_right) });
+        }
+    } else if (const auto* e = dynamic_cast<const InclusionBoolean<Role>*>(&element)) {
+        result = emit(compilation, is_static, Opcode::INCLUSION_BOOLEAN_ROLE, e, RegisterType::BOOLEAN, { compile(compilation, *e->m_element_left), compile(compilation, *e->m_element_right) });
+    } else if (const auto* e = dynamic_cast<const NullaryBoolean*>(&element)) {
+        result = emit(compilation, is_static, Opcode::NULLARY_BOOLEAN, e, RegisterType::BOOLEAN, {});
+    } else {
+        throw std::runtime_error("EvaluationProgram::EvaluationProgram - unsupported boolean (" + element.str() + ").");
+    }
+    compilation.registers.emplace(&element, result);
+    return result;
+}
+
+Register EvaluationProgramImpl::compile(Compilation& compilation, const Numerical& element) {
+    if (compilation.is_counting) {
+        ++compilation.num_uses[&element];
+    }
+    auto it = compilation.registers.find(&element);
+    if (it != compilation.registers.end()) {
+        return it->second;
+    }
+    const bool is_static = element.is_static();
+    Register result;
+    if (const auto* e = dynamic_cast<const ConceptDistanceNumerical*>(&element)) {
+        result = emit(compilation, is_static, Opcode::CONCEPT_DISTANCE_NUMERICAL, e, RegisterType::NUMERICAL, { compile(compilation, *e->m_concept_from), compile(compilation, *e->m_role), compile(compilation, *e->m_concept_to) });
+    } else if (const auto* e = dynamic_cast<const CountNumerical<Concept>*>(&element)) {
+        if (const auto* and_ = fuse<AndConcept>(compilation, e->m_element)) {
+            result = emit(compilation, is_static, Opcode::COUNT_AND_CONCEPT, e, RegisterType::NUMERICAL, { compile(compilation, *and_->m_concept_left), compile(compilation, *and_->m_concept_right) });
+        } else {
+            result = emit(compilation, is_static, Opcode::COUNT_NUMERICAL_CONCEPT, e, RegisterType::NUMERICAL, { compile(compilation, *e->m_element) });
+        }
+    } else if (const auto* e = dynamic_cast<const CountNumerical<Role>*>(&element)) {
+        result = emit(compilation, is_static, Opcode::COUNT_NUMERICAL_ROLE, e, RegisterType::NUMERICAL, { compile(compilation, *e->m_element) });
+    } else if (const auto* e = dynamic_cast<const RoleDistanceNumerical*>(&element)) {
+        result = emit(compilation, is_static, Opcode::ROLE_DISTANCE_NUMERICAL, e, RegisterType::NUMERICAL, { compile(compilation, *e->m_role_from), compile(compilation, *e->m_role), compile(compilation, *e->m_role_to) });
+    } else if (const auto* e = dynamic_cast<const SumConceptDistanceNumerical*>(&element)) {
+        result = emit(compilation, is_static, Opcode::SUM_CONCEPT_DISTANCE_NUMERICAL, e, RegisterType::NUMERICAL, { compile(compilation, *e->m_concept_from), compile(compilation, *e->m_role), compile(compilation, *e->m_concept_to) });
+    } else if (const auto* e = dynamic_cast<const SumRoleDistanceNumerical*>(&element)) {
+        result = emit(compilation, is_static, Opcode::SUM_ROLE_DISTANCE_NUMERICAL, e, RegisterType::NUMERICAL, { compile(compilation, *e->m_role_from), compile(compilation, *e->m_role), compile(compilation, *e->m_role_to) });
+    } else {
+        throw std::runtime_error("EvaluationProgram::EvaluationProgram - unsupported numerical (" + element.str() + ").");
+    }
+    compilation.registers.emplace(&element, result);
+    return result;
+}
+
+Register EvaluationProgramImpl::compile(Compilation& compilation, const Concept& element) {
+    if (compilation.is_counting) {
+        ++compilation.num_uses[&element];
+    }
+    auto it = compilation.registers.find(&element);
+    if (it != compilation.registers.end()) {
+        return it->second;
+    }
+    const bool is_static = element.is_static();
+    Register result;
+    if (const auto* e = dynamic_cast<const AllConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::ALL_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_role), compile(compilation, *e->m_concept) });
+    } else if (const auto* e = dynamic_cast<const AndConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::AND_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_concept_left), compile(compilation, *e->m_concept_right) });
+    } else if (const auto* e = dynamic_cast<const BotConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::BOT_CONCEPT, e, RegisterType::CONCEPT, {});
+    } else if (const auto* e = dynamic_cast<const DiffConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::DIFF_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_concept_left), compile(compilation, *e->m_concept_right) });
+    } else if (const auto* e = dynamic_cast<const EqualConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::EQUAL_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_role_left), compile(compilation, *e->m_role_right) });
+    } else if (const auto* e = dynamic_cast<const NotConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::NOT_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_concept) });
+    } else if (const auto* e = dynamic_cast<const OneOfConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::ONE_OF_CONCEPT, e, RegisterType::CONCEPT, {});
+    } else if (const auto* e = dynamic_cast<const OrConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::OR_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_concept_left), compile(compilation, *e->m_concept_right) });
+    } else if (const auto* e = dynamic_cast<const PrimitiveConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::PRIMITIVE_CONCEPT, e, RegisterType::CONCEPT, {});
+    } else if (const auto* e = dynamic_cast<const ProjectionConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::PROJECTION_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_role) });
+    } else if (const auto* e = dynamic_cast<const SomeConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::SOME_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_role), compile(compilation, *e->m_concept) });
+    } else if (const auto* e = dynamic_cast<const SubsetConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::SUBSET_CONCEPT, e, RegisterType::CONCEPT, { compile(compilation, *e->m_role_left), compile(compilation, *e->m_role_right) });
+    } else if (const auto* e = dynamic_cast<const TopConcept*>(&element)) {
+        result = emit(compilation, is_static, Opcode::TOP_CONCEPT, e, RegisterType::CONCEPT, {});
+    } else {
+        throw std::runtime_error("EvaluationProgram::EvaluationProgram - unsupported concept (" + element.str() + ").");
+    }
+    compilation.registers.emplace(&element, result);
+    return result;
+}
+
+Register EvaluationProgramImpl::compile(Compilation& compilation, const Role& element) {
+    if (compilation.is_counting) {
+        ++compilation.num_uses[&element];
+    }
+    auto it = compilation.registers.find(&element);
+    if (it != compilation.registers.end()) {
+        return it->second;
+    }
+    const bool is_static = element.is_static();
+    Register result;
+    if (const auto* e = dynamic_cast<const AndRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::AND_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role_left), compile(compilation, *e->m_role_right) });
+    } else if (const auto* e = dynamic_cast<const ComposeRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::COMPOSE_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role_left), compile(compilation, *e->m_role_right) });
+    } else if (const auto* e = dynamic_cast<const DiffRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::DIFF_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role_left), compile(compilation, *e->m_role_right) });
+    } else if (const auto* e = dynamic_cast<const IdentityRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::IDENTITY_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_concept) });
+    } else if (const auto* e = dynamic_cast<const InverseRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::INVERSE_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role) });
+    } else if (const auto* e = dynamic_cast<const NotRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::NOT_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role) });
+    } else if (const auto* e = dynamic_cast<const OrRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::OR_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role_left), compile(compilation, *e->m_role_right) });
+    } else if (const auto* e = dynamic_cast<const PrimitiveRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::PRIMITIVE_ROLE, e, RegisterType::ROLE, {});
+    } else if (const auto* e = dynamic_cast<const RestrictRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::RESTRICT_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role), compile(compilation, *e->m_concept) });
+    } else if (const auto* e = dynamic_cast<const TilCRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::TIL_C_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role), compile(compilation, *e->m_concept) });
+    } else if (const auto* e = dynamic_cast<const TopRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::TOP_ROLE, e, RegisterType::ROLE, {});
+    } else if (const auto* e = dynamic_cast<const TransitiveClosureRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::TRANSITIVE_CLOSURE_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role) });
+    } else if (const auto* e = dynamic_cast<const TransitiveReflexiveClosureRole*>(&element)) {
+        result = emit(compilation, is_static, Opcode::TRANSITIVE_REFLEXIVE_CLOSURE_ROLE, e, RegisterType::ROLE, { compile(compilation, *e->m_role) });
+    } else {
+        throw std::runtime_error("EvaluationProgram::EvaluationProgram - unsupported role (" + element.str() + ").");
+    }
+    compilation.registers.emplace(&element, result);
+    return result;
+}
+
+void EvaluationProgramImpl::allocate_registers(const Compilation& compilation) {
+    std::array<std::vector<int>, 4> physical;
+    std::array<std::vector<int>, 4> last_read;
+    std::array<std::vector<bool>, 4> pinned;
+    std::array<std::vector<int>, 4> free_registers;
+    for (int type = 0; type < 4; ++type) {
+        physical[type].resize(compilation.num_registers[type], -1);
+        last_read[type].resize(compilation.num_registers[type], -1);
+        pinned[type].resize(compilation.num_registers[type], false);
+    }
+    m_num_registers = {};
+    // Registers of static elements are written once per instance.
+    for (auto& instruction : m_static_instructions) {
+        for (auto& argument : instruction.arguments) {
+            if (argument.type != RegisterType::NONE) argument.index = physical[to_index(argument.type)][argument.index];
+        }
+        int type = to_index(instruction.result.type);
+        pinned[type][instruction.result.index] = true;
+        physical[type][instruction.result.index] = m_num_registers[type]++;
+        instruction.result.index = physical[type][instruction.result.index];
+    }
+    // Registers of results are read after the program.
+    for (auto [type, results] : { std::make_pair(RegisterType::BOOLEAN, &m_boolean_results),
+                                  std::make_pair(RegisterType::NUMERICAL, &m_numerical_results),
+                                  std::make_pair(RegisterType::CONCEPT, &m_concept_results),
+                                  std::make_pair(RegisterType::ROLE, &m_role_results) }) {
+        for (int index : *results) pinned[to_index(type)][index] = true;
+    }
+    for (size_t i = 0; i < m_instructions.size(); ++i) {
+        for (const auto& argument : m_instructions[i].arguments) {
+            if (argument.type != RegisterType::NONE) last_read[to_index(argument.type)][argument.index] = i;
+        }
+    }
+    for (size_t i = 0; i < m_instructions.size(); ++i) {
+        auto& instruction = m_instructions[i];
+        // Allocate the result before releasing the arguments
+        // such that kernels never write into their arguments.
+        int type = to_index(instruction.result.type);
+        int& result = physical[type][instruction.result.index];
+        if (free_registers[type].empty()) {
+            result = m_num_registers[type]++;
+        } else {
+            result = free_registers[type].back();
+            free_registers[type].pop_back();
+        }
+        for (auto& argument : instruction.arguments) {
+            if (argument.type == RegisterType::NONE) continue;
+            int argument_type = to_index(argument.type);
+            if (!pinned[argument_type][argument.index] && last_read[argument_type][argument.index] == static_cast<int>(i)) {
+                free_registers[argument_type].push_back(physical[argument_type][argument.index]);
+                // Release arguments that are read twice only once.
+                last_read[argument_type][argument.index] = -1;
+            }
+            argument.index = physical[argument_type][argument.index];
+        }
+        instruction.result.index = result;
+    }
+    for (auto [type, results] : { std::make_pair(RegisterType::BOOLEAN, &m_boolean_results),
+                                  std::make_pair(RegisterType::NUMERICAL, &m_numerical_results),
+                                  std::make_pair(RegisterType::CONCEPT, &m_concept_results),
+                                  std::make_pair(RegisterType::ROLE, &m_role_results) }) {
+        for (int& index : *results) index = physical[to_index(type)][index];
+    }
+}
+
+EvaluationProgramImpl::EvaluationProgramImpl(
+    const std::vector<std::shared_ptr<const Boolean>>& booleans,
+    const std::vector<std::shared_ptr<const Numerical>>& numericals,
+    const std::vector<std::shared_ptr<const Concept>>& concepts,
+    const std::vector<std::shared_ptr<const Role>>& roles)
+    : m_num_registers{}, m_booleans(booleans), m_numericals(numericals), m_concepts(concepts), m_roles(roles) {
+    // The first pass counts the uses of each element without fusing,
+    // the second pass fuses instructions only with children of a single use.
+    Compilation counting;
+    compile_results(counting);
+    Compilation compilation;
+    compilation.num_uses = std::move(counting.num_uses);
+    compilation.is_counting = false;
+    compile_results(compilation);
+    allocate_registers(compilation);
+}
+
+void EvaluationProgramImpl::compile_results(Compilation& compilation) {
+    m_static_instructions.clear();
+    m_instructions.clear();
+    m_boolean_results.clear();
+    m_numerical_results.clear();
+    m_concept_results.clear();
+    m_role_results.clear();
+    for (const auto& boolean : m_booleans) m_boolean_results.push_back(compile(compilation, *boolean).index);
+    for (const auto& numerical : m_numericals) m_numerical_results.push_back(compile(compilation, *numerical).index);
+    for (const auto& concept_ : m_concepts) m_concept_results.push_back(compile(compilation, *concept_).index);
+    for (const auto& role : m_roles) m_role_results.push_back(compile(compilation, *role).index);
+}
+
+void EvaluationProgramImpl::initialize(const State& state) {
+    m_instance_info = state.get_instance_info();
+    const int num_objects = m_instance_info->get_objects().size();
+    m_boolean_registers.assign(m_num_registers[to_index(RegisterType::BOOLEAN)], false);
+    m_numerical_registers.assign(m_num_registers[to_index(RegisterType::NUMERICAL)], 0);
+    m_concept_registers.assign(m_num_registers[to_index(RegisterType::CONCEPT)], ConceptDenotation(num_objects));
+    m_role_registers.assign(m_num_registers[to_index(RegisterType::ROLE)], RoleDenotation(num_objects));
+    for (const auto& instruction : m_static_instructions) {
+        execute(instruction, state);
+    }
+}
+
+void EvaluationProgramImpl::execute(const Instruction& instruction, const State& state) {
+    const auto& arguments = instruction.arguments;
+    const int result = instruction.result.index;
+    auto& concepts = m_concept_registers;
+    auto& roles = m_role_registers;
+    auto& numericals = m_numerical_registers;
+    bool value;
+    switch (instruction.opcode) {
+        case Opcode::EMPTY_BOOLEAN_CONCEPT:
+            kernel<EmptyBoolean<Concept>>(instruction)->compute_result(concepts[arguments[0].index], value);
+            m_boolean_registers[result] = value;
+            break;
+        case Opcode::EMPTY_BOOLEAN_ROLE:
+            kernel<EmptyBoolean<Role>>(instruction)->compute_result(roles[arguments[0].index], value);
+            m_boolean_registers[result] = value;
+            break;
+        case Opcode::INCLUSION_BOOLEAN_CONCEPT:
+            kernel<InclusionBoolean<Concept>>(instruction)->compute_result(concepts[arguments[0].index], concepts[arguments[1].index], value);
+            m_boolean_registers[result] = value;
+            break;
+        case Opcode::INCLUSION_BOOLEAN_ROLE:
+            kernel<InclusionBoolean<Role>>(instruction)->compute_result(roles[arguments[0].index], roles[arguments[1].index], value);
+            m_boolean_registers[result] = value;
+            break;
+        case Opcode::NULLARY_BOOLEAN:
+            kernel<NullaryBoolean>(instruction)->compute_result(state, value);
+            m_boolean_registers[result] = value;
+            break;
+        case Opcode::ALL_CONCEPT:
+            kernel<AllConcept>(instruction)->compute_result(roles[arguments[0].index], concepts[arguments[1].index], concepts[result]);
+            break;
+        case Opcode::AND_CONCEPT:
+            kernel<AndConcept>(instruction)->compute_result(concepts[arguments[0].index], concepts[arguments[1].index], concepts[result]);
+            break;
+        case Opcode::BOT_CONCEPT:
+            concepts[result].clear();
+            break;
+        case Opcode::DIFF_CONCEPT:
+            kernel<DiffConcept>(instruction)->compute_result(concepts[arguments[0].index], concepts[arguments[1].index], concepts[result]);
+            break;
+        case Opcode::EQUAL_CONCEPT:
+            kernel<EqualConcept>(instruction)->compute_result(roles[arguments[0].index], roles[arguments[1].index], concepts[result]);
+            break;
+        case Opcode::NOT_CONCEPT:
+            kernel<NotConcept>(instruction)->compute_result(concepts[arguments[0].index], concepts[result]);
+            break;
+        case Opcode::ONE_OF_CONCEPT:
+            concepts[result].clear();
+            kernel<OneOfConcept>(instruction)->compute_result(state, concepts[result]);
+            break;
+        case Opcode::OR_CONCEPT:
+            kernel<OrConcept>(instruction)->compute_result(concepts[arguments[0].index], concepts[arguments[1].index], concepts[result]);
+            break;
+        case Opcode::PRIMITIVE_CONCEPT:
+            concepts[result].clear();
+            kernel<PrimitiveConcept>(instruction)->compute_result(state, concepts[result]);
+            break;
+        case Opcode::PROJECTION_CONCEPT:
+            concepts[result].clear();
+            kernel<ProjectionConcept>(instruction)->compute_result(roles[arguments[0].index], concepts[result]);
+            break;
+        case Opcode::SOME_CONCEPT:
+            concepts[result].clear();
+            kernel<SomeConcept>(instruction)->compute_result(roles[arguments[0].index], concepts[arguments[1].index], concepts[result]);
+            break;
+        case Opcode::SUBSET_CONCEPT:
+            kernel<SubsetConcept>(instruction)->compute_result(roles[arguments[0].index], roles[arguments[1].index], concepts[result]);
+            break;
+        case Opcode::TOP_CONCEPT:
+            concepts[result].set();
+            break;
+        case Opcode::CONCEPT_DISTANCE_NUMERICAL:
+        case Opcode::SUM_CONCEPT_DISTANCE_NUMERICAL: {
+            const auto& concept_from = concepts[arguments[0].index];
+            const auto& concept_to = concepts[arguments[2].index];
+            if (concept_from.empty() || concept_to.empty()) {
+                numericals[result] = INF;
+            } else if (instruction.opcode == Opcode::CONCEPT_DISTANCE_NUMERICAL) {
+                if (concept_from.intersects(concept_to)) {
+                    numericals[result] = 0;
+                    break;
+                }
+                m_adjacency.compute(roles[arguments[1].index]);
+                kernel<ConceptDistanceNumerical>(instruction)->compute_result(concept_from, m_adjacency, concept_to, m_distances, m_queue, numericals[result]);
+            } else {
+                m_adjacency.compute(roles[arguments[1].index]);
+                kernel<SumConceptDistanceNumerical>(instruction)->compute_result(concept_from, m_adjacency, concept_to, m_distances, m_queue, numericals[result]);
+            }
+            break;
+        }
+        case Opcode::COUNT_NUMERICAL_CONCEPT:
+            kernel<CountNumerical<Concept>>(instruction)->compute_result(concepts[arguments[0].index], numericals[result]);
+            break;
+        case Opcode::COUNT_NUMERICAL_ROLE:
+            kernel<CountNumerical<Role>>(instruction)->compute_result(roles[arguments[0].index], numericals[result]);
+            break;
+        case Opcode::ROLE_DISTANCE_NUMERICAL:
+        case Opcode::SUM_ROLE_DISTANCE_NUMERICAL: {
+            const auto& role_from = roles[arguments[0].index];
+            const auto& role_to = roles[arguments[2].index];
+            if (role_from.empty() || role_to.empty()) {
+                numericals[result] = INF;
+                break;
+            }
+            m_pairwise_distances.compute(roles[arguments[1].index], m_matrix);
+            m_adjacency.compute(role_from);
+            m_target_adjacency.compute(role_to);
+            if (instruction.opcode == Opcode::ROLE_DISTANCE_NUMERICAL) {
+                kernel<RoleDistanceNumerical>(instruction)->compute_result(m_adjacency, m_pairwise_distances, m_target_adjacency, numericals[result]);
+            } else {
+                kernel<SumRoleDistanceNumerical>(instruction)->compute_result(m_adjacency, m_pairwise_distances, m_target_adjacency, numericals[result]);
+            }
+            break;
+        }
+        case Opcode::AND_ROLE:
+            kernel<AndRole>(instruction)->compute_result(roles[arguments[0].index], roles[arguments[1].index], roles[result]);
+            break;
+        case Opcode::COMPOSE_ROLE:
+            kernel<ComposeRole>(instruction)->compute_result(roles[arguments[0].index], roles[arguments[1].index], roles[result], m_matrix, m_product);
+            break;
+        case Opcode::DIFF_ROLE:
+            kernel<DiffRole>(instruction)->compute_result(roles[arguments[0].index], roles[arguments[1].index], roles[result]);
+            break;
+        case Opcode::IDENTITY_ROLE:
+            roles[result].clear();
+            kernel<IdentityRole>(instruction)->compute_result(concepts[arguments[0].index], roles[result]);
+            break;
+        case Opcode::INVERSE_ROLE:
+            roles[result].clear();
+            kernel<InverseRole>(instruction)->compute_result(roles[arguments[0].index], roles[result]);
+            break;
+        case Opcode::NOT_ROLE:
+            kernel<NotRole>(instruction)->compute_result(roles[arguments[0].index], roles[result]);
+            break;
+        case Opcode::OR_ROLE:
+            kernel<OrRole>(instruction)->compute_result(roles[arguments[0].index], roles[arguments[1].index], roles[result]);
+            break;
+        case Opcode::PRIMITIVE_ROLE:
+            roles[result].clear();
+            kernel<PrimitiveRole>(instruction)->compute_result(state, roles[result]);
+            break;
+        case Opcode::RESTRICT_ROLE:
+            kernel<RestrictRole>(instruction)->compute_result(roles[arguments[0].index], concepts[arguments[1].index], roles[result]);
+            break;
+        case Opcode::TIL_C_ROLE:
+            roles[result].clear();
+            m_adjacency.compute(roles[arguments[0].index]);
+            kernel<TilCRole>(instruction)->compute_result(m_adjacency, concepts[arguments[1].index], roles[result]);
+            break;
+        case Opcode::TOP_ROLE:
+            roles[result].set();
+            break;
+        case Opcode::TRANSITIVE_CLOSURE_ROLE:
+            kernel<TransitiveClosureRole>(instruction)->compute_result(roles[arguments[0].index], roles[result], m_matrix);
+            break;
+        case Opcode::TRANSITIVE_REFLEXIVE_CLOSURE_ROLE:
+            kernel<TransitiveReflexiveClosureRole>(instruction)->compute_result(roles[arguments[0].index], roles[result].get_num_objects(), roles[result], m_matrix);
+            break;
+        case Opcode::COUNT_AND_CONCEPT:
+            numericals[result] = concepts[arguments[0].index].intersection_size(concepts[arguments[1].index]);
+            break;
+        case Opcode::EMPTY_SOME_CONCEPT: {
+            // Stops at the first (a,b) in R with b in C.
+            const auto& concept_ = concepts[arguments[1].index];
+            m_boolean_registers[result] = !roles[arguments[0].index].any_of([&](ObjectIndex, ObjectIndex second) {
+                return concept_.contains(second);
+            });
+            break;
+        }
+        case Opcode::INCLUSION_AND_CONCEPT:
+            m_boolean_registers[result] = concepts[arguments[0].index].intersection_is_subset_of(concepts[arguments[1].index], concepts[arguments[2].index]);
+            break;
+    }
+}
+
+void EvaluationProgramImpl::evaluate(const State& state) {
+    if (state.get_instance_info() != m_instance_info) {
+        initialize(state);
+    }
+    for (const auto& instruction : m_instructions) {
+        execute(instruction, state);
+    }
+}
+
+bool EvaluationProgramImpl::get_boolean_value(int pos) const {
+    return m_boolean_registers.at(m_boolean_results.at(pos));
+}
+
+int EvaluationProgramImpl::get_numerical_value(int pos) const {
+    return m_numerical_registers.at(m_numerical_results.at(pos));
+}
+
+const ConceptDenotation& EvaluationProgramImpl::get_concept_denotation(int pos) const {
+    return m_concept_registers.at(m_concept_results.at(pos));
+}
+
+const RoleDenotation& EvaluationProgramImpl::get_role_denotation(int pos) const {
+    return m_role_registers.at(m_role_results.at(pos));
+}
+
+int EvaluationProgramImpl::get_num_instructions() const {
+    return m_static_instructions.size() + m_instructions.size();
+}
+
+int EvaluationProgramImpl::get_num_registers() const {
+    return m_num_registers[0] + m_num_registers[1] + m_num_registers[2] + m_num_registers[3];
+}
+
+}
@@ -0,0 +1,168 @@
+#ifndef DLPLAN_SRC_CORE_EVALUATION_PROGRAM_H_
+#define DLPLAN_SRC_CORE_EVALUATION_PROGRAM_H_
+
+#include "../../include/dlplan/core.h"
+#include "../../include/dlplan/core/elements/utils.h"
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+
+namespace dlplan::core {
+/// @brief The kernel that an instruction runs, one per element type.
+enum class Opcode : std::uint8_t {
+    EMPTY_BOOLEAN_CONCEPT,
+    EMPTY_BOOLEAN_ROLE,
+    INCLUSION_BOOLEAN_CONCEPT,
+    INCLUSION_BOOLEAN_ROLE,
+    NULLARY_BOOLEAN,
+    ALL_CONCEPT,
+    AND_CONCEPT,
+    BOT_CONCEPT,
+    DIFF_CONCEPT,
+    EQUAL_CONCEPT,
+    NOT_CONCEPT,
+    ONE_OF_CONCEPT,
+    OR_CONCEPT,
+    PRIMITIVE_CONCEPT,
+    PROJECTION_CONCEPT,
+    SOME_CONCEPT,
+    SUBSET_CONCEPT,
+    TOP_CONCEPT,
+    CONCEPT_DISTANCE_NUMERICAL,
+    COUNT_NUMERICAL_CONCEPT,
+    COUNT_NUMERICAL_ROLE,
+    ROLE_DISTANCE_NUMERICAL,
+    SUM_CONCEPT_DISTANCE_NUMERICAL,
+    SUM_ROLE_DISTANCE_NUMERICAL,
+    AND_ROLE,
+    COMPOSE_ROLE,
+    DIFF_ROLE,
+    IDENTITY_ROLE,
+    INVERSE_ROLE,
+    NOT_ROLE,
+    OR_ROLE,
+    PRIMITIVE_ROLE,
+    RESTRICT_ROLE,
+    TIL_C_ROLE,
+    TOP_ROLE,
+    TRANSITIVE_CLOSURE_ROLE,
+    TRANSITIVE_REFLEXIVE_CLOSURE_ROLE,
+    // Fused kernels of an element and its only child.
+    COUNT_AND_CONCEPT,
+    EMPTY_SOME_CONCEPT,
+    INCLUSION_AND_CONCEPT,
+};
+
+enum class RegisterType : std::uint8_t {
+    BOOLEAN,
+    NUMERICAL,
+    CONCEPT,
+    ROLE,
+    NONE,
+};
+
+struct Register {
+    RegisterType type;
+    int index;
+};
+
+const Register no_register = Register{ RegisterType::NONE, -1 };
+
+/// @brief Applies the kernel of an element to the argument registers
+///        and writes into the result register.
+struct Instruction {
+    Opcode opcode;
+    // The element that provides the kernel, its dynamic type is given by the opcode.
+    const void* element;
+    Register result;
+    std::array<Register, 3> arguments;
+};
+
+class EvaluationProgramImpl {
+private:
+    // Instructions of static elements run once per instance,
+    // all other instructions run once per state, each in topological order.
+    std::vector<Instruction> m_static_instructions;
+    std::vector<Instruction> m_instructions;
+
+    std::array<int, 4> m_num_registers;
+    std::vector<std::uint8_t> m_boolean_registers;
+    std::vector<int> m_numerical_registers;
+    std::vector<ConceptDenotation> m_concept_registers;
+    std::vector<RoleDenotation> m_role_registers;
+    // Reused by the role distance kernels.
+    PairwiseDistances m_pairwise_distances;
+    // Reused by the kernels that index, search or multiply role denotations.
+    RoleAdjacency m_adjacency;
+    RoleAdjacency m_target_adjacency;
+    BitMatrix m_matrix;
+    BitMatrix m_product;
+    utils::Distances m_distances;
+    ObjectIndices m_queue;
+
+    // Registers of the results in the order of the compiled elements.
+    std::vector<int> m_boolean_results;
+    std::vector<int> m_numerical_results;
+    std::vector<int> m_concept_results;
+    std::vector<int> m_role_results;
+
+    // The instance of the registers and the static results.
+    std::shared_ptr<InstanceInfo> m_instance_info;
+
+    // Keeps the compiled elements alive.
+    std::vector<std::shared_ptr<const Boolean>> m_booleans;
+    std::vector<std::shared_ptr<const Numerical>> m_numericals;
+    std::vector<std::shared_ptr<const Concept>> m_concepts;
+    std::vector<std::shared_ptr<const Role>> m_roles;
+
+    struct Compilation {
+        std::unordered_map<const void*, Register> registers;
+        std::array<int, 4> num_registers{};
+        // The number of parents and results that read each element.
+        std::unordered_map<const void*, int> num_uses;
+        bool is_counting = true;
+    };
+
+    Register emit(Compilation& compilation, bool is_static, Opcode opcode, const void* element, RegisterType result_type, std::initializer_list<Register> arguments);
+    Register compile(Compilation& compilation, const Boolean& element);
+    Register compile(Compilation& compilation, const Numerical& element);
+    Register compile(Compilation& compilation, const Concept& element);
+    Register compile(Compilation& compilation, const Role& element);
+    /// @brief Compiles the elements given on construction into new instructions.
+    void compile_results(Compilation& compilation);
+
+    /// @brief Maps the registers of dynamic instructions such that registers
+    ///        are reused after their last read.
+    void allocate_registers(const Compilation& compilation);
+
+    /// @brief Allocates the registers for the instance of the state
+    ///        and runs the static instructions.
+    void initialize(const State& state);
+    void execute(const Instruction& instruction, const State& state);
+
+public:
+    EvaluationProgramImpl(
+        const std::vector<std::shared_ptr<const Boolean>>& booleans,
+        const std::vector<std::shared_ptr<const Numerical>>& numericals,
+        const std::vector<std::shared_ptr<const Concept>>& concepts,
+        const std::vector<std::shared_ptr<const Role>>& roles);
+
+    void evaluate(const State& state);
+
+    bool get_boolean_value(int pos) const;
+    int get_numerical_value(int pos) const;
+    const ConceptDenotation& get_concept_denotation(int pos) const;
+    const RoleDenotation& get_role_denotation(int pos) const;
+
+    int get_num_instructions() const;
+    int get_num_registers() const;
+};
+
+}
+
+#endif
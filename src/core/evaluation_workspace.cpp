@@ -0,0 +1,66 @@
+#include "../../include/dlplan/core.h"
+
+
+namespace dlplan::core {
+
+// The workspace of the innermost activation of the calling thread.
+static thread_local EvaluationWorkspace* current_workspace = nullptr;
+
+// Bounds the free storage of each capacity, e.g., after evaluating a batch of
+// many states, such that a workspace does not retain its peak memory usage.
+static const std::size_t max_num_free_storage = 64;
+
+EvaluationWorkspace::EvaluationWorkspace() : m_num_allocations(0) { }
+
+EvaluationWorkspace::~EvaluationWorkspace() = default;
+
+std::vector<std::uint64_t> EvaluationWorkspace::acquire(std::size_t num_blocks) {
+    if (num_blocks == 0) {
+        return {};
+    }
+    auto it = m_free_storage.find(num_blocks);
+    if (it != m_free_storage.end() && !it->second.empty()) {
+        std::vector<std::uint64_t> storage = std::move(it->second.back());
+        it->second.pop_back();
+        return storage;
+    }
+    ++m_num_allocations;
+    std::vector<std::uint64_t> storage;
+    storage.reserve(num_blocks);
+    return storage;
+}
+
+void EvaluationWorkspace::release(std::vector<std::uint64_t>&& storage) {
+    if (storage.capacity() == 0) {
+        return;
+    }
+    auto& free_storage = m_free_storage[storage.capacity()];
+    if (free_storage.size() >= max_num_free_storage) {
+        return;
+    }
+    storage.clear();
+    free_storage.push_back(std::move(storage));
+}
+
+void EvaluationWorkspace::clear() {
+    m_free_storage.clear();
+}
+
+std::size_t EvaluationWorkspace::get_num_allocations() const {
+    return m_num_allocations;
+}
+
+EvaluationWorkspace::Activation::Activation(EvaluationWorkspace& workspace)
+    : m_previous(current_workspace) {
+    current_workspace = &workspace;
+}
+
+EvaluationWorkspace::Activation::~Activation() {
+    current_workspace = m_previous;
+}
+
+EvaluationWorkspace* EvaluationWorkspace::get_current() {
+    return current_workspace;
+}
+
+}
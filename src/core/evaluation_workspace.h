@@ -0,0 +1,59 @@
+#ifndef DLPLAN_SRC_CORE_EVALUATION_WORKSPACE_H_
+#define DLPLAN_SRC_CORE_EVALUATION_WORKSPACE_H_
+
+#include "../../include/dlplan/core.h"
+
+
+namespace dlplan::core {
+/// @brief Creates a bitset with all bits unset, in storage of the current
+///        workspace if there is one.
+inline DynamicBitset<std::uint64_t> make_bitset(std::size_t num_bits) {
+    EvaluationWorkspace* workspace = EvaluationWorkspace::get_current();
+    if (workspace) {
+        return DynamicBitset<std::uint64_t>(num_bits, workspace->acquire(DynamicBitset<std::uint64_t>::get_num_blocks(num_bits)));
+    }
+    return DynamicBitset<std::uint64_t>(num_bits);
+}
+
+/// @brief Creates a copy of the bitset, in storage of the current workspace
+///        if there is one.
+inline DynamicBitset<std::uint64_t> copy_bitset(const DynamicBitset<std::uint64_t>& other) {
+    EvaluationWorkspace* workspace = EvaluationWorkspace::get_current();
+    if (workspace) {
+        return DynamicBitset<std::uint64_t>(other, workspace->acquire(DynamicBitset<std::uint64_t>::get_num_blocks(other.size())));
+    }
+    return other;
+}
+
+/// @brief Returns empty storage with a capacity of at least the given number
+///        of blocks, from the current workspace if there is one.
+inline std::vector<std::uint64_t> acquire_storage(std::size_t num_blocks) {
+    EvaluationWorkspace* workspace = EvaluationWorkspace::get_current();
+    if (workspace) {
+        return workspace->acquire(num_blocks);
+    }
+    std::vector<std::uint64_t> storage;
+    storage.reserve(num_blocks);
+    return storage;
+}
+
+/// @brief Moves the storage out of the vector and returns it to the current
+///        workspace if there is one. Frees it otherwise.
+inline void release_storage(std::vector<std::uint64_t>& storage) {
+    std::vector<std::uint64_t> released = std::move(storage);
+    EvaluationWorkspace* workspace = EvaluationWorkspace::get_current();
+    if (workspace) {
+        workspace->release(std::move(released));
+    }
+}
+
+/// @brief Moves the storage out of the bitset and returns it to the current
+///        workspace if there is one. Frees it otherwise.
+inline void release_bitset(DynamicBitset<std::uint64_t>& bitset) {
+    std::vector<std::uint64_t> storage = bitset.release_storage();
+    release_storage(storage);
+}
+
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "../../include/dlplan/core.h"
+
+#include "../utils/threadpool.h"
+
+#include <stdexcept>
+
+
+namespace dlplan::core {
+
+ThreadPoolExecutor::ThreadPoolExecutor(int num_threads)
+    : m_num_threads(num_threads) {
+    if (num_threads < 1) {
+        throw std::runtime_error("ThreadPoolExecutor::ThreadPoolExecutor - number of threads must be positive.");
+    }
+    m_thread_pool = std::make_unique<utils::threadpool::ThreadPool>(num_threads);
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() = default;
+
+void ThreadPoolExecutor::run(const std::vector<std::function<void()>>& tasks) {
+    std::vector<utils::threadpool::ThreadPool::TaskFuture<void>> futures;
+    futures.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        futures.push_back(m_thread_pool->submit(task));
+    }
+    // Wait for all tasks before rethrowing since they refer to the caller's data.
+    std::exception_ptr exception;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!exception) exception = std::current_exception();
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+int ThreadPoolExecutor::get_num_threads() const {
+    return m_num_threads;
+}
+
+}
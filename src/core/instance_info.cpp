@@ -6,6 +6,7 @@
 #include <string>
 #include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 using namespace std::string_literals;
@@ -24,20 +25,115 @@ static std::string compute_atom_name(const Predicate& predicate, const std::vect
     return ss.str();
 }
 
+// The denotations of all static primitives, computed once on first access.
+struct InstanceInfo::StaticDenotations {
+    std::once_flag computed;
+    // Indexed by predicate and then by position.
+    std::vector<std::vector<ConceptDenotation>> concepts;
+    // Indexed by predicate and then by pos_1 * arity + pos_2.
+    std::vector<std::vector<RoleDenotation>> roles;
+};
+
+static const AtomIndices empty_atom_indices;
+
+static void compute_static_denotations(
+    const std::vector<Predicate>& predicates,
+    int num_objects,
+    const std::vector<Atom>& static_atoms,
+    std::vector<std::vector<ConceptDenotation>>& concepts,
+    std::vector<std::vector<RoleDenotation>>& roles) {
+    concepts.resize(predicates.size());
+    roles.resize(predicates.size());
+    for (const auto& predicate : predicates) {
+        int arity = predicate.get_arity();
+        concepts[predicate.get_index()].assign(arity, ConceptDenotation(num_objects));
+        roles[predicate.get_index()].assign(arity * arity, RoleDenotation(num_objects));
+    }
+    // A single pass over the static atoms fills all static primitives.
+    for (const auto& atom : static_atoms) {
+        const auto& object_idxs = atom.get_object_indices();
+        int arity = object_idxs.size();
+        auto& atom_concepts = concepts[atom.get_predicate_index()];
+        auto& atom_roles = roles[atom.get_predicate_index()];
+        for (int pos_1 = 0; pos_1 < arity; ++pos_1) {
+            atom_concepts[pos_1].insert(object_idxs[pos_1]);
+            for (int pos_2 = 0; pos_2 < arity; ++pos_2) {
+                atom_roles[pos_1 * arity + pos_2].insert(std::make_pair(object_idxs[pos_1], object_idxs[pos_2]));
+            }
+        }
+    }
+}
+
 InstanceInfo::InstanceInfo(InstanceIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info)
-    : Base<InstanceInfo>(index), m_vocabulary_info(vocabulary_info) {
+    : Base<InstanceInfo>(index), m_vocabulary_info(vocabulary_info),
+      m_static_denotations(std::make_unique<StaticDenotations>()) {
 }
 
-InstanceInfo::InstanceInfo(const InstanceInfo& other) = default;
+// The static denotations are not copied but recomputed on demand.
+InstanceInfo::InstanceInfo(const InstanceInfo& other)
+    : Base<InstanceInfo>(other),
+      m_vocabulary_info(other.m_vocabulary_info),
+      m_atom_name_to_index(other.m_atom_name_to_index),
+      m_atoms(other.m_atoms),
+      m_static_atom_name_to_index(other.m_static_atom_name_to_index),
+      m_static_atoms(other.m_static_atoms),
+      m_object_name_to_index(other.m_object_name_to_index),
+      m_objects(other.m_objects),
+      m_predicate_to_atom_indices(other.m_predicate_to_atom_indices),
+      m_predicate_to_static_atom_indices(other.m_predicate_to_static_atom_indices),
+      m_static_denotations(std::make_unique<StaticDenotations>()) {
+}
 
-InstanceInfo& InstanceInfo::operator=(const InstanceInfo& other) = default;
+InstanceInfo& InstanceInfo::operator=(const InstanceInfo& other) {
+    if (this != &other) {
+        InstanceInfo copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
 
-InstanceInfo::InstanceInfo(InstanceInfo&& other) = default;
+// The moved-from instance keeps its vocabulary and gets empty static
+// denotations, so that it stays usable.
+InstanceInfo::InstanceInfo(InstanceInfo&& other)
+    : Base<InstanceInfo>(other),
+      m_vocabulary_info(other.m_vocabulary_info),
+      m_atom_name_to_index(std::move(other.m_atom_name_to_index)),
+      m_atoms(std::move(other.m_atoms)),
+      m_static_atom_name_to_index(std::move(other.m_static_atom_name_to_index)),
+      m_static_atoms(std::move(other.m_static_atoms)),
+      m_object_name_to_index(std::move(other.m_object_name_to_index)),
+      m_objects(std::move(other.m_objects)),
+      m_predicate_to_atom_indices(std::move(other.m_predicate_to_atom_indices)),
+      m_predicate_to_static_atom_indices(std::move(other.m_predicate_to_static_atom_indices)),
+      m_static_denotations(std::move(other.m_static_denotations)) {
+    other.clear_static_denotations();
+}
 
-InstanceInfo& InstanceInfo::operator=(InstanceInfo&& other) = default;
+InstanceInfo& InstanceInfo::operator=(InstanceInfo&& other) {
+    if (this != &other) {
+        Base<InstanceInfo>::operator=(other);
+        m_vocabulary_info = other.m_vocabulary_info;
+        m_atom_name_to_index = std::move(other.m_atom_name_to_index);
+        m_atoms = std::move(other.m_atoms);
+        m_static_atom_name_to_index = std::move(other.m_static_atom_name_to_index);
+        m_static_atoms = std::move(other.m_static_atoms);
+        m_object_name_to_index = std::move(other.m_object_name_to_index);
+        m_objects = std::move(other.m_objects);
+        m_predicate_to_atom_indices = std::move(other.m_predicate_to_atom_indices);
+        m_predicate_to_static_atom_indices = std::move(other.m_predicate_to_static_atom_indices);
+        m_static_denotations = std::move(other.m_static_denotations);
+        other.clear_static_denotations();
+    }
+    return *this;
+}
 
 InstanceInfo::~InstanceInfo() = default;
 
+void InstanceInfo::clear_static_denotations() {
+    // A once_flag cannot be reset.
+    m_static_denotations = std::make_unique<StaticDenotations>();
+}
+
 bool InstanceInfo::are_equal_impl(const InstanceInfo& other) const {
     if (this != &other) {
         return (m_atoms == other.m_atoms)
@@ -88,7 +184,12 @@ const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector
         if (!newly_inserted) {
             throw std::runtime_error("InstanceInfo::add_atom - atom with name ("s + atom.get_name() + ") already exists.");
         }
+        if (static_cast<int>(m_predicate_to_static_atom_indices.size()) <= predicate.get_index()) {
+            m_predicate_to_static_atom_indices.resize(predicate.get_index() + 1);
+        }
+        m_predicate_to_static_atom_indices[predicate.get_index()].push_back(atom.get_index());
         m_static_atoms.push_back(std::move(atom));
+        clear_static_denotations();
         return m_static_atoms.back();
     } else {
         Atom atom = Atom(m_atoms.size(), name, predicate.get_index(), object_idxs, is_static);
@@ -97,6 +198,10 @@ const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector
         if (!newly_inserted) {
             return m_atoms[result.first->second];
         }
+        if (static_cast<int>(m_predicate_to_atom_indices.size()) <= predicate.get_index()) {
+            m_predicate_to_atom_indices.resize(predicate.get_index() + 1);
+        }
+        m_predicate_to_atom_indices[predicate.get_index()].push_back(atom.get_index());
         m_atoms.push_back(std::move(atom));
         return m_atoms.back();
     }
@@ -114,6 +219,7 @@ const Atom& InstanceInfo::add_atom(const std::string &predicate_name, const std:
         bool newly_inserted = result.second;
         if (newly_inserted) {
             m_objects.push_back(Object(object_idx, object_name));
+            clear_static_denotations();
         }
         object_idxs.push_back(object_idx);
     }
@@ -128,6 +234,7 @@ const Object& InstanceInfo::add_object(const std::string& object_name) {
         throw std::runtime_error("InstanceInfo::add_object - object with name ("s + object.get_name() + ") already exists.");
     }
     m_objects.push_back(std::move(object));
+    clear_static_denotations();
     return m_objects.back();
 }
 
@@ -186,14 +293,52 @@ const Atom& InstanceInfo::get_atom(const std::string& name) const {
     return m_atoms[m_atom_name_to_index.at(name)];
 }
 
+const AtomIndices& InstanceInfo::get_atom_indices_by_predicate(PredicateIndex predicate_index) const {
+    if (predicate_index >= static_cast<int>(m_predicate_to_atom_indices.size())) {
+        return empty_atom_indices;
+    }
+    return m_predicate_to_atom_indices[predicate_index];
+}
+
+const AtomIndices& InstanceInfo::get_static_atom_indices_by_predicate(PredicateIndex predicate_index) const {
+    if (predicate_index >= static_cast<int>(m_predicate_to_static_atom_indices.size())) {
+        return empty_atom_indices;
+    }
+    return m_predicate_to_static_atom_indices[predicate_index];
+}
+
+const ConceptDenotation& InstanceInfo::get_static_concept_denotation(PredicateIndex predicate_index, int pos) const {
+    std::call_once(m_static_denotations->computed, [this]() {
+        compute_static_denotations(m_vocabulary_info->get_predicates(), m_objects.size(), m_static_atoms, m_static_denotations->concepts, m_static_denotations->roles);
+    });
+    const auto& concepts = m_static_denotations->concepts;
+    assert(dlplan::utils::in_bounds(predicate_index, concepts));
+    assert(dlplan::utils::in_bounds(pos, concepts[predicate_index]));
+    return concepts[predicate_index][pos];
+}
+
+const RoleDenotation& InstanceInfo::get_static_role_denotation(PredicateIndex predicate_index, int pos_1, int pos_2) const {
+    std::call_once(m_static_denotations->computed, [this]() {
+        compute_static_denotations(m_vocabulary_info->get_predicates(), m_objects.size(), m_static_atoms, m_static_denotations->concepts, m_static_denotations->roles);
+    });
+    const auto& roles = m_static_denotations->roles;
+    assert(dlplan::utils::in_bounds(predicate_index, roles));
+    int arity = m_vocabulary_info->get_predicates()[predicate_index].get_arity();
+    assert(pos_1 < arity && pos_2 < arity);
+    return roles[predicate_index][pos_1 * arity + pos_2];
+}
+
 void InstanceInfo::clear_atoms() {
     m_atoms.clear();
     m_atom_name_to_index.clear();
+    m_predicate_to_atom_indices.clear();
 }
 
 void InstanceInfo::clear_static_atoms() {
     m_static_atoms.clear();
     m_static_atom_name_to_index.clear();
+    m_predicate_to_static_atom_indices.clear();
+    clear_static_denotations();
 }
 
 }
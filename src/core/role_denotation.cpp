@@ -1,32 +1,177 @@
+#include "evaluation_workspace.h"
+
 #include "../../include/dlplan/core.h"
+#include "../../include/dlplan/core/elements/utils.h"
 
 #include "../utils/logging.h"
 #include "../../include/dlplan/utils/hash.h"
 #include "../../include/dlplan/utils/dynamic_bitset.h"
 
+#include <algorithm>
+#include <cassert>
+#include <iterator>
 #include <sstream>
 
 
 namespace dlplan::core {
 // we assign index undefined since we do not care
 RoleDenotation::RoleDenotation(int num_objects)
-    : Base<RoleDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_data(DynamicBitset<unsigned>(num_objects * num_objects)) { }
+    : Base<RoleDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_size(0), m_is_dense(false), m_data(0), m_adjacency(nullptr), m_pairwise_distances(nullptr) { }
+
+// The adjacency index and pairwise distances are not copied but rebuilt on demand.
+RoleDenotation::RoleDenotation(const RoleDenotation& other)
+    : Base<RoleDenotation>(other), m_num_objects(other.m_num_objects), m_size(other.m_size), m_is_dense(other.m_is_dense),
+      m_data(other.m_is_dense ? copy_bitset(other.m_data) : DynamicBitset<std::uint64_t>(0)), m_adjacency(nullptr), m_pairwise_distances(nullptr) {
+    if (!other.m_is_dense) {
+        m_positions = make_positions(other.m_positions.size());
+        m_positions.assign(other.m_positions.begin(), other.m_positions.end());
+    }
+}
+
+RoleDenotation& RoleDenotation::operator=(const RoleDenotation& other) {
+    if (this != &other) {
+        Base<RoleDenotation>::operator=(other);
+        m_num_objects = other.m_num_objects;
+        m_size = other.m_size;
+        if (other.m_is_dense) {
+            if (m_is_dense) {
+                m_data = other.m_data;
+            } else {
+                m_data = copy_bitset(other.m_data);
+            }
+            release_positions();
+        } else {
+            release_bitset(m_data);
+            m_positions.clear();
+            reserve_positions(other.m_positions.size());
+            m_positions.assign(other.m_positions.begin(), other.m_positions.end());
+        }
+        m_is_dense = other.m_is_dense;
+        delete m_adjacency.exchange(nullptr);
+        delete m_pairwise_distances.exchange(nullptr);
+    }
+    return *this;
+}
+
+RoleDenotation::RoleDenotation(RoleDenotation&& other)
+    : Base<RoleDenotation>(std::move(other)), m_num_objects(other.m_num_objects), m_size(other.m_size), m_is_dense(other.m_is_dense),
+      m_positions(std::move(other.m_positions)), m_data(std::move(other.m_data)), m_adjacency(other.m_adjacency.exchange(nullptr)),
+      m_pairwise_distances(other.m_pairwise_distances.exchange(nullptr)) { }
+
+RoleDenotation& RoleDenotation::operator=(RoleDenotation&& other) {
+    if (this != &other) {
+        Base<RoleDenotation>::operator=(std::move(other));
+        m_num_objects = other.m_num_objects;
+        m_size = other.m_size;
+        m_is_dense = other.m_is_dense;
+        release_positions();
+        m_positions = std::move(other.m_positions);
+        release_bitset(m_data);
+        m_data = std::move(other.m_data);
+        delete m_adjacency.exchange(other.m_adjacency.exchange(nullptr));
+        delete m_pairwise_distances.exchange(other.m_pairwise_distances.exchange(nullptr));
+    }
+    return *this;
+}
+
+RoleDenotation::~RoleDenotation() {
+    delete m_adjacency.load();
+    delete m_pairwise_distances.load();
+    release_positions();
+    release_bitset(m_data);
+}
+
+void RoleDenotation::assert_unindexed() const {
+    // Interned denotations are immutable, hence the index and distances are never stale.
+    assert(!m_adjacency.load(std::memory_order_relaxed));
+    assert(!m_pairwise_distances.load(std::memory_order_relaxed));
+}
+
+std::size_t RoleDenotation::get_position(const PairOfObjectIndices& value) const {
+    return static_cast<std::size_t>(value.first) * m_num_objects + value.second;
+}
+
+bool RoleDenotation::test(std::size_t position) const {
+    if (m_is_dense) {
+        return m_data.test(position);
+    }
+    return std::binary_search(m_positions.begin(), m_positions.end(), position);
+}
 
-RoleDenotation::RoleDenotation(const RoleDenotation& other) = default;
+std::size_t RoleDenotation::get_max_sparse_size() const {
+    return static_cast<std::size_t>(m_num_objects) * m_num_objects / (8 * sizeof(std::uint64_t));
+}
 
-RoleDenotation& RoleDenotation::operator=(const RoleDenotation& other) = default;
+std::vector<std::uint64_t> RoleDenotation::make_positions(std::size_t num_positions) const {
+    if (EvaluationWorkspace::get_current()) {
+        // Storage for as many positions as the bitset has blocks holds the
+        // maximum sparse size, hence it never grows and is shared with bitsets.
+        return acquire_storage(DynamicBitset<std::uint64_t>::get_num_blocks(static_cast<std::size_t>(m_num_objects) * m_num_objects));
+    }
+    return acquire_storage(num_positions);
+}
 
-RoleDenotation::RoleDenotation(RoleDenotation&& other) = default;
+void RoleDenotation::reserve_positions(std::size_t num_positions) {
+    if (m_positions.capacity() >= num_positions) {
+        return;
+    }
+    std::vector<std::uint64_t> positions = make_positions(std::max(num_positions, 2 * m_positions.capacity()));
+    positions.assign(m_positions.begin(), m_positions.end());
+    release_positions();
+    m_positions = std::move(positions);
+}
 
-RoleDenotation& RoleDenotation::operator=(RoleDenotation&& other) = default;
+void RoleDenotation::release_positions() {
+    release_storage(m_positions);
+}
 
-RoleDenotation::~RoleDenotation() = default;
+void RoleDenotation::to_dense() {
+    m_data = make_bitset(static_cast<std::size_t>(m_num_objects) * m_num_objects);
+    for (std::size_t position : m_positions) {
+        m_data.set(position);
+    }
+    release_positions();
+    m_is_dense = true;
+}
+
+void RoleDenotation::to_sparse() {
+    m_positions.clear();
+    reserve_positions(m_size);
+    for (std::size_t pos = m_data.find_first(); pos != m_data.npos; pos = m_data.find_next(pos)) {
+        m_positions.push_back(pos);
+    }
+    release_bitset(m_data);
+    m_is_dense = false;
+}
+
+void RoleDenotation::update_dense() {
+    m_size = m_data.count();
+    // Switching back at half the maximum size avoids switching back and forth.
+    if (static_cast<std::size_t>(m_size) * 2 <= get_max_sparse_size()) {
+        to_sparse();
+    }
+}
 
 bool RoleDenotation::are_equal_impl(const RoleDenotation& other) const {
-    if (this != &other) {
-        return this->m_data == other.m_data;
+    if (this == &other) {
+        return true;
+    }
+    if (m_num_objects != other.m_num_objects || m_size != other.m_size) {
+        return false;
+    }
+    if (m_is_dense && other.m_is_dense) {
+        return m_data == other.m_data;
+    }
+    if (!m_is_dense && !other.m_is_dense) {
+        return m_positions == other.m_positions;
     }
-    return true;
+    // Both have the same number of pairs, hence they are equal
+    // iff all pairs of the sparse one are in the dense one.
+    const RoleDenotation& sparse = m_is_dense ? other : *this;
+    const RoleDenotation& dense = m_is_dense ? *this : other;
+    return std::all_of(sparse.m_positions.begin(), sparse.m_positions.end(), [&](std::size_t position) {
+        return dense.m_data.test(position);
+    });
 }
 
 void RoleDenotation::str_impl(std::stringstream& out) const {
@@ -37,59 +182,198 @@ void RoleDenotation::str_impl(std::stringstream& out) const {
 }
 
 std::size_t RoleDenotation::hash_impl() const {
-    return m_data.hash();
+    // Combines the positions in ascending order in both representations.
+    std::size_t seed = 0;
+    if (m_is_dense) {
+        for (std::size_t pos = m_data.find_first(); pos != m_data.npos; pos = m_data.find_next(pos)) {
+            hash_combine(seed, pos);
+        }
+    } else {
+        for (std::size_t pos : m_positions) {
+            hash_combine(seed, pos);
+        }
+    }
+    return seed;
 }
 
 RoleDenotation& RoleDenotation::operator&=(const RoleDenotation& other) {
-    m_data &= other.m_data;
+    assert_unindexed();
+    if (!m_is_dense) {
+        std::erase_if(m_positions, [&](std::size_t position) { return !other.test(position); });
+        m_size = m_positions.size();
+    } else if (!other.m_is_dense) {
+        // The intersection is at most as large as other, hence sparse.
+        m_positions.clear();
+        reserve_positions(other.m_size);
+        for (std::size_t position : other.m_positions) {
+            if (m_data.test(position)) {
+                m_positions.push_back(position);
+            }
+        }
+        release_bitset(m_data);
+        m_size = m_positions.size();
+        m_is_dense = false;
+    } else {
+        m_data &= other.m_data;
+        update_dense();
+    }
     return *this;
 }
 
 RoleDenotation& RoleDenotation::operator|=(const RoleDenotation& other) {
-    m_data |= other.m_data;
+    assert_unindexed();
+    // The union of two sparse denotations stays sparse if it cannot exceed the maximum sparse size.
+    if (!m_is_dense && !other.m_is_dense
+        && static_cast<std::size_t>(m_size + other.m_size) <= get_max_sparse_size()) {
+        std::vector<std::uint64_t> positions = make_positions(m_size + other.m_size);
+        std::set_union(m_positions.begin(), m_positions.end(), other.m_positions.begin(), other.m_positions.end(), std::back_inserter(positions));
+        release_positions();
+        m_positions = std::move(positions);
+        m_size = m_positions.size();
+        return *this;
+    }
+    if (!m_is_dense) {
+        to_dense();
+    }
+    if (other.m_is_dense) {
+        m_data |= other.m_data;
+    } else {
+        for (std::size_t position : other.m_positions) {
+            m_data.set(position);
+        }
+    }
+    update_dense();
     return *this;
 }
 
 RoleDenotation& RoleDenotation::operator-=(const RoleDenotation& other) {
-    m_data -= other.m_data;
+    assert_unindexed();
+    if (!m_is_dense) {
+        std::erase_if(m_positions, [&](std::size_t position) { return other.test(position); });
+        m_size = m_positions.size();
+        return *this;
+    }
+    if (other.m_is_dense) {
+        m_data -= other.m_data;
+    } else {
+        for (std::size_t position : other.m_positions) {
+            m_data.reset(position);
+        }
+    }
+    update_dense();
     return *this;
 }
 
 RoleDenotation& RoleDenotation::operator~() {
+    assert_unindexed();
+    if (!m_is_dense) {
+        to_dense();
+    }
     ~m_data;
+    update_dense();
     return *this;
 }
 
 void RoleDenotation::set() {
+    assert_unindexed();
+    if (!m_is_dense) {
+        to_dense();
+    }
     m_data.set();
+    update_dense();
+}
+
+void RoleDenotation::clear() {
+    assert_unindexed();
+    // Keeps the representation such that reused denotations do not reallocate.
+    if (m_is_dense) {
+        m_data.reset();
+    } else {
+        m_positions.clear();
+    }
+    m_size = 0;
 }
 
 bool RoleDenotation::contains(const PairOfObjectIndices& value) const {
-    return m_data.test(value.first * m_num_objects + value.second);
+    return test(get_position(value));
 }
 
 void RoleDenotation::insert(const PairOfObjectIndices& value) {
-    return m_data.set(value.first * m_num_objects + value.second);
+    assert_unindexed();
+    const std::size_t position = get_position(value);
+    if (!m_is_dense) {
+        auto it = std::lower_bound(m_positions.begin(), m_positions.end(), position);
+        if (it != m_positions.end() && *it == position) {
+            return;
+        }
+        // Inserting before many larger positions is expensive, in which case
+        // switching to the bitset bounds the cost of later insertions. Lists of
+        // at most half the maximum size stay sparse as in update_dense.
+        // Lists never exceed the maximum size, which bounds their storage.
+        if (static_cast<std::size_t>(m_size + 1) <= get_max_sparse_size()
+            && (m_positions.end() - it <= m_num_objects
+                || static_cast<std::size_t>(m_size + 1) * 2 <= get_max_sparse_size())) {
+            const auto index = it - m_positions.begin();
+            reserve_positions(m_size + 1);
+            m_positions.insert(m_positions.begin() + index, position);
+            ++m_size;
+            return;
+        }
+        to_dense();
+    }
+    if (!m_data.test(position)) {
+        m_data.set(position);
+        ++m_size;
+    }
 }
 
 void RoleDenotation::erase(const PairOfObjectIndices& value) {
-    return m_data.reset(value.first * m_num_objects + value.second);
+    assert_unindexed();
+    const std::size_t position = get_position(value);
+    if (!m_is_dense) {
+        auto it = std::lower_bound(m_positions.begin(), m_positions.end(), position);
+        if (it != m_positions.end() && *it == position) {
+            m_positions.erase(it);
+            --m_size;
+        }
+    } else if (m_data.test(position)) {
+        m_data.reset(position);
+        --m_size;
+        if (static_cast<std::size_t>(m_size) * 2 <= get_max_sparse_size()) {
+            to_sparse();
+        }
+    }
 }
 
 int RoleDenotation::size() const {
-    return m_data.count();
+    return m_size;
 }
 
 bool RoleDenotation::empty() const {
-    return m_data.none();
+    return m_size == 0;
 }
 
 bool RoleDenotation::intersects(const RoleDenotation& other) const {
-    return m_data.intersects(other.m_data);
+    if (m_is_dense && other.m_is_dense) {
+        return m_data.intersects(other.m_data);
+    }
+    const RoleDenotation& sparse = m_is_dense ? other : *this;
+    const RoleDenotation& remaining = m_is_dense ? *this : other;
+    return std::any_of(sparse.m_positions.begin(), sparse.m_positions.end(), [&](std::size_t position) {
+        return remaining.test(position);
+    });
 }
 
 bool RoleDenotation::is_subset_of(const RoleDenotation& other) const {
-    return m_data.is_subset_of(other.m_data);
+    if (m_size > other.m_size) {
+        return false;
+    }
+    if (m_is_dense && other.m_is_dense) {
+        return m_data.is_subset_of(other.m_data);
+    }
+    return !any_of([&](ObjectIndex first, ObjectIndex second) {
+        return !other.contains(std::make_pair(first, second));
+    });
 }
 
 PairsOfObjectIndices RoleDenotation::to_vector() const {
@@ -99,21 +383,105 @@ PairsOfObjectIndices RoleDenotation::to_vector() const {
 
 PairsOfObjectIndices RoleDenotation::to_sorted_vector() const {
     PairsOfObjectIndices result;
-    result.reserve(m_num_objects * m_num_objects);
-    for (ObjectIndex i = 0; i < m_num_objects; ++i) {
-        int offset = m_num_objects * i;
-        for (ObjectIndex j = 0; j < m_num_objects; ++j) {
-            if (m_data.test(offset + j)) {
-                result.emplace_back(i, j);
-            }
+    result.reserve(size());
+    for_each([&](ObjectIndex i, ObjectIndex j) { result.emplace_back(i, j); });
+    return result;
+}
+
+const RoleAdjacency& RoleDenotation::get_adjacency() const {
+    const RoleAdjacency* adjacency = m_adjacency.load(std::memory_order_acquire);
+    if (!adjacency) {
+        const RoleAdjacency* expected = nullptr;
+        const RoleAdjacency* built = new RoleAdjacency(*this);
+        if (m_adjacency.compare_exchange_strong(expected, built, std::memory_order_acq_rel)) {
+            adjacency = built;
+        } else {
+            // Another thread built the index first.
+            delete built;
+            adjacency = expected;
         }
     }
-    result.shrink_to_fit();
-    return result;
+    return *adjacency;
+}
+
+const PairwiseDistances& RoleDenotation::get_pairwise_distances() const {
+    const PairwiseDistances* distances = m_pairwise_distances.load(std::memory_order_acquire);
+    if (!distances) {
+        const PairwiseDistances* expected = nullptr;
+        const PairwiseDistances* computed = new PairwiseDistances(*this);
+        if (m_pairwise_distances.compare_exchange_strong(expected, computed, std::memory_order_acq_rel)) {
+            distances = computed;
+        } else {
+            // Another thread computed the distances first.
+            delete computed;
+            distances = expected;
+        }
+    }
+    return *distances;
+}
+
+bool RoleDenotation::has_pairwise_distances() const {
+    return m_pairwise_distances.load(std::memory_order_acquire) != nullptr;
+}
+
+bool RoleDenotation::is_dense() const {
+    return m_is_dense;
 }
 
 int RoleDenotation::get_num_objects() const {
     return m_num_objects;
 }
 
+
+RoleAdjacency::RoleAdjacency()
+    : m_successor_offsets(1, 0),
+      m_predecessor_offsets(1, 0) { }
+
+RoleAdjacency::RoleAdjacency(const RoleDenotation& denotation) {
+    compute(denotation);
+}
+
+void RoleAdjacency::compute(const RoleDenotation& denotation) {
+    const int num_objects = denotation.get_num_objects();
+    m_successor_offsets.assign(num_objects + 1, 0);
+    m_predecessor_offsets.assign(num_objects + 1, 0);
+    denotation.for_each([&](ObjectIndex first, ObjectIndex second) {
+        ++m_successor_offsets[first + 1];
+        ++m_predecessor_offsets[second + 1];
+    });
+    for (int i = 0; i < num_objects; ++i) {
+        m_successor_offsets[i + 1] += m_successor_offsets[i];
+        m_predecessor_offsets[i + 1] += m_predecessor_offsets[i];
+    }
+    m_successors.resize(m_successor_offsets.back());
+    m_predecessors.resize(m_predecessor_offsets.back());
+    // Pairs are visited in ascending order, hence both lists end up sorted.
+    // Placing advances the offset of each object to the end of its range,
+    // i.e., to the start of the next range, which the shift below undoes.
+    denotation.for_each([&](ObjectIndex first, ObjectIndex second) {
+        m_successors[m_successor_offsets[first]++] = second;
+        m_predecessors[m_predecessor_offsets[second]++] = first;
+    });
+    for (int i = num_objects; i > 0; --i) {
+        m_successor_offsets[i] = m_successor_offsets[i - 1];
+        m_predecessor_offsets[i] = m_predecessor_offsets[i - 1];
+    }
+    m_successor_offsets[0] = 0;
+    m_predecessor_offsets[0] = 0;
+}
+
+std::span<const ObjectIndex> RoleAdjacency::get_successors(ObjectIndex object) const {
+    return std::span<const ObjectIndex>(m_successors).subspan(
+        m_successor_offsets[object], m_successor_offsets[object + 1] - m_successor_offsets[object]);
+}
+
+std::span<const ObjectIndex> RoleAdjacency::get_predecessors(ObjectIndex object) const {
+    return std::span<const ObjectIndex>(m_predecessors).subspan(
+        m_predecessor_offsets[object], m_predecessor_offsets[object + 1] - m_predecessor_offsets[object]);
+}
+
+int RoleAdjacency::get_num_objects() const {
+    return static_cast<int>(m_successor_offsets.size()) - 1;
+}
+
 }
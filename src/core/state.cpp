@@ -11,6 +11,11 @@
 
 namespace dlplan::core {
 
+struct State::PredicateAtomIndices {
+    std::vector<int> offsets;
+    AtomIndices atom_indices;
+};
+
 static AtomIndices sort_atom_idxs(AtomIndices&& atom_idxs) {
     std::sort(atom_idxs.begin(), atom_idxs.end());
     return atom_idxs;
@@ -50,13 +55,33 @@ State::State(StateIndex index, std::shared_ptr<InstanceInfo> instance_info, Atom
 }
 
 
-State::State(const State&) = default;
+State::State(const State& other)
+    : Base<State>(other), m_instance_info(other.m_instance_info), m_atom_indices(other.m_atom_indices),
+      m_predicate_atom_indices(other.m_predicate_atom_indices.load()) { }
 
-State& State::operator=(const State&) = default;
+State& State::operator=(const State& other) {
+    if (this != &other) {
+        Base<State>::operator=(other);
+        m_instance_info = other.m_instance_info;
+        m_atom_indices = other.m_atom_indices;
+        m_predicate_atom_indices.store(other.m_predicate_atom_indices.load());
+    }
+    return *this;
+}
 
-State::State(State&& other) = default;
+State::State(State&& other)
+    : Base<State>(std::move(other)), m_instance_info(std::move(other.m_instance_info)), m_atom_indices(std::move(other.m_atom_indices)),
+      m_predicate_atom_indices(other.m_predicate_atom_indices.exchange(nullptr)) { }
 
-State& State::operator=(State&& other) = default;
+State& State::operator=(State&& other) {
+    if (this != &other) {
+        Base<State>::operator=(std::move(other));
+        m_instance_info = std::move(other.m_instance_info);
+        m_atom_indices = std::move(other.m_atom_indices);
+        m_predicate_atom_indices.store(other.m_predicate_atom_indices.exchange(nullptr));
+    }
+    return *this;
+}
 
 State::~State() = default;
 
@@ -93,4 +118,38 @@ const AtomIndices& State::get_atom_indices() const {
     return m_atom_indices;
 }
 
+std::span<const AtomIndex> State::get_atom_indices_by_predicate(PredicateIndex predicate_index) const {
+    auto predicate_atom_indices = m_predicate_atom_indices.load();
+    if (!predicate_atom_indices) {
+        // Group all atoms by predicate in a single pass with a counting sort.
+        const auto& atoms = m_instance_info->get_atoms();
+        auto built = std::make_shared<PredicateAtomIndices>();
+        built->offsets.resize(m_instance_info->get_vocabulary_info()->get_predicates().size() + 1, 0);
+        for (int atom_idx : m_atom_indices) {
+            ++built->offsets[atoms[atom_idx].get_predicate_index() + 1];
+        }
+        for (size_t i = 1; i < built->offsets.size(); ++i) {
+            built->offsets[i] += built->offsets[i - 1];
+        }
+        built->atom_indices.resize(m_atom_indices.size());
+        std::vector<int> positions(built->offsets.begin(), built->offsets.end() - 1);
+        for (int atom_idx : m_atom_indices) {
+            built->atom_indices[positions[atoms[atom_idx].get_predicate_index()]++] = atom_idx;
+        }
+        std::shared_ptr<const PredicateAtomIndices> expected;
+        if (m_predicate_atom_indices.compare_exchange_strong(expected, built)) {
+            predicate_atom_indices = std::move(built);
+        } else {
+            // Another thread grouped the atoms first.
+            predicate_atom_indices = std::move(expected);
+        }
+    }
+    const auto& offsets = predicate_atom_indices->offsets;
+    if (predicate_index + 1 >= static_cast<int>(offsets.size())) {
+        return {};
+    }
+    return std::span<const AtomIndex>(predicate_atom_indices->atom_indices).subspan(
+        offsets[predicate_index], offsets[predicate_index + 1] - offsets[predicate_index]);
+}
+
 }
@@ -0,0 +1,122 @@
+#include "../../include/dlplan/core.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+
+namespace dlplan::core {
+
+static thread_local const StateTransition* current_transition = nullptr;
+
+static AtomIndices compute_difference(const AtomIndices& left, const AtomIndices& right) {
+    AtomIndices result;
+    std::set_difference(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(result));
+    return result;
+}
+
+static AtomIndices sorted_unique(AtomIndices atom_indices) {
+    std::sort(atom_indices.begin(), atom_indices.end());
+    atom_indices.erase(std::unique(atom_indices.begin(), atom_indices.end()), atom_indices.end());
+    return atom_indices;
+}
+
+static State apply(const State& parent_state, StateIndex index, const AtomIndices& add_atom_indices, const AtomIndices& delete_atom_indices) {
+    AtomIndices atom_indices = compute_difference(parent_state.get_atom_indices(), sorted_unique(delete_atom_indices));
+    AtomIndices result;
+    std::set_union(atom_indices.begin(), atom_indices.end(), add_atom_indices.begin(), add_atom_indices.end(), std::back_inserter(result));
+    return State(index, parent_state.get_instance_info(), std::move(result));
+}
+
+StateTransition::StateTransition(const State& parent_state, const State& state)
+    : m_parent_state(parent_state), m_state(state),
+      m_add_atom_indices(compute_difference(state.get_atom_indices(), parent_state.get_atom_indices())),
+      m_delete_atom_indices(compute_difference(parent_state.get_atom_indices(), state.get_atom_indices())) {
+    if (parent_state.get_instance_info() != state.get_instance_info()) {
+        throw std::runtime_error("StateTransition::StateTransition - states must belong to the same instance.");
+    }
+    if (parent_state.get_index() == state.get_index()) {
+        throw std::runtime_error("StateTransition::StateTransition - states must have different indices.");
+    }
+    compute_changed_predicate_indices();
+}
+
+StateTransition::StateTransition(const State& parent_state, StateIndex index, const AtomIndices& add_atom_indices, const AtomIndices& delete_atom_indices)
+    : StateTransition(parent_state, apply(parent_state, index, sorted_unique(add_atom_indices), delete_atom_indices)) { }
+
+StateTransition::StateTransition(const StateTransition& other) = default;
+
+StateTransition& StateTransition::operator=(const StateTransition& other) = default;
+
+StateTransition::StateTransition(StateTransition&& other) = default;
+
+StateTransition& StateTransition::operator=(StateTransition&& other) = default;
+
+StateTransition::~StateTransition() = default;
+
+void StateTransition::compute_changed_predicate_indices() {
+    const auto& atoms = m_state.get_instance_info()->get_atoms();
+    for (const auto* atom_indices : { &m_add_atom_indices, &m_delete_atom_indices }) {
+        for (AtomIndex atom_idx : *atom_indices) {
+            m_changed_predicate_indices.push_back(atoms[atom_idx].get_predicate_index());
+        }
+    }
+    std::sort(m_changed_predicate_indices.begin(), m_changed_predicate_indices.end());
+    m_changed_predicate_indices.erase(std::unique(m_changed_predicate_indices.begin(), m_changed_predicate_indices.end()), m_changed_predicate_indices.end());
+}
+
+bool StateTransition::is_changed(const std::vector<PredicateIndex>& predicate_indices) const {
+    auto it_1 = predicate_indices.begin();
+    auto it_2 = m_changed_predicate_indices.begin();
+    while (it_1 != predicate_indices.end() && it_2 != m_changed_predicate_indices.end()) {
+        if (*it_1 < *it_2) {
+            ++it_1;
+        } else if (*it_2 < *it_1) {
+            ++it_2;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+const State& StateTransition::get_parent_state() const {
+    return m_parent_state;
+}
+
+const State& StateTransition::get_state() const {
+    return m_state;
+}
+
+const AtomIndices& StateTransition::get_add_atom_indices() const {
+    return m_add_atom_indices;
+}
+
+const AtomIndices& StateTransition::get_delete_atom_indices() const {
+    return m_delete_atom_indices;
+}
+
+const std::vector<PredicateIndex>& StateTransition::get_changed_predicate_indices() const {
+    return m_changed_predicate_indices;
+}
+
+StateTransition::Activation::Activation(const StateTransition& transition)
+    : m_previous(current_transition) {
+    current_transition = &transition;
+}
+
+StateTransition::Activation::~Activation() {
+    current_transition = m_previous;
+}
+
+const StateTransition* StateTransition::get_current(const State& state) {
+    const StateTransition* transition = current_transition;
+    if (transition
+        && transition->m_state.get_index() == state.get_index()
+        && transition->m_state.get_instance_info() == state.get_instance_info()) {
+        return transition;
+    }
+    return nullptr;
+}
+
+}
@@ -0,0 +1,177 @@
+#include "checkpoint.h"
+
+#include "../utils/MurmurHash3.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+
+namespace dlplan::generator {
+
+static const char checkpoint_magic[8] = { 'D', 'L', 'P', 'G', 'E', 'N', 'C', 'P' };
+static const std::uint32_t checkpoint_version = 1;
+
+// Integers are written in little-endian byte order independent of the platform.
+static void write_uint64(std::ostream& out, std::uint64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+    out.write(bytes, 8);
+}
+
+static std::uint64_t read_uint64(std::istream& in) {
+    unsigned char bytes[8];
+    if (!in.read(reinterpret_cast<char*>(bytes), 8)) {
+        throw std::runtime_error("Checkpoint::read - unexpected end of input.");
+    }
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+static void write_int(std::ostream& out, int value) {
+    write_uint64(out, static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+}
+
+static int read_int(std::istream& in) {
+    return static_cast<int>(static_cast<std::int64_t>(read_uint64(in)));
+}
+
+/// @brief Reads a size and checks it against a bound to fail early on corrupt input.
+static std::size_t read_size(std::istream& in, std::uint64_t max_size) {
+    std::uint64_t size = read_uint64(in);
+    if (size > max_size) {
+        throw std::runtime_error("Checkpoint::read - invalid size " + std::to_string(size) + ".");
+    }
+    return static_cast<std::size_t>(size);
+}
+
+static void write_string(std::ostream& out, const std::string& str) {
+    write_uint64(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+static std::string read_string(std::istream& in) {
+    std::string str(read_size(in, 1 << 24), '\0');
+    if (!in.read(str.data(), str.size())) {
+        throw std::runtime_error("Checkpoint::read - unexpected end of input.");
+    }
+    return str;
+}
+
+void Checkpoint::write(std::ostream& out) const {
+    out.write(checkpoint_magic, sizeof(checkpoint_magic));
+    write_uint64(out, checkpoint_version);
+    write_uint64(out, states_hash);
+    for (int limit : complexity_limits) {
+        write_int(out, limit);
+    }
+    write_uint64(out, enabled_rules.size());
+    for (bool enabled : enabled_rules) {
+        write_uint64(out, enabled);
+    }
+    write_int(out, num_sample_states);
+    write_uint64(out, layers.size());
+    for (const auto& layer : layers) {
+        for (const auto& features : layer.features) {
+            write_uint64(out, features.size());
+            for (const auto& feature : features) {
+                write_string(out, feature.first);
+                write_uint64(out, feature.second.low);
+                write_uint64(out, feature.second.high);
+            }
+        }
+        write_uint64(out, layer.rule_counts.size());
+        for (int count : layer.rule_counts) {
+            write_int(out, count);
+        }
+    }
+}
+
+Checkpoint Checkpoint::read(std::istream& in) {
+    char magic[sizeof(checkpoint_magic)];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), checkpoint_magic)) {
+        throw std::runtime_error("Checkpoint::read - input is not a feature generator checkpoint.");
+    }
+    std::uint64_t version = read_uint64(in);
+    if (version != checkpoint_version) {
+        throw std::runtime_error("Checkpoint::read - unsupported version " + std::to_string(version) + ".");
+    }
+    Checkpoint checkpoint;
+    checkpoint.states_hash = read_uint64(in);
+    for (int& limit : checkpoint.complexity_limits) {
+        limit = read_int(in);
+    }
+    checkpoint.enabled_rules.resize(read_size(in, 1 << 10));
+    for (std::size_t i = 0; i < checkpoint.enabled_rules.size(); ++i) {
+        checkpoint.enabled_rules[i] = read_uint64(in);
+    }
+    checkpoint.num_sample_states = read_int(in);
+    checkpoint.layers.resize(read_size(in, 1 << 10));
+    for (auto& layer : checkpoint.layers) {
+        for (auto& features : layer.features) {
+            std::size_t num_features = read_size(in, 1 << 30);
+            for (std::size_t i = 0; i < num_features; ++i) {
+                std::string repr = read_string(in);
+                Fingerprint fingerprint;
+                fingerprint.low = read_uint64(in);
+                fingerprint.high = read_uint64(in);
+                features.emplace_back(std::move(repr), fingerprint);
+            }
+        }
+        layer.rule_counts.resize(read_size(in, 1 << 10));
+        for (int& count : layer.rule_counts) {
+            count = read_int(in);
+        }
+    }
+    return checkpoint;
+}
+
+static void append_uint64(std::string& data, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        data.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+// The length prefix keeps concatenations of different names apart.
+static void append_string(std::string& data, const std::string& value) {
+    append_uint64(data, value.size());
+    data += value;
+}
+
+std::uint64_t compute_states_hash(const core::States& states) {
+    std::string data;
+    if (!states.empty()) {
+        for (const auto& predicate : states.front().get_instance_info()->get_vocabulary_info()->get_predicates()) {
+            append_string(data, predicate.get_name());
+            append_uint64(data, predicate.get_arity());
+            append_uint64(data, predicate.is_static());
+        }
+    }
+    std::unordered_set<const core::InstanceInfo*> instances;
+    for (const auto& state : states) {
+        const auto& instance = *state.get_instance_info();
+        append_uint64(data, instance.get_index());
+        if (instances.insert(&instance).second) {
+            // Static atoms are part of all states of the instance.
+            append_uint64(data, instance.get_static_atoms().size());
+            for (const auto& atom : instance.get_static_atoms()) {
+                append_string(data, atom.get_name());
+            }
+        }
+        append_uint64(data, state.get_index());
+        append_uint64(data, state.get_atom_indices().size());
+        for (core::AtomIndex atom_index : state.get_atom_indices()) {
+            append_string(data, instance.get_atoms()[atom_index].get_name());
+        }
+    }
+    std::uint64_t out[2];
+    MurmurHash3_x64_128(data.data(), static_cast<int>(data.size()), 0, out);
+    return out[0];
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef DLPLAN_SRC_GENERATOR_CHECKPOINT_H_
+#define DLPLAN_SRC_GENERATOR_CHECKPOINT_H_
+
+#include "generator_data.h"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace dlplan::generator {
+
+/// @brief Generated features of one complexity with their fingerprints
+///        and the number of features generated by each rule so far.
+struct CheckpointLayer {
+    // Booleans, numericals, concepts, and roles in the order of generation.
+    std::array<std::vector<std::pair<std::string, Fingerprint>>, 4> features;
+    std::vector<int> rule_counts;
+};
+
+/// @brief The completed complexities of a feature generation. Layer i
+///        contains the features of complexity i + 1.
+struct Checkpoint {
+    // Identifies the states that the features were generated on.
+    std::uint64_t states_hash = 0;
+    // Concept, role, boolean, count numerical, and distance numerical limits.
+    std::array<int, 5> complexity_limits{};
+    std::vector<bool> enabled_rules;
+    // Fingerprints are computed on this many sample states if positive.
+    int num_sample_states = 0;
+    std::vector<CheckpointLayer> layers;
+
+    /// @brief Writes the checkpoint in a binary format.
+    void write(std::ostream& out) const;
+
+    /// @brief Reads a checkpoint written by write.
+    ///        Throws std::runtime_error if the input is not a checkpoint.
+    static Checkpoint read(std::istream& in);
+};
+
+/// @brief Returns a hash of the vocabulary, the instances with their static
+///        atoms, and the indices and atom names of the states.
+extern std::uint64_t compute_states_hash(const core::States& states);
+
+}
+
+#endif
@@ -1,11 +1,15 @@
 #include "feature_generator.h"
 
+#include "checkpoint.h"
 #include "generator_data.h"
 #include "../utils/logging.h"
 #include "../../include/dlplan/core.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <csignal>
 
 
@@ -46,7 +50,11 @@ FeatureGeneratorImpl::FeatureGeneratorImpl()
       r_til_c(std::make_shared<rules::TilCRole>()),
       r_compose(std::make_shared<rules::ComposeRole>()),
       r_transitive_closure(std::make_shared<rules::TransitiveClosureRole>()),
-      r_transitive_reflexive_closure(std::make_shared<rules::TransitiveReflexiveClosureRole>()) {
+      r_transitive_reflexive_closure(std::make_shared<rules::TransitiveReflexiveClosureRole>()),
+      m_executor(nullptr),
+      m_num_sample_states(0),
+      m_prune_comparable_operands(true),
+      m_checkpoint_filename() {
     m_primitive_rules.emplace_back(b_nullary);
     m_primitive_rules.emplace_back(c_one_of);
     m_primitive_rules.emplace_back(c_top);
@@ -104,8 +112,6 @@ GeneratedFeatures FeatureGeneratorImpl::generate(
     int distance_numerical_complexity_limit,
     int time_limit,
     int feature_limit) {
-    // Allow termination with ctrl+c
-    auto pre_sigint_handler = std::signal(SIGINT, exit_sigint_handler);
     // Initialize statistics in each rule.
     for (auto& r : m_primitive_rules) r->initialize();
     for (auto& r : m_concept_inductive_rules) r->initialize();
@@ -113,11 +119,25 @@ GeneratedFeatures FeatureGeneratorImpl::generate(
     for (auto& r : m_boolean_inductive_rules) r->initialize();
     for (auto& r : m_numerical_inductive_rules) r->initialize();
     // Initialize memory to store intermediate results.
-    GeneratorData data(factory, std::max({concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit}), time_limit, feature_limit);
-    // Initialize cache.
-    core::DenotationsCaches caches;
-    generate_base(states, data, caches);
-    generate_inductively(states, concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit, data, caches);
+    GeneratorData data(factory, m_executor, m_prune_comparable_operands, std::max({concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit}), time_limit, feature_limit);
+    // Initialize cache, tasks of the executor share it.
+    core::DenotationsCaches caches(m_executor ? 64 : 1);
+    data.initialize_sample(states, m_num_sample_states, caches.is_thread_safe());
+    // Initialize checkpoint, completed complexities are restored from the checkpoint file.
+    Checkpoint checkpoint;
+    checkpoint.states_hash = compute_states_hash(states);
+    checkpoint.complexity_limits = { concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit };
+    for (const auto& rule : get_rules()) checkpoint.enabled_rules.push_back(rule->is_enabled());
+    checkpoint.num_sample_states = m_num_sample_states;
+    if (!m_checkpoint_filename.empty()) {
+        restore_checkpoint(checkpoint, states, data, caches);
+    }
+    // Allow termination with ctrl+c
+    auto pre_sigint_handler = std::signal(SIGINT, exit_sigint_handler);
+    if (checkpoint.layers.empty()) {
+        generate_base(states, data, caches, checkpoint);
+    }
+    generate_inductively(states, concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit, data, caches, checkpoint);
     // Restore previous sigint handler
     std::signal(SIGINT, pre_sigint_handler);
     return data.m_generated_features;
@@ -126,7 +146,8 @@ GeneratedFeatures FeatureGeneratorImpl::generate(
 void FeatureGeneratorImpl::generate_base(
     const core::States& states,
     GeneratorData& data,
-    core::DenotationsCaches& caches) {
+    core::DenotationsCaches& caches,
+    Checkpoint& checkpoint) {
     utils::g_log << "Started generating base features of complexity 1." << std::endl;
     for (const auto& rule : m_primitive_rules) {
         if (data.reached_resource_limit()) break;
@@ -134,6 +155,10 @@ void FeatureGeneratorImpl::generate_base(
     }
     utils::g_log << "Complexity " << 1 << ":" << std::endl;
     print_statistics();
+    // All rules ran if the limit is not reached afterwards.
+    if (!data.reached_resource_limit()) {
+        save_checkpoint(checkpoint, 1, data);
+    }
     utils::g_log << "Finished generating base features." << std::endl;
 }
 
@@ -145,10 +170,12 @@ void FeatureGeneratorImpl::generate_inductively(
     int count_numerical_complexity_limit,
     int distance_numerical_complexity_limit,
     GeneratorData& data,
-    core::DenotationsCaches& caches) {
+    core::DenotationsCaches& caches,
+    Checkpoint& checkpoint) {
     utils::g_log << "Started generating composite features. " << std::endl;
     int max_complexity = std::max({concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit});
-    for (int target_complexity = 2; target_complexity <= max_complexity; ++target_complexity) {  // every composition adds at least one complexity
+    int first_complexity = std::max(2, static_cast<int>(checkpoint.layers.size()) + 1);
+    for (int target_complexity = first_complexity; target_complexity <= max_complexity; ++target_complexity) {  // every composition adds at least one complexity
         if (target_complexity <= concept_complexity_limit) {
             if (data.reached_resource_limit()) break;
             for (const auto& rule : m_concept_inductive_rules) {
@@ -181,10 +208,131 @@ void FeatureGeneratorImpl::generate_inductively(
         utils::g_log << "Complexity " << target_complexity << ":" << std::endl;
         data.print_statistics();
         print_statistics();
+        if (!data.reached_resource_limit()) {
+            save_checkpoint(checkpoint, target_complexity, data);
+        }
     }
     utils::g_log << "Finished generating composite features." << std::endl;
 }
 
+std::vector<Rule_Ptr> FeatureGeneratorImpl::get_rules() const {
+    std::vector<Rule_Ptr> rules;
+    rules.insert(rules.end(), m_primitive_rules.begin(), m_primitive_rules.end());
+    rules.insert(rules.end(), m_concept_inductive_rules.begin(), m_concept_inductive_rules.end());
+    rules.insert(rules.end(), m_role_inductive_rules.begin(), m_role_inductive_rules.end());
+    rules.insert(rules.end(), m_boolean_inductive_rules.begin(), m_boolean_inductive_rules.end());
+    rules.insert(rules.end(), m_numerical_inductive_rules.begin(), m_numerical_inductive_rules.end());
+    return rules;
+}
+
+template<typename Element>
+static void add_layer_features(
+    std::vector<std::pair<std::string, Fingerprint>>& features,
+    const std::vector<std::shared_ptr<const Element>>& elements,
+    const FingerprintTable<Element>& hash_table) {
+    std::unordered_map<const Element*, Fingerprint> fingerprints;
+    for (const auto& entry : hash_table) {
+        fingerprints.emplace(entry.second.get(), entry.first);
+    }
+    for (const auto& element : elements) {
+        features.emplace_back(element->str(), fingerprints.at(element.get()));
+    }
+}
+
+static CheckpointLayer make_checkpoint_layer(int complexity, const GeneratorData& data, const std::vector<Rule_Ptr>& rules) {
+    CheckpointLayer layer;
+    add_layer_features(layer.features[0], data.m_booleans_by_iteration[complexity], data.m_boolean_hash_table);
+    add_layer_features(layer.features[1], data.m_numericals_by_iteration[complexity], data.m_numerical_hash_table);
+    add_layer_features(layer.features[2], data.m_concepts_by_iteration[complexity], data.m_concept_hash_table);
+    add_layer_features(layer.features[3], data.m_roles_by_iteration[complexity], data.m_role_hash_table);
+    for (const auto& rule : rules) {
+        layer.rule_counts.push_back(rule->get_count());
+    }
+    return layer;
+}
+
+void FeatureGeneratorImpl::save_checkpoint(
+    Checkpoint& checkpoint,
+    int complexity,
+    const GeneratorData& data) const {
+    if (m_checkpoint_filename.empty()) {
+        return;
+    }
+    checkpoint.layers.push_back(make_checkpoint_layer(complexity, data, get_rules()));
+    // Replace the checkpoint file only after the new checkpoint is complete.
+    const std::string tmp_filename = m_checkpoint_filename + ".tmp";
+    {
+        std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+        checkpoint.write(out);
+        if (!out) {
+            throw std::runtime_error("FeatureGeneratorImpl::save_checkpoint - failed to write " + tmp_filename + ".");
+        }
+    }
+    if (std::rename(tmp_filename.c_str(), m_checkpoint_filename.c_str()) != 0) {
+        throw std::runtime_error("FeatureGeneratorImpl::save_checkpoint - failed to replace " + m_checkpoint_filename + ".");
+    }
+    utils::g_log << "Saved checkpoint with complexities up to " << complexity << "." << std::endl;
+}
+
+void FeatureGeneratorImpl::restore_checkpoint(
+    Checkpoint& checkpoint,
+    const core::States& states,
+    GeneratorData& data,
+    core::DenotationsCaches& caches) {
+    std::ifstream in(m_checkpoint_filename, std::ios::binary);
+    if (!in) {
+        return;
+    }
+    Checkpoint previous = Checkpoint::read(in);
+    if (previous.states_hash != checkpoint.states_hash || previous.enabled_rules != checkpoint.enabled_rules) {
+        utils::g_log << "Ignoring checkpoint of different states or rules." << std::endl;
+        return;
+    }
+    // Complexities up to the smaller of two different limits contain the same features.
+    int num_layers = std::min(static_cast<int>(previous.layers.size()), data.m_complexity);
+    for (std::size_t i = 0; i < checkpoint.complexity_limits.size(); ++i) {
+        if (previous.complexity_limits[i] != checkpoint.complexity_limits[i]) {
+            num_layers = std::min({num_layers, previous.complexity_limits[i], checkpoint.complexity_limits[i]});
+        }
+    }
+    // Fingerprints of a different sample are recomputed by committing the features again.
+    const bool reuse_fingerprints = previous.num_sample_states == checkpoint.num_sample_states;
+    const auto rules = get_rules();
+    for (int complexity = 1; complexity <= num_layers; ++complexity) {
+        const auto& layer = previous.layers[complexity - 1];
+        for (const auto& feature : layer.features[0]) {
+            auto boolean = data.m_factory.parse_boolean(feature.first);
+            if (reuse_fingerprints) data.add_generated(std::move(boolean), complexity, feature.second);
+            else data.add_candidate(std::move(boolean));
+        }
+        for (const auto& feature : layer.features[1]) {
+            auto numerical = data.m_factory.parse_numerical(feature.first);
+            if (reuse_fingerprints) data.add_generated(std::move(numerical), complexity, feature.second);
+            else data.add_candidate(std::move(numerical));
+        }
+        for (const auto& feature : layer.features[2]) {
+            auto concept_ = data.m_factory.parse_concept(feature.first);
+            if (reuse_fingerprints) data.add_generated(std::move(concept_), complexity, feature.second);
+            else data.add_candidate(std::move(concept_));
+        }
+        for (const auto& feature : layer.features[3]) {
+            auto role = data.m_factory.parse_role(feature.first);
+            if (reuse_fingerprints) data.add_generated(std::move(role), complexity, feature.second);
+            else data.add_candidate(std::move(role));
+        }
+        if (!reuse_fingerprints) {
+            data.commit_candidates(states, complexity, caches);
+        }
+        for (std::size_t i = 0; i < rules.size() && i < layer.rule_counts.size(); ++i) {
+            rules[i]->set_count(layer.rule_counts[i]);
+        }
+        checkpoint.layers.push_back(make_checkpoint_layer(complexity, data, rules));
+    }
+    if (num_layers > 0) {
+        utils::g_log << "Restored checkpoint with complexities up to " << num_layers << "." << std::endl;
+    }
+}
+
 void FeatureGeneratorImpl::print_statistics() const {
     for (auto& r : m_primitive_rules) r->print_statistics();
     for (auto& r : m_concept_inductive_rules) r->print_statistics();
@@ -193,6 +341,22 @@ void FeatureGeneratorImpl::print_statistics() const {
     for (auto& r : m_numerical_inductive_rules) r->print_statistics();
 }
 
+void FeatureGeneratorImpl::set_executor(core::Executor* executor) {
+    m_executor = executor;
+}
+
+void FeatureGeneratorImpl::set_num_sample_states(int num_sample_states) {
+    m_num_sample_states = num_sample_states;
+}
+
+void FeatureGeneratorImpl::set_prune_comparable_operands(bool enable) {
+    m_prune_comparable_operands = enable;
+}
+
+void FeatureGeneratorImpl::set_checkpoint_file(const std::string& filename) {
+    m_checkpoint_filename = filename;
+}
+
 void FeatureGeneratorImpl::set_generate_empty_boolean(bool enable) {
     b_empty->set_enabled(enable);
 }
@@ -47,6 +47,7 @@
 
 
 namespace dlplan::generator {
+struct Checkpoint;
 struct GeneratorData;
 
 using Rule_Ptr = std::shared_ptr<rules::Rule>;
@@ -97,14 +98,59 @@ private:
     Rule_Ptr r_transitive_closure;
     Rule_Ptr r_transitive_reflexive_closure;
 
+    /**
+     * Evaluates candidates in parallel if not nullptr, not owned.
+     */
+    core::Executor* m_executor;
+
+    /**
+     * Candidates are compared on a sample of states first if positive.
+     */
+    int m_num_sample_states;
+
+    /**
+     * Pairs of comparable operands of commutative rules are skipped if true.
+     */
+    bool m_prune_comparable_operands;
+
+    /**
+     * Completed complexities are written to this file if not empty.
+     */
+    std::string m_checkpoint_filename;
+
 private:
+    /**
+     * All rules in a fixed order for checkpoints.
+     */
+    std::vector<Rule_Ptr> get_rules() const;
+
+    /**
+     * Restores the completed complexities from the checkpoint file that
+     * match the states, enabled rules, and complexity limits.
+     */
+    void restore_checkpoint(
+        Checkpoint& checkpoint,
+        const core::States& states,
+        GeneratorData& data,
+        core::DenotationsCaches& caches);
+
+    /**
+     * Adds the features of the completed complexity to the checkpoint
+     * and writes it to the checkpoint file.
+     */
+    void save_checkpoint(
+        Checkpoint& checkpoint,
+        int complexity,
+        const GeneratorData& data) const;
+
     /**
      * Generates all Elements with complexity 1.
      */
     void generate_base(
         const core::States& states,
         GeneratorData& data,
-        core::DenotationsCaches& caches);
+        core::DenotationsCaches& caches,
+        Checkpoint& checkpoint);
 
     /**
      * Inductively generate Elements of higher complexity.
@@ -117,7 +163,8 @@ private:
         int count_numerical_complexity_limit,
         int distance_numerical_complexity_limit,
         GeneratorData& data,
-        core::DenotationsCaches& caches);
+        core::DenotationsCaches& caches,
+        Checkpoint& checkpoint);
 
     /**
      * Print some brief overview.
@@ -146,6 +193,14 @@ public:
         int time_limit,
         int feature_limit);
 
+    void set_executor(core::Executor* executor);
+
+    void set_num_sample_states(int num_sample_states);
+
+    void set_prune_comparable_operands(bool enable);
+
+    void set_checkpoint_file(const std::string& filename);
+
     /**
      * Set element generation on or off
      */
@@ -41,13 +41,36 @@ GeneratedFeatures FeatureGenerator::generate(
 
     utils::reserve_extra_memory_padding(1);
 
-    auto features = m_pImpl->generate(factory, states, concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit, time_limit, feature_limit);
+    GeneratedFeatures features;
+    try {
+        features = m_pImpl->generate(factory, states, concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit, time_limit, feature_limit);
+    } catch (...) {
+        // Reading a checkpoint file can fail.
+        utils::release_extra_memory_padding();
+        throw;
+    }
 
     utils::release_extra_memory_padding();
 
     return features;
 }
 
+void FeatureGenerator::set_executor(core::Executor* executor) {
+    m_pImpl->set_executor(executor);
+}
+
+void FeatureGenerator::set_num_sample_states(int num_sample_states) {
+    m_pImpl->set_num_sample_states(num_sample_states);
+}
+
+void FeatureGenerator::set_prune_comparable_operands(bool enable) {
+    m_pImpl->set_prune_comparable_operands(enable);
+}
+
+void FeatureGenerator::set_checkpoint_file(const std::string& filename) {
+    m_pImpl->set_checkpoint_file(filename);
+}
+
 void FeatureGenerator::set_generate_empty_boolean(bool enable) {
     m_pImpl->set_generate_empty_boolean(enable);
 }
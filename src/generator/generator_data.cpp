@@ -0,0 +1,291 @@
+#include "generator_data.h"
+
+#include "../utils/MurmurHash3.h"
+
+#include <algorithm>
+#include <functional>
+
+
+namespace dlplan::generator {
+
+static std::uint64_t hash_denotation(bool denotation) {
+    return denotation;
+}
+
+static std::uint64_t hash_denotation(int denotation) {
+    return static_cast<std::uint32_t>(denotation);
+}
+
+template<typename Denotation>
+static std::uint64_t hash_denotation(const std::shared_ptr<const Denotation>& denotation) {
+    return denotation->hash();
+}
+
+/// @brief Hashes the hashes of the denotations in the order of the states.
+template<typename Denotations>
+static Fingerprint compute_fingerprint(const Denotations& denotations) {
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(denotations.size());
+    for (const auto& denotation : denotations) {
+        hashes.push_back(hash_denotation(denotation));
+    }
+    std::uint64_t out[2];
+    MurmurHash3_x64_128(hashes.data(), static_cast<int>(hashes.size() * sizeof(std::uint64_t)), 0, out);
+    return Fingerprint{ out[0], out[1] };
+}
+
+template<typename T>
+static bool are_equal(const std::vector<T>& left, const std::vector<T>& right) {
+    return left == right;
+}
+
+template<typename Denotation>
+static bool are_equal(const std::vector<std::shared_ptr<const Denotation>>& left, const std::vector<std::shared_ptr<const Denotation>>& right) {
+    return std::equal(left.begin(), left.end(), right.begin(), right.end(),
+        [](const auto& l, const auto& r) { return l == r || *l == *r; });
+}
+
+static void add_to_sketch(SubsetSketch& sketch, std::uint64_t value) {
+    // Finalizer of MurmurHash3
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    sketch.bits[(value >> 6) % sketch.bits.size()] |= std::uint64_t(1) << (value & 63);
+}
+
+static SubsetSketch compute_sketch(const core::ConceptDenotations& denotations) {
+    SubsetSketch sketch{};
+    for (std::size_t i = 0; i < denotations.size(); ++i) {
+        denotations[i]->for_each([&](core::ObjectIndex object) {
+            add_to_sketch(sketch, (static_cast<std::uint64_t>(i) << 32) | static_cast<std::uint32_t>(object));
+        });
+        sketch.size += denotations[i]->size();
+    }
+    return sketch;
+}
+
+static SubsetSketch compute_sketch(const core::RoleDenotations& denotations) {
+    SubsetSketch sketch{};
+    for (std::size_t i = 0; i < denotations.size(); ++i) {
+        denotations[i]->for_each([&](core::ObjectIndex first, core::ObjectIndex second) {
+            add_to_sketch(sketch, (static_cast<std::uint64_t>(i) << 40)
+                ^ (static_cast<std::uint64_t>(first) << 20) ^ static_cast<std::uint64_t>(second));
+        });
+        sketch.size += denotations[i]->size();
+    }
+    return sketch;
+}
+
+/// @brief Calls function on all indices smaller than size. Tasks of the
+///        executor process consecutive ranges of indices if the caches
+///        are thread-safe.
+static void for_each_index(
+    std::size_t size,
+    const core::DenotationsCaches& caches,
+    core::Executor* executor,
+    const std::function<void(std::size_t)>& function) {
+    if (!executor || executor->get_num_threads() <= 1 || !caches.is_thread_safe() || size <= 1) {
+        for (std::size_t i = 0; i < size; ++i) {
+            function(i);
+        }
+        return;
+    }
+    std::size_t num_tasks = std::min(size, 4 * static_cast<std::size_t>(executor->get_num_threads()));
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t task = 0; task < num_tasks; ++task) {
+        tasks.push_back([&, task]() {
+            for (std::size_t i = size * task / num_tasks; i < size * (task + 1) / num_tasks; ++i) {
+                function(i);
+            }
+        });
+    }
+    executor->run(tasks);
+}
+
+/// @brief Tests the sketches first and then the denotations on all states,
+///        stopping at the first state in which left is not a subset of right.
+template<typename Element>
+static bool is_subset_of(
+    const std::unordered_map<core::ElementIndex, SubsetSketch>& sketches,
+    const Element& left,
+    const Element& right,
+    const core::States& states,
+    core::DenotationsCaches& caches) {
+    if (!sketches.at(left.get_index()).may_be_subset_of(sketches.at(right.get_index()))) {
+        return false;
+    }
+    auto left_denotations = left.evaluate(states, caches);
+    auto right_denotations = right.evaluate(states, caches);
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        if (!(*left_denotations)[i]->is_subset_of(*(*right_denotations)[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Removes the pairs in which an operand is a subset of the other on
+///        all states, keeping the order of the others. Missing sketches are
+///        computed on the sample if there is one, so that only pairs that pass
+///        the sketch test are evaluated on all states.
+template<typename Element>
+static void remove_comparable_pairs(
+    std::vector<std::pair<std::shared_ptr<const Element>, std::shared_ptr<const Element>>>& pairs,
+    const core::States& states,
+    core::DenotationsCaches& caches,
+    core::Executor* executor,
+    const core::States& sample_states,
+    core::DenotationsCaches* sample_caches,
+    std::unordered_map<core::ElementIndex, SubsetSketch>& sketches) {
+    const core::States& sketch_states = sample_caches ? sample_states : states;
+    core::DenotationsCaches& sketch_caches = sample_caches ? *sample_caches : caches;
+    std::vector<const Element*> missing_elements;
+    for (const auto& pair : pairs) {
+        for (const Element* element : {pair.first.get(), pair.second.get()}) {
+            if (!sketches.count(element->get_index())) {
+                missing_elements.push_back(element);
+            }
+        }
+    }
+    std::sort(missing_elements.begin(), missing_elements.end());
+    missing_elements.erase(std::unique(missing_elements.begin(), missing_elements.end()), missing_elements.end());
+    std::vector<SubsetSketch> missing_sketches(missing_elements.size());
+    for_each_index(missing_elements.size(), sketch_caches, executor, [&](std::size_t i) {
+        missing_sketches[i] = compute_sketch(*missing_elements[i]->evaluate(sketch_states, sketch_caches));
+    });
+    for (std::size_t i = 0; i < missing_elements.size(); ++i) {
+        sketches.emplace(missing_elements[i]->get_index(), missing_sketches[i]);
+    }
+    // The sketches are only read from here on.
+    std::vector<char> is_comparable(pairs.size());
+    for_each_index(pairs.size(), caches, executor, [&](std::size_t i) {
+        const auto& [left, right] = pairs[i];
+        is_comparable[i] = is_subset_of(sketches, *left, *right, states, caches)
+            || is_subset_of(sketches, *right, *left, states, caches);
+    });
+    std::size_t num_kept = 0;
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        if (!is_comparable[i]) {
+            pairs[num_kept++] = std::move(pairs[i]);
+        }
+    }
+    pairs.resize(num_kept);
+}
+
+/// @brief Keeps the candidates with new denotations in the order of
+///        enumeration and clears the candidates. Only candidates whose
+///        fingerprint equals that of a kept feature are compared on all
+///        states. With a sample, these are the only candidates that are
+///        evaluated on all states here, kept candidates are evaluated
+///        when they are needed.
+template<typename Element>
+static int commit(
+    std::vector<std::shared_ptr<const Element>>& candidates,
+    const core::States& states,
+    core::DenotationsCaches& caches,
+    core::Executor* executor,
+    const core::States& sample_states,
+    core::DenotationsCaches* sample_caches,
+    FingerprintTable<Element>& hash_table,
+    std::vector<std::shared_ptr<const Element>>& generated,
+    std::vector<std::shared_ptr<const Element>>& iteration) {
+    const core::States& fingerprint_states = sample_caches ? sample_states : states;
+    core::DenotationsCaches& fingerprint_caches = sample_caches ? *sample_caches : caches;
+    std::vector<Fingerprint> fingerprints(candidates.size());
+    for_each_index(candidates.size(), fingerprint_caches, executor, [&](std::size_t i) {
+        fingerprints[i] = compute_fingerprint(*candidates[i]->evaluate(fingerprint_states, fingerprint_caches));
+    });
+    if (sample_caches) {
+        // Evaluate candidates that agree with a kept feature or an earlier
+        // candidate on the sample in parallel before comparing them.
+        std::unordered_map<Fingerprint, std::size_t, FingerprintHash> first_candidates;
+        std::vector<const Element*> colliding_elements;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            auto range = hash_table.equal_range(fingerprints[i]);
+            for (auto it = range.first; it != range.second; ++it) {
+                colliding_elements.push_back(it->second.get());
+            }
+            auto result = first_candidates.emplace(fingerprints[i], i);
+            if (range.first != range.second || !result.second) {
+                colliding_elements.push_back(candidates[result.first->second].get());
+                colliding_elements.push_back(candidates[i].get());
+            }
+        }
+        std::sort(colliding_elements.begin(), colliding_elements.end());
+        colliding_elements.erase(std::unique(colliding_elements.begin(), colliding_elements.end()), colliding_elements.end());
+        for_each_index(colliding_elements.size(), caches, executor, [&](std::size_t i) {
+            colliding_elements[i]->evaluate(states, caches);
+        });
+    }
+    int num_kept = 0;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        auto range = hash_table.equal_range(fingerprints[i]);
+        if (range.first != range.second) {
+            auto denotations = candidates[i]->evaluate(states, caches);
+            if (std::any_of(range.first, range.second, [&](const auto& entry) {
+                    return are_equal(*entry.second->evaluate(states, caches), *denotations); })) {
+                continue;
+            }
+        }
+        hash_table.emplace(fingerprints[i], candidates[i]);
+        generated.push_back(candidates[i]);
+        iteration.push_back(std::move(candidates[i]));
+        ++num_kept;
+    }
+    candidates.clear();
+    return num_kept;
+}
+
+void GeneratorData::remove_comparable_pairs(ConceptPairs& pairs, const core::States& states, core::DenotationsCaches& caches) {
+    if (m_prune_comparable_operands) {
+        generator::remove_comparable_pairs(pairs, states, caches, m_executor, m_sample_states, m_sample_caches.get(), m_concept_sketches);
+    }
+}
+
+void GeneratorData::remove_comparable_pairs(RolePairs& pairs, const core::States& states, core::DenotationsCaches& caches) {
+    if (m_prune_comparable_operands) {
+        generator::remove_comparable_pairs(pairs, states, caches, m_executor, m_sample_states, m_sample_caches.get(), m_role_sketches);
+    }
+}
+
+void GeneratorData::initialize_sample(const core::States& states, int num_sample_states, bool is_thread_safe) {
+    m_sample_states.clear();
+    m_sample_caches = nullptr;
+    if (num_sample_states <= 0 || static_cast<std::size_t>(num_sample_states) >= states.size()) {
+        return;
+    }
+    for (int i = 0; i < num_sample_states; ++i) {
+        m_sample_states.push_back(states[states.size() * i / num_sample_states]);
+    }
+    m_sample_caches = std::make_unique<core::DenotationsCaches>(is_thread_safe ? 64 : 1);
+}
+
+int GeneratorData::commit_candidates(const core::States& states, int target_complexity, core::DenotationsCaches& caches) {
+    int num_kept = 0;
+    auto& booleans = std::get<0>(m_candidates);
+    if (!booleans.empty()) {
+        num_kept += commit(booleans, states, caches, m_executor, m_sample_states, m_sample_caches.get(),
+            m_boolean_hash_table, std::get<0>(m_generated_features), m_booleans_by_iteration[target_complexity]);
+    }
+    auto& numericals = std::get<1>(m_candidates);
+    if (!numericals.empty()) {
+        num_kept += commit(numericals, states, caches, m_executor, m_sample_states, m_sample_caches.get(),
+            m_numerical_hash_table, std::get<1>(m_generated_features), m_numericals_by_iteration[target_complexity]);
+    }
+    auto& concepts = std::get<2>(m_candidates);
+    if (!concepts.empty()) {
+        num_kept += commit(concepts, states, caches, m_executor, m_sample_states, m_sample_caches.get(),
+            m_concept_hash_table, std::get<2>(m_generated_features), m_concepts_by_iteration[target_complexity]);
+    }
+    auto& roles = std::get<3>(m_candidates);
+    if (!roles.empty()) {
+        num_kept += commit(roles, states, caches, m_executor, m_sample_states, m_sample_caches.get(),
+            m_role_hash_table, std::get<3>(m_generated_features), m_roles_by_iteration[target_complexity]);
+    }
+    return num_kept;
+}
+
+}
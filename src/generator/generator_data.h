@@ -5,24 +5,83 @@
 #include "../../include/dlplan/core.h"
 #include "../../include/dlplan/generator.h"
 
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <unordered_map>
 #include <vector>
 
 
 namespace dlplan::generator {
 
+/// @brief 128-bit hash of the denotations of a feature on all states.
+struct Fingerprint {
+    std::uint64_t low;
+    std::uint64_t high;
+
+    bool operator==(const Fingerprint& other) const {
+        return low == other.low && high == other.high;
+    }
+};
+
+struct FingerprintHash {
+    std::size_t operator()(const Fingerprint& fingerprint) const {
+        return fingerprint.low;
+    }
+};
+
+/// @brief Summarizes the denotations of a concept or role on all states.
+///        The bits are hashes of the objects or pairs in each state and
+///        size is the sum of the denotation sizes, both are monotone.
+struct SubsetSketch {
+    std::array<std::uint64_t, 4> bits;
+    std::size_t size;
+
+    /// @brief Returns false if the summarized denotations cannot be
+    ///        subsets of the other summarized denotations in all states.
+    bool may_be_subset_of(const SubsetSketch& other) const {
+        for (std::size_t i = 0; i < bits.size(); ++i) {
+            if (bits[i] & ~other.bits[i]) return false;
+        }
+        return size <= other.size;
+    }
+};
+
+/// @brief Maps fingerprints to the generated features with that fingerprint.
+///        Features with equal fingerprints are compared on all states.
+template<typename Element>
+using FingerprintTable = std::unordered_multimap<Fingerprint, std::shared_ptr<const Element>, FingerprintHash>;
+
+using ConceptPairs = std::vector<std::pair<std::shared_ptr<const core::Concept>, std::shared_ptr<const core::Concept>>>;
+using RolePairs = std::vector<std::pair<std::shared_ptr<const core::Role>, std::shared_ptr<const core::Role>>>;
+
 struct GeneratorData {
     core::SyntacticElementFactory& m_factory;
-    std::unordered_set<std::shared_ptr<const core::BooleanDenotations>> m_boolean_hash_table;
-    std::unordered_set<std::shared_ptr<const core::NumericalDenotations>> m_numerical_hash_table;
-    std::unordered_set<std::shared_ptr<const core::ConceptDenotations>> m_concept_hash_table;
-    std::unordered_set<std::shared_ptr<const core::RoleDenotations>> m_role_hash_table;
+    // Evaluates candidates in parallel if not nullptr, not owned.
+    core::Executor* m_executor;
+    FingerprintTable<core::Boolean> m_boolean_hash_table;
+    FingerprintTable<core::Numerical> m_numerical_hash_table;
+    FingerprintTable<core::Concept> m_concept_hash_table;
+    FingerprintTable<core::Role> m_role_hash_table;
     std::vector<std::vector<std::shared_ptr<const core::Boolean>>> m_booleans_by_iteration;
     std::vector<std::vector<std::shared_ptr<const core::Numerical>>> m_numericals_by_iteration;
     std::vector<std::vector<std::shared_ptr<const core::Concept>>> m_concepts_by_iteration;
     std::vector<std::vector<std::shared_ptr<const core::Role>>> m_roles_by_iteration;
     GeneratedFeatures m_generated_features;
+    // Candidates of the current rule in the order of enumeration.
+    GeneratedFeatures m_candidates;
+    // Skips pairs of operands in which one is a subset of the other if true.
+    bool m_prune_comparable_operands;
+    // Sketches of concepts and roles by element index for subset tests,
+    // computed on the sample states if there is a sample.
+    std::unordered_map<core::ElementIndex, SubsetSketch> m_concept_sketches;
+    std::unordered_map<core::ElementIndex, SubsetSketch> m_role_sketches;
+    // Fingerprints are computed on the sample states if the caches are not nullptr.
+    // The sample has separate caches because lists of denotations are cached by element.
+    core::States m_sample_states;
+    std::unique_ptr<core::DenotationsCaches> m_sample_caches;
 
     // resource constraints
     int m_complexity;
@@ -32,19 +91,83 @@ struct GeneratorData {
 
     GeneratorData(
       core::SyntacticElementFactory& factory,
+      core::Executor* executor,
+      bool prune_comparable_operands,
       int complexity,
       int time_limit,
       int feature_limit)
       : m_factory(factory),
+        m_executor(executor),
         m_booleans_by_iteration(std::vector<std::vector<std::shared_ptr<const core::Boolean>>>(complexity + 1)),
         m_numericals_by_iteration(std::vector<std::vector<std::shared_ptr<const core::Numerical>>>(complexity + 1)),
         m_concepts_by_iteration(std::vector<std::vector<std::shared_ptr<const core::Concept>>>(complexity + 1)),
         m_roles_by_iteration(std::vector<std::vector<std::shared_ptr<const core::Role>>>(complexity + 1)),
+        m_prune_comparable_operands(prune_comparable_operands),
         m_complexity(complexity),
         m_time_limit(time_limit),
         m_feature_limit(feature_limit),
         m_timer(time_limit) { }
 
+    /// @brief Computes fingerprints on num_sample_states evenly spaced states
+    ///        if it is positive and less than the number of states.
+    void initialize_sample(const core::States& states, int num_sample_states, bool is_thread_safe);
+
+    /// @brief Removes the pairs of operands in which the denotation of one
+    ///        is a subset of the denotation of the other in all states, keeping
+    ///        the order of the other pairs. Pairs are tested in parallel with
+    ///        the executor. Does nothing if pruning is disabled.
+    void remove_comparable_pairs(ConceptPairs& pairs, const core::States& states, core::DenotationsCaches& caches);
+    void remove_comparable_pairs(RolePairs& pairs, const core::States& states, core::DenotationsCaches& caches);
+
+    void add_candidate(std::shared_ptr<const core::Boolean>&& boolean) {
+        std::get<0>(m_candidates).push_back(std::move(boolean));
+    }
+
+    void add_candidate(std::shared_ptr<const core::Numerical>&& numerical) {
+        std::get<1>(m_candidates).push_back(std::move(numerical));
+    }
+
+    void add_candidate(std::shared_ptr<const core::Concept>&& concept_) {
+        std::get<2>(m_candidates).push_back(std::move(concept_));
+    }
+
+    void add_candidate(std::shared_ptr<const core::Role>&& role) {
+        std::get<3>(m_candidates).push_back(std::move(role));
+    }
+
+    /// @brief Adds a feature with the given fingerprint that was generated
+    ///        before, e.g., in a checkpoint.
+    void add_generated(std::shared_ptr<const core::Boolean>&& boolean, int complexity, const Fingerprint& fingerprint) {
+        m_boolean_hash_table.emplace(fingerprint, boolean);
+        std::get<0>(m_generated_features).push_back(boolean);
+        m_booleans_by_iteration[complexity].push_back(std::move(boolean));
+    }
+
+    void add_generated(std::shared_ptr<const core::Numerical>&& numerical, int complexity, const Fingerprint& fingerprint) {
+        m_numerical_hash_table.emplace(fingerprint, numerical);
+        std::get<1>(m_generated_features).push_back(numerical);
+        m_numericals_by_iteration[complexity].push_back(std::move(numerical));
+    }
+
+    void add_generated(std::shared_ptr<const core::Concept>&& concept_, int complexity, const Fingerprint& fingerprint) {
+        m_concept_hash_table.emplace(fingerprint, concept_);
+        std::get<2>(m_generated_features).push_back(concept_);
+        m_concepts_by_iteration[complexity].push_back(std::move(concept_));
+    }
+
+    void add_generated(std::shared_ptr<const core::Role>&& role, int complexity, const Fingerprint& fingerprint) {
+        m_role_hash_table.emplace(fingerprint, role);
+        std::get<3>(m_generated_features).push_back(role);
+        m_roles_by_iteration[complexity].push_back(std::move(role));
+    }
+
+    /// @brief Evaluates the candidates and keeps those whose denotations
+    ///        differ from all kept features, in the order of enumeration.
+    ///        With a sample, only candidates that agree with a kept feature
+    ///        on the sample are evaluated on all states. Returns the number
+    ///        of kept candidates.
+    int commit_candidates(const core::States& states, int target_complexity, core::DenotationsCaches& caches);
+
     void print_statistics() const {
         std::cout << "Total concept elements: " << std::accumulate(m_concepts_by_iteration.begin(), m_concepts_by_iteration.end(), 0, [&](int current_sum, const auto& e){ return current_sum + e.size(); }) << std::endl
                   << "Total role elements: " << std::accumulate(m_roles_by_iteration.begin(), m_roles_by_iteration.end(), 0, [&](int current_sum, const auto& e){ return current_sum + e.size(); }) << std::endl
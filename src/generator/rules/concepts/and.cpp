@@ -6,20 +6,23 @@
 namespace dlplan::generator::rules {
 void AndConcept::generate_impl(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
     core::SyntacticElementFactory& factory = data.m_factory;
-    for (int i = 1; i < target_complexity - 1; ++i) {
+    ConceptPairs pairs;
+    // c_and is commutative, hence enumerate the pairs of elements with complexities i <= j once.
+    for (int i = 1; i <= (target_complexity - 1) / 2; ++i) {
         int j = target_complexity - i - 1;
-        for (const auto& c1 : data.m_concepts_by_iteration[i]) {
-            for (const auto& c2 : data.m_concepts_by_iteration[j]) {
-                auto element = factory.make_and_concept(c1, c2);
-                auto denotations = element->evaluate(states, caches);
-                if (data.m_concept_hash_table.insert(denotations).second) {
-                    std::get<2>(data.m_generated_features).push_back(element);
-                    data.m_concepts_by_iteration[target_complexity].push_back(std::move(element));
-                    increment_generated();
-                }
+        const auto& concepts_1 = data.m_concepts_by_iteration[i];
+        const auto& concepts_2 = data.m_concepts_by_iteration[j];
+        for (std::size_t k = 0; k < concepts_1.size(); ++k) {
+            for (std::size_t l = (i == j) ? k + 1 : 0; l < concepts_2.size(); ++l) {
+                pairs.emplace_back(concepts_1[k], concepts_2[l]);
             }
         }
     }
+    // The result equals an operand that was generated before if one operand is a subset of the other.
+    data.remove_comparable_pairs(pairs, states, caches);
+    for (const auto& [c1, c2] : pairs) {
+        data.add_candidate(factory.make_and_concept(c1, c2));
+    }
 }
 
 std::string AndConcept::get_name() const {
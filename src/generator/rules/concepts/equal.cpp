@@ -6,7 +6,7 @@
 
 
 namespace dlplan::generator::rules {
-void EqualConcept::generate_impl(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
+void EqualConcept::generate_impl(const core::States&, int target_complexity, GeneratorData& data, core::DenotationsCaches&) {
     if (target_complexity == 3)
     {
         core::SyntacticElementFactory& factory = data.m_factory;
@@ -26,14 +26,7 @@ void EqualConcept::generate_impl(const core::States& states, int target_complexi
                         {
                             std::string r2_predicate_name = r2_primitive_role->get_predicate().get_name();
                             if ((r1_predicate_name) == r2_predicate_name + "_g") {
-                                auto element = factory.make_equal_concept(r2, r1);
-                                auto denotations = element->evaluate(states, caches);
-                                if (data.m_concept_hash_table.insert(denotations).second)
-                                {
-                                    std::get<2>(data.m_generated_features).push_back(element);
-                                    data.m_concepts_by_iteration[target_complexity].push_back(std::move(element));
-                                    increment_generated();
-                                }
+                                data.add_candidate(factory.make_equal_concept(r2, r1));
                             }
                         }
                     }
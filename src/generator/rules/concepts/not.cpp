@@ -4,16 +4,10 @@
 
 
 namespace dlplan::generator::rules {
-void NotConcept::generate_impl(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
+void NotConcept::generate_impl(const core::States&, int target_complexity, GeneratorData& data, core::DenotationsCaches&) {
     core::SyntacticElementFactory& factory = data.m_factory;
     for (const auto& c : data.m_concepts_by_iteration[target_complexity-1]) {
-        auto element = factory.make_not_concept(c);
-        auto denotations = element->evaluate(states, caches);
-        if (data.m_concept_hash_table.insert(denotations).second) {
-            std::get<2>(data.m_generated_features).push_back(element);
-            data.m_concepts_by_iteration[target_complexity].push_back(std::move(element));
-            increment_generated();
-        }
+        data.add_candidate(factory.make_not_concept(c));
     }
 }
 
@@ -4,17 +4,11 @@
 
 
 namespace dlplan::generator::rules {
-void OneOfConcept::generate_impl(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
+void OneOfConcept::generate_impl(const core::States&, [[maybe_unused]] int target_complexity, GeneratorData& data, core::DenotationsCaches&) {
     core::SyntacticElementFactory& factory = data.m_factory;
     assert(target_complexity == 1);
     for (const auto& constant : factory.get_vocabulary_info()->get_constants()) {
-        auto element = factory.make_one_of_concept(constant);
-        auto denotations = element->evaluate(states, caches);
-        if (data.m_concept_hash_table.insert(denotations).second) {
-            std::get<2>(data.m_generated_features).push_back(element);
-            data.m_concepts_by_iteration[target_complexity].push_back(std::move(element));
-            increment_generated();
-        }
+        data.add_candidate(factory.make_one_of_concept(constant));
     }
 }
 
@@ -28,13 +28,7 @@ void ConceptDistanceNumerical::generate_impl(const core::States& states, int tar
                     continue;
                 }
                 for (const auto& c2 : data.m_concepts_by_iteration[k]) {
-                    auto element = factory.make_concept_distance_numerical(c1, r, c2);
-                    auto denotations = element->evaluate(states, caches);
-                    if (data.m_numerical_hash_table.insert(denotations).second) {
-                        std::get<1>(data.m_generated_features).push_back(element);
-                        data.m_numericals_by_iteration[target_complexity].push_back(std::move(element));
-                        increment_generated();
-                    }
+                    data.add_candidate(factory.make_concept_distance_numerical(c1, r, c2));
                 }
             }
         }
@@ -58,13 +52,7 @@ void ConceptDistanceNumerical::generate_impl(const core::States& states, int tar
             }
             for (const auto& r : data.m_roles_by_iteration[j]) {
                 for (const auto& c2 : data.m_concepts_by_iteration[k]) {
-                    auto element = factory.make_concept_distance_numerical(c1, r, c2);
-                    auto denotations = element->evaluate(states, caches);
-                    if (data.m_numerical_hash_table.insert(denotations).second) {
-                        std::get<1>(data.m_generated_features).push_back(element);
-                        data.m_numericals_by_iteration[target_complexity].push_back(std::move(element));
-                        increment_generated();
-                    }
+                    data.add_candidate(factory.make_concept_distance_numerical(c1, r, c2));
                 }
             }
         }
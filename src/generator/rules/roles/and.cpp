@@ -10,6 +10,7 @@ void AndRole::generate_impl(const core::States& states, int target_complexity, G
     if (target_complexity == 3)
     {
         core::SyntacticElementFactory& factory = data.m_factory;
+        RolePairs pairs;
         for (int i = 1; i < target_complexity - 1; ++i)
         {
             int j = target_complexity - i - 1;
@@ -26,20 +27,18 @@ void AndRole::generate_impl(const core::States& states, int target_complexity, G
                         {
                             std::string r2_predicate_name = r2_primitive_role->get_predicate().get_name();
                             if ((r1_predicate_name) == r2_predicate_name + "_g") {
-                                auto element = factory.make_and_role(r1, r2);
-                                auto denotations = element->evaluate(states, caches);
-                                if (data.m_role_hash_table.insert(denotations).second)
-                                {
-                                    std::get<3>(data.m_generated_features).push_back(element);
-                                    data.m_roles_by_iteration[target_complexity].push_back(std::move(element));
-                                    increment_generated();
-                                }
+                                pairs.emplace_back(r1, r2);
                             }
                         }
                     }
                 }
             }
         }
+        // The result equals an operand that was generated before if one operand is a subset of the other.
+        data.remove_comparable_pairs(pairs, states, caches);
+        for (const auto& [r1, r2] : pairs) {
+            data.add_candidate(factory.make_and_role(r1, r2));
+        }
     }
 }
 
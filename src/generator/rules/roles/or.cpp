@@ -6,20 +6,23 @@
 namespace dlplan::generator::rules {
 void OrRole::generate_impl(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
     core::SyntacticElementFactory& factory = data.m_factory;
-    for (int i = 1; i < target_complexity - 1; ++i) {
+    RolePairs pairs;
+    // r_or is commutative, hence enumerate the pairs of elements with complexities i <= j once.
+    for (int i = 1; i <= (target_complexity - 1) / 2; ++i) {
         int j = target_complexity - i - 1;
-        for (const auto& r1 : data.m_roles_by_iteration[i]) {
-            for (const auto& r2 : data.m_roles_by_iteration[j]) {
-                auto element = factory.make_or_role(r1, r2);
-                auto denotations = element->evaluate(states, caches);
-                if (data.m_role_hash_table.insert(denotations).second) {
-                    std::get<3>(data.m_generated_features).push_back(element);
-                    data.m_roles_by_iteration[target_complexity].push_back(std::move(element));
-                    increment_generated();
-                }
+        const auto& roles_1 = data.m_roles_by_iteration[i];
+        const auto& roles_2 = data.m_roles_by_iteration[j];
+        for (std::size_t k = 0; k < roles_1.size(); ++k) {
+            for (std::size_t l = (i == j) ? k + 1 : 0; l < roles_2.size(); ++l) {
+                pairs.emplace_back(roles_1[k], roles_2[l]);
             }
         }
     }
+    // The result equals an operand that was generated before if one operand is a subset of the other.
+    data.remove_comparable_pairs(pairs, states, caches);
+    for (const auto& [r1, r2] : pairs) {
+        data.add_candidate(factory.make_or_role(r1, r2));
+    }
 }
 
 std::string OrRole::get_name() const {
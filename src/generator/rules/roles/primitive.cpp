@@ -4,18 +4,12 @@
 
 
 namespace dlplan::generator::rules {
-void PrimitiveRole::generate_impl(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
+void PrimitiveRole::generate_impl(const core::States&, [[maybe_unused]] int target_complexity, GeneratorData& data, core::DenotationsCaches&) {
     assert(target_complexity == 1);
     core::SyntacticElementFactory& factory = data.m_factory;
     for (const auto& predicate : factory.get_vocabulary_info()->get_predicates()) {
         if (predicate.get_arity() == 2) {
-            auto element = factory.make_primitive_role(predicate, 0, 1);
-            auto denotations = element->evaluate(states, caches);
-            if (data.m_role_hash_table.insert(denotations).second) {
-                std::get<3>(data.m_generated_features).push_back(element);
-                data.m_roles_by_iteration[target_complexity].push_back(std::move(element));
-                increment_generated();
-            }
+            data.add_candidate(factory.make_primitive_role(predicate, 0, 1));
         }
     }
 }
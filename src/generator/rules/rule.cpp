@@ -0,0 +1,14 @@
+#include "rule.h"
+
+#include "../generator_data.h"
+
+
+namespace dlplan::generator::rules {
+void Rule::generate(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
+    if (m_enabled) {
+        generate_impl(states, target_complexity, data, caches);
+        m_count += data.commit_candidates(states, target_complexity, caches);
+    }
+}
+
+}
@@ -35,13 +35,9 @@ public:
     }
 
     /**
-     * Submits tasks to threadpool.
+     * Enumerates candidates and keeps those with new denotations.
      */
-    void generate(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches) {
-        if (m_enabled) {
-            generate_impl(states, target_complexity, data, caches);
-        }
-    }
+    void generate(const core::States& states, int target_complexity, GeneratorData& data, core::DenotationsCaches& caches);
 
     void print_statistics() const {
         if (m_enabled) {
@@ -53,11 +49,19 @@ public:
         m_enabled = enabled;
     }
 
-    virtual std::string get_name() const = 0;
+    bool is_enabled() const {
+        return m_enabled;
+    }
 
-    void increment_generated() {
-        ++m_count;
+    int get_count() const {
+        return m_count;
     }
+
+    void set_count(int count) {
+        m_count = count;
+    }
+
+    virtual std::string get_name() const = 0;
 };
 
 }
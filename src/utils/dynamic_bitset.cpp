@@ -0,0 +1,347 @@
+#include "../../include/dlplan/utils/dynamic_bitset.h"
+
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DLPLAN_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+
+namespace dlplan::bitset_kernels {
+namespace {
+
+struct Kernels {
+    InstructionSet instruction_set;
+    void (*bitwise_and)(std::uint64_t*, const std::uint64_t*, std::size_t);
+    void (*bitwise_or)(std::uint64_t*, const std::uint64_t*, std::size_t);
+    void (*bitwise_and_not)(std::uint64_t*, const std::uint64_t*, std::size_t);
+    void (*bitwise_not)(std::uint64_t*, std::size_t);
+    bool (*intersects)(const std::uint64_t*, const std::uint64_t*, std::size_t);
+    bool (*is_subset_of)(const std::uint64_t*, const std::uint64_t*, std::size_t);
+    bool (*equal)(const std::uint64_t*, const std::uint64_t*, std::size_t);
+};
+
+
+/* Scalar kernels, also used for the tails of the vectorized kernels. */
+
+void scalar_and(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) dst[i] &= src[i];
+}
+
+void scalar_or(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) dst[i] |= src[i];
+}
+
+void scalar_and_not(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) dst[i] &= ~src[i];
+}
+
+void scalar_not(std::uint64_t* dst, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) dst[i] = ~dst[i];
+}
+
+bool scalar_intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (left[i] & right[i]) return true;
+    }
+    return false;
+}
+
+bool scalar_is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (left[i] & ~right[i]) return false;
+    }
+    return true;
+}
+
+bool scalar_equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (left[i] != right[i]) return false;
+    }
+    return true;
+}
+
+constexpr Kernels scalar_kernels = {
+    InstructionSet::SCALAR,
+    scalar_and, scalar_or, scalar_and_not, scalar_not,
+    scalar_intersects, scalar_is_subset_of, scalar_equal };
+
+
+#ifdef DLPLAN_X86_KERNELS
+
+/* AVX2 kernels: 4 blocks per 256-bit register. */
+
+const std::size_t avx2_blocks = 4;
+
+#define DLPLAN_AVX2 __attribute__((target("avx2")))
+
+DLPLAN_AVX2 void avx2_and(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx2_blocks <= n; i += avx2_blocks) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(a, b));
+    }
+    scalar_and(dst + i, src + i, n - i);
+}
+
+DLPLAN_AVX2 void avx2_or(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx2_blocks <= n; i += avx2_blocks) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(a, b));
+    }
+    scalar_or(dst + i, src + i, n - i);
+}
+
+DLPLAN_AVX2 void avx2_and_not(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx2_blocks <= n; i += avx2_blocks) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        // andnot computes ~b & a
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_andnot_si256(b, a));
+    }
+    scalar_and_not(dst + i, src + i, n - i);
+}
+
+DLPLAN_AVX2 void avx2_not(std::uint64_t* dst, std::size_t n) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    std::size_t i = 0;
+    for (; i + avx2_blocks <= n; i += avx2_blocks) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, ones));
+    }
+    scalar_not(dst + i, n - i);
+}
+
+DLPLAN_AVX2 bool avx2_intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx2_blocks <= n; i += avx2_blocks) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        // testz returns 1 iff a & b == 0
+        if (!_mm256_testz_si256(a, b)) return true;
+    }
+    return scalar_intersects(left + i, right + i, n - i);
+}
+
+DLPLAN_AVX2 bool avx2_is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx2_blocks <= n; i += avx2_blocks) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        // testc returns 1 iff ~b & a == 0
+        if (!_mm256_testc_si256(b, a)) return false;
+    }
+    return scalar_is_subset_of(left + i, right + i, n - i);
+}
+
+DLPLAN_AVX2 bool avx2_equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx2_blocks <= n; i += avx2_blocks) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        __m256i x = _mm256_xor_si256(a, b);
+        if (!_mm256_testz_si256(x, x)) return false;
+    }
+    return scalar_equal(left + i, right + i, n - i);
+}
+
+#undef DLPLAN_AVX2
+
+const Kernels avx2_kernels = {
+    InstructionSet::AVX2,
+    avx2_and, avx2_or, avx2_and_not, avx2_not,
+    avx2_intersects, avx2_is_subset_of, avx2_equal };
+
+
+/* AVX-512 kernels: 8 blocks per 512-bit register. */
+
+const std::size_t avx512_blocks = 8;
+
+#define DLPLAN_AVX512 __attribute__((target("avx512f")))
+
+// Truth tables for _mm512_ternarylogic_epi64(a, b, c, imm) where a = 0xF0, b = 0xCC, c = 0xAA.
+// We use them instead of andnot/xor because GCC warns about the undefined
+// pass-through operand in the masked andnot builtin.
+const int ternary_and_not = 0xF0 & ~0xCC;  // a & ~b
+const int ternary_not = ~0xF0 & 0xFF;  // ~a
+
+DLPLAN_AVX512 void avx512_and(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx512_blocks <= n; i += avx512_blocks) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        __m512i b = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, _mm512_and_si512(a, b));
+    }
+    scalar_and(dst + i, src + i, n - i);
+}
+
+DLPLAN_AVX512 void avx512_or(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx512_blocks <= n; i += avx512_blocks) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        __m512i b = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, _mm512_or_si512(a, b));
+    }
+    scalar_or(dst + i, src + i, n - i);
+}
+
+DLPLAN_AVX512 void avx512_and_not(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx512_blocks <= n; i += avx512_blocks) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        __m512i b = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, _mm512_ternarylogic_epi64(a, b, b, ternary_and_not));
+    }
+    scalar_and_not(dst + i, src + i, n - i);
+}
+
+DLPLAN_AVX512 void avx512_not(std::uint64_t* dst, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx512_blocks <= n; i += avx512_blocks) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        _mm512_storeu_si512(dst + i, _mm512_ternarylogic_epi64(a, a, a, ternary_not));
+    }
+    scalar_not(dst + i, n - i);
+}
+
+DLPLAN_AVX512 bool avx512_intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx512_blocks <= n; i += avx512_blocks) {
+        __m512i a = _mm512_loadu_si512(left + i);
+        __m512i b = _mm512_loadu_si512(right + i);
+        if (_mm512_test_epi64_mask(a, b)) return true;
+    }
+    return scalar_intersects(left + i, right + i, n - i);
+}
+
+DLPLAN_AVX512 bool avx512_is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx512_blocks <= n; i += avx512_blocks) {
+        __m512i a = _mm512_loadu_si512(left + i);
+        __m512i b = _mm512_loadu_si512(right + i);
+        __m512i c = _mm512_ternarylogic_epi64(a, b, b, ternary_and_not);
+        if (_mm512_test_epi64_mask(c, c)) return false;
+    }
+    return scalar_is_subset_of(left + i, right + i, n - i);
+}
+
+DLPLAN_AVX512 bool avx512_equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + avx512_blocks <= n; i += avx512_blocks) {
+        __m512i a = _mm512_loadu_si512(left + i);
+        __m512i b = _mm512_loadu_si512(right + i);
+        if (_mm512_cmpneq_epi64_mask(a, b)) return false;
+    }
+    return scalar_equal(left + i, right + i, n - i);
+}
+
+#undef DLPLAN_AVX512
+
+const Kernels avx512_kernels = {
+    InstructionSet::AVX512,
+    avx512_and, avx512_or, avx512_and_not, avx512_not,
+    avx512_intersects, avx512_is_subset_of, avx512_equal };
+
+#endif
+
+
+bool cpu_supports(InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case InstructionSet::SCALAR:
+            return true;
+#ifdef DLPLAN_X86_KERNELS
+        case InstructionSet::AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case InstructionSet::AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+const Kernels& get_kernels(InstructionSet instruction_set) {
+    switch (instruction_set) {
+#ifdef DLPLAN_X86_KERNELS
+        case InstructionSet::AVX2:
+            return avx2_kernels;
+        case InstructionSet::AVX512:
+            return avx512_kernels;
+#endif
+        default:
+            return scalar_kernels;
+    }
+}
+
+const Kernels& select_best_kernels() {
+    for (auto instruction_set : { InstructionSet::AVX512, InstructionSet::AVX2 }) {
+        if (cpu_supports(instruction_set)) {
+            return get_kernels(instruction_set);
+        }
+    }
+    return scalar_kernels;
+}
+
+// Constant-initialized to the scalar kernels such that bitsets used
+// during static initialization of other translation units remain valid.
+const Kernels* g_kernels = &scalar_kernels;
+
+// Dispatch on CPU features at load time.
+struct KernelSelector {
+    KernelSelector() { g_kernels = &select_best_kernels(); }
+} g_kernel_selector;
+
+}
+
+
+void bitwise_and(std::uint64_t* dst, const std::uint64_t* src, std::size_t num_blocks) {
+    g_kernels->bitwise_and(dst, src, num_blocks);
+}
+
+void bitwise_or(std::uint64_t* dst, const std::uint64_t* src, std::size_t num_blocks) {
+    g_kernels->bitwise_or(dst, src, num_blocks);
+}
+
+void bitwise_and_not(std::uint64_t* dst, const std::uint64_t* src, std::size_t num_blocks) {
+    g_kernels->bitwise_and_not(dst, src, num_blocks);
+}
+
+void bitwise_not(std::uint64_t* dst, std::size_t num_blocks) {
+    g_kernels->bitwise_not(dst, num_blocks);
+}
+
+bool intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    return g_kernels->intersects(left, right, num_blocks);
+}
+
+bool is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    return g_kernels->is_subset_of(left, right, num_blocks);
+}
+
+bool equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    return g_kernels->equal(left, right, num_blocks);
+}
+
+bool is_supported(InstructionSet instruction_set) {
+    return cpu_supports(instruction_set);
+}
+
+InstructionSet get_instruction_set() {
+    return g_kernels->instruction_set;
+}
+
+void set_instruction_set(InstructionSet instruction_set) {
+    if (!cpu_supports(instruction_set)) {
+        throw std::runtime_error("bitset_kernels::set_instruction_set - instruction set is not supported by this CPU.");
+    }
+    g_kernels = &get_kernels(instruction_set);
+}
+
+}
@@ -30,4 +30,52 @@ TEST(DLPTests, ConceptPrimitive) {
     EXPECT_EQ(concept3->evaluate(state_0), create_concept_denotation(*instance, {"C", "F"}));
 }
 
+TEST(DLPTests, ConceptPrimitiveStaticAndMixedPredicates) {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    auto predicate_0 = vocabulary->add_predicate("at", 2);
+    auto predicate_1 = vocabulary->add_predicate("road", 2);
+    auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+    auto atom_0 = instance->add_atom("at", {"T", "A"});
+    auto atom_1 = instance->add_atom("at", {"U", "B"});
+    auto atom_2 = instance->add_static_atom("road", {"A", "B"});
+    auto atom_3 = instance->add_static_atom("at", {"V", "C"});
+
+    State state_0(0, instance, {atom_1, atom_0});
+    EXPECT_EQ(state_0.get_atom_indices_by_predicate(predicate_0.get_index()).size(), 2);
+    EXPECT_TRUE(state_0.get_atom_indices_by_predicate(predicate_1.get_index()).empty());
+    EXPECT_EQ(instance->get_static_atom_indices_by_predicate(predicate_1.get_index()), AtomIndices({atom_2.get_index()}));
+
+    SyntacticElementFactory factory(vocabulary);
+
+    auto concept_0 = factory.parse_concept("c_primitive(at,1)");
+    EXPECT_EQ(concept_0->evaluate(state_0), create_concept_denotation(*instance, {"A", "B", "C"}));
+
+    // Adding static atoms invalidates the precomputed static parts.
+    auto atom_4 = instance->add_static_atom("at", {"V", "D"});
+    State state_1(1, instance, {atom_0});
+    EXPECT_EQ(concept_0->evaluate(state_1), create_concept_denotation(*instance, {"A", "C", "D"}));
+
+    auto role_0 = factory.parse_role("r_primitive(road,0,1)");
+    EXPECT_EQ(role_0->evaluate(state_1), create_role_denotation(*instance, {{"A", "B"}}));
+}
+
+TEST(DLPTests, ConceptPrimitiveStaticAfterMove) {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    auto predicate_0 = vocabulary->add_predicate("road", 2);
+    InstanceInfo instance(0, vocabulary);
+    instance.add_static_atom("road", {"A", "B"});
+    EXPECT_TRUE(instance.get_static_concept_denotation(predicate_0.get_index(), 0).contains(0));
+
+    // The moved-to instance keeps the static denotations.
+    InstanceInfo moved(std::move(instance));
+    EXPECT_TRUE(moved.get_static_concept_denotation(predicate_0.get_index(), 0).contains(0));
+    EXPECT_EQ(moved.get_static_role_denotation(predicate_0.get_index(), 0, 1).size(), 1);
+
+    // The moved-from instance stays usable.
+    EXPECT_TRUE(instance.get_static_concept_denotation(predicate_0.get_index(), 0).empty());
+    instance = std::move(moved);
+    EXPECT_EQ(instance.get_static_role_denotation(predicate_0.get_index(), 0, 1).size(), 1);
+    EXPECT_TRUE(moved.get_static_role_denotation(predicate_0.get_index(), 0, 1).empty());
+}
+
 }
@@ -4,6 +4,9 @@
 
 #include "../../include/dlplan/core.h"
 
+#include <algorithm>
+#include <thread>
+
 using namespace dlplan::core;
 
 namespace dlplan::tests::core
@@ -67,4 +70,201 @@ namespace dlplan::tests::core
         );
         EXPECT_EQ(boolean_0->evaluate(States{state_0, state_1}, caches), boolean_0->evaluate(States{state_0, state_1}, caches));
     }
+
+    TEST(DLPTests, CachingHandles)
+    {
+        // Enough objects and keys to grow the tables.
+        DenotationsCaches caches;
+        const int num_denotations = 5000;
+        std::vector<std::shared_ptr<const ConceptDenotation>> denotations;
+        for (int i = 0; i < num_denotations; ++i) {
+            ConceptDenotation denotation(64);
+            denotation.insert(i % 64);
+            denotation.insert((i / 64) % 64);
+            auto handle = caches.data.insert_unique_handle(std::move(denotation));
+            caches.data.insert_mapping<ConceptDenotation>(DenotationsCacheKey{i, 0, i}, handle);
+            denotations.push_back(caches.data.get<ConceptDenotation>(handle));
+        }
+        for (int i = 0; i < num_denotations; ++i) {
+            // Equal denotations are interned once.
+            EXPECT_EQ(caches.data.get<ConceptDenotation>(DenotationsCacheKey{i, 0, i}), denotations[i]);
+            EXPECT_EQ(denotations[i], denotations[i % 4096]);
+        }
+        EXPECT_EQ(caches.data.get<ConceptDenotation>(DenotationsCacheKey{0, 1, 0}), nullptr);
+        EXPECT_THROW(caches.data.insert_mapping<ConceptDenotation>(DenotationsCacheKey{0, 0, 0}, 0), std::runtime_error);
+        // Pointers share ownership of a chunk of objects but not of all objects:
+        // the pointers in the vector into the chunk and at most one per object
+        // of the chunk in the cache.
+        const long num_chunk_objects = decltype(caches.data)::objects_per_chunk;
+        const long num_chunk_pointers = std::count_if(denotations.begin(), denotations.end(), [&](const auto& denotation) {
+            return !denotation.owner_before(denotations[1]) && !denotations[1].owner_before(denotation); });
+        EXPECT_LT(num_chunk_pointers, num_denotations);
+        EXPECT_GT(denotations[1].use_count(), num_chunk_pointers);
+        EXPECT_LE(denotations[1].use_count(), num_chunk_pointers + num_chunk_objects);
+
+        // Keys are mapped to interned objects and to objects that are not interned.
+        caches.data.insert_mapping<ConceptDenotation>(DenotationsCacheKey{1, 2, 1}, denotations[1]);
+        EXPECT_EQ(caches.data.get<ConceptDenotation>(DenotationsCacheKey{1, 2, 1}), denotations[1]);
+        auto other = std::make_shared<const ConceptDenotation>(64);
+        caches.data.insert_mapping<ConceptDenotation>(DenotationsCacheKey{0, 2, 0}, other);
+        EXPECT_EQ(caches.data.get<ConceptDenotation>(DenotationsCacheKey{0, 2, 0}), other);
+        EXPECT_THROW(caches.data.insert_mapping<ConceptDenotation>(DenotationsCacheKey{0, 2, 0}, other), std::runtime_error);
+
+        // Pointers outlive the cleared cache.
+        auto denotation = denotations[1];
+        denotations.clear();
+        caches.data.clear();
+        EXPECT_EQ(caches.data.get<ConceptDenotation>(DenotationsCacheKey{1, 0, 1}), nullptr);
+        EXPECT_TRUE(denotation->contains(1));
+        EXPECT_TRUE(denotation->contains(0));
+    }
+
+    TEST(DLPTests, CachingConcurrent)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("edge", 2);
+        vocabulary->add_predicate("at", 1);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        const int num_objects = 12;
+        std::vector<Atom> atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            instance->add_static_atom("edge", {std::to_string(i), std::to_string((i + 1) % num_objects)});
+            atoms.push_back(instance->add_atom("at", {std::to_string(i)}));
+        }
+        States states;
+        for (int i = 0; i < 64; ++i) {
+            std::vector<Atom> state_atoms;
+            for (int j = 0; j < num_objects; ++j) {
+                if ((i >> (j % 6)) & 1) state_atoms.push_back(atoms[j]);
+            }
+            states.emplace_back(i, instance, state_atoms);
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        std::vector<std::shared_ptr<const Concept>> concepts{
+            factory.parse_concept("c_some(r_primitive(edge,0,1),c_primitive(at,0))"),
+            factory.parse_concept("c_and(c_primitive(at,0),c_all(r_transitive_closure(r_primitive(edge,0,1)),c_primitive(at,0)))"),
+            factory.parse_concept("c_not(c_primitive(at,0))")};
+        std::vector<std::shared_ptr<const Numerical>> numericals{
+            factory.parse_numerical("n_count(c_some(r_primitive(edge,0,1),c_primitive(at,0)))"),
+            factory.parse_numerical("n_role_distance(r_primitive(edge,0,1),r_primitive(edge,0,1),r_restrict(r_primitive(edge,0,1),c_not(c_primitive(at,0))))"),
+            factory.parse_numerical("n_sum_role_distance(r_primitive(edge,0,1),r_primitive(edge,0,1),r_restrict(r_primitive(edge,0,1),c_primitive(at,0)))")};
+
+        // All threads evaluate all elements on all states in different orders
+        // such that they race on the same keys.
+        DenotationsCaches caches(64);
+        const int num_threads = 8;
+        std::vector<std::vector<std::shared_ptr<const ConceptDenotation>>> concept_results(num_threads);
+        std::vector<std::vector<int>> numerical_results(num_threads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                concept_results[t].resize(concepts.size() * states.size());
+                numerical_results[t].resize(numericals.size() * states.size());
+                for (size_t k = 0; k < states.size(); ++k) {
+                    size_t i = (k * (2 * t + 1) + t) % states.size();
+                    for (size_t j = 0; j < concepts.size(); ++j) {
+                        concept_results[t][j * states.size() + i] = concepts[j]->evaluate(states[i], caches);
+                    }
+                    for (size_t j = 0; j < numericals.size(); ++j) {
+                        numerical_results[t][j * states.size() + i] = numericals[j]->evaluate(states[i], caches);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (size_t i = 0; i < states.size(); ++i) {
+            for (size_t j = 0; j < concepts.size(); ++j) {
+                const auto& denotation = concept_results[0][j * states.size() + i];
+                EXPECT_EQ(*denotation, concepts[j]->evaluate(states[i]));
+                for (int t = 1; t < num_threads; ++t) {
+                    // Threads agree on the interned denotation.
+                    EXPECT_EQ(concept_results[t][j * states.size() + i], denotation);
+                }
+            }
+            for (size_t j = 0; j < numericals.size(); ++j) {
+                for (int t = 0; t < num_threads; ++t) {
+                    EXPECT_EQ(numerical_results[t][j * states.size() + i], numericals[j]->evaluate(states[i]));
+                }
+            }
+        }
+        // Distances were attached to the interned role denotation.
+        auto edge = factory.parse_role("r_primitive(edge,0,1)")->evaluate(states[0], caches);
+        EXPECT_GT(compute_memory_usage(*edge), compute_memory_usage(RoleDenotation(*edge)));
+    }
+
+    TEST(DLPTests, CachingMemoryBudget)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("edge", 2, true);
+        vocabulary->add_predicate("at", 1);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        const int num_objects = 8;
+        std::vector<Atom> atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            instance->add_static_atom("edge", {std::to_string(i), std::to_string((i + 1) % num_objects)});
+            atoms.push_back(instance->add_atom("at", {std::to_string(i)}));
+        }
+        States states;
+        for (int i = 0; i < 256; ++i) {
+            std::vector<Atom> state_atoms;
+            for (int j = 0; j < num_objects; ++j) {
+                if ((i >> j) & 1) state_atoms.push_back(atoms[j]);
+            }
+            states.emplace_back(i, instance, state_atoms);
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        auto concept_0 = factory.parse_concept("c_some(r_primitive(edge,0,1),c_primitive(at,0))");
+        auto numerical_0 = factory.parse_numerical("n_role_distance(r_primitive(edge,0,1),r_primitive(edge,0,1),r_restrict(r_primitive(edge,0,1),c_primitive(at,0)))");
+        auto static_role = factory.parse_role("r_primitive(edge,0,1)");
+
+        const std::size_t memory_budget = 4096;
+        DenotationsCaches caches(1, memory_budget);
+        auto first_denotation = concept_0->evaluate(states[0], caches);
+        for (const auto& state : states) {
+            EXPECT_EQ(*concept_0->evaluate(state, caches), concept_0->evaluate(state));
+            EXPECT_EQ(numerical_0->evaluate(state, caches), numerical_0->evaluate(state));
+            EXPECT_LE(caches.per_state_data->get_memory_usage(), memory_budget);
+        }
+        EXPECT_GT(caches.per_state_data->get_num_evictions(), 0);
+        EXPECT_LT(caches.per_state_data->get_num_mappings(), 3 * states.size());
+        // Evicted denotations stay valid.
+        EXPECT_EQ(*first_denotation, concept_0->evaluate(states[0]));
+
+        // Recently used denotations are hit.
+        std::size_t num_hits = caches.per_state_data->get_num_hits();
+        EXPECT_EQ(concept_0->evaluate(states.back(), caches), concept_0->evaluate(states.back(), caches));
+        EXPECT_GT(caches.per_state_data->get_num_hits(), num_hits);
+
+        // Denotations of static elements are pinned.
+        auto static_denotation = static_role->evaluate(states[0], caches);
+        EXPECT_EQ(caches.data.get<RoleDenotation>(DenotationsCacheKey{static_role->get_index(), instance->get_index(), -1}), static_denotation);
+        EXPECT_EQ(static_role->evaluate(states[1], caches), static_denotation);
+
+        // Threads share a bounded cache with a budget per shard.
+        DenotationsCaches concurrent_caches(8, 8 * memory_budget);
+        EXPECT_EQ(concurrent_caches.per_state_data->get_num_shards(), 8);
+        const int num_threads = 4;
+        std::vector<int> num_errors(num_threads, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (size_t k = 0; k < states.size(); ++k) {
+                    const auto& state = states[(k * (2 * t + 1) + t) % states.size()];
+                    num_errors[t] += (*concept_0->evaluate(state, concurrent_caches) != concept_0->evaluate(state));
+                    num_errors[t] += (numerical_0->evaluate(state, concurrent_caches) != numerical_0->evaluate(state));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(std::count(num_errors.begin(), num_errors.end(), 0), num_threads);
+        EXPECT_LE(concurrent_caches.per_state_data->get_memory_usage(), 8 * memory_budget);
+        EXPECT_GT(concurrent_caches.per_state_data->get_num_evictions(), 0);
+    }
 }
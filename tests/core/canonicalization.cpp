@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+namespace dlplan::tests::core {
+
+TEST(DLPTests, Canonicalization) {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("on_g", 2);
+
+    SyntacticElementFactory factory(vocabulary);
+    auto clear = factory.parse_concept("c_primitive(clear,0)");
+    auto on = factory.parse_role("r_primitive(on,0,1)");
+    auto on_g = factory.parse_role("r_primitive(on_g,0,1)");
+    auto top = factory.parse_concept("c_top");
+    auto bot = factory.parse_concept("c_bot");
+
+    // Commutative operands
+    EXPECT_EQ(factory.parse_concept("c_and(c_primitive(clear,0),c_projection(r_primitive(on,0,1),0))"),
+              factory.parse_concept("c_and(c_projection(r_primitive(on,0,1),0),c_primitive(clear,0))"));
+    EXPECT_EQ(factory.parse_concept("c_equal(r_primitive(on,0,1),r_primitive(on_g,0,1))"),
+              factory.parse_concept("c_equal(r_primitive(on_g,0,1),r_primitive(on,0,1))"));
+    EXPECT_EQ(factory.parse_role("r_or(r_primitive(on,0,1),r_primitive(on_g,0,1))"),
+              factory.parse_role("r_or(r_primitive(on_g,0,1),r_primitive(on,0,1))"));
+
+    // Idempotence and double negation
+    EXPECT_EQ(factory.parse_concept("c_and(c_primitive(clear,0),c_primitive(clear,0))"), clear);
+    EXPECT_EQ(factory.parse_concept("c_or(c_primitive(clear,0),c_primitive(clear,0))"), clear);
+    EXPECT_EQ(factory.parse_role("r_and(r_primitive(on,0,1),r_primitive(on,0,1))"), on);
+    EXPECT_EQ(factory.parse_concept("c_not(c_not(c_primitive(clear,0)))"), clear);
+    EXPECT_EQ(factory.parse_role("r_not(r_not(r_primitive(on,0,1)))"), on);
+    EXPECT_EQ(factory.parse_role("r_inverse(r_inverse(r_primitive(on_g,0,1)))"), on_g);
+    EXPECT_EQ(factory.parse_role("r_transitive_closure(r_transitive_closure(r_primitive(on,0,1)))"),
+              factory.parse_role("r_transitive_closure(r_primitive(on,0,1))"));
+
+    // Top and bot absorption
+    EXPECT_EQ(factory.parse_concept("c_and(c_top,c_primitive(clear,0))"), clear);
+    EXPECT_EQ(factory.parse_concept("c_and(c_primitive(clear,0),c_bot)"), bot);
+    EXPECT_EQ(factory.parse_concept("c_or(c_bot,c_primitive(clear,0))"), clear);
+    EXPECT_EQ(factory.parse_concept("c_or(c_primitive(clear,0),c_top)"), top);
+    EXPECT_EQ(factory.parse_concept("c_or(c_primitive(clear,0),c_not(c_primitive(clear,0)))"), top);
+    EXPECT_EQ(factory.parse_concept("c_diff(c_primitive(clear,0),c_primitive(clear,0))"), bot);
+    EXPECT_EQ(factory.parse_concept("c_not(c_top)"), bot);
+    EXPECT_EQ(factory.parse_concept("c_some(r_primitive(on,0,1),c_bot)"), bot);
+    EXPECT_EQ(factory.parse_concept("c_all(r_primitive(on,0,1),c_top)"), top);
+    EXPECT_EQ(factory.parse_role("r_and(r_top,r_primitive(on,0,1))"), on);
+    EXPECT_EQ(factory.parse_role("r_restrict(r_primitive(on,0,1),c_top)"), on);
+
+    EXPECT_EQ(factory.parse_concept("c_diff(c_top,c_primitive(clear,0))"), factory.parse_concept("c_not(c_primitive(clear,0))"));
+    EXPECT_EQ(factory.parse_concept("c_equal(r_primitive(on,0,1),r_primitive(on,0,1))"), top);
+    EXPECT_EQ(factory.parse_role("r_transitive_reflexive_closure(r_transitive_closure(r_primitive(on,0,1)))")->str(),
+              "r_transitive_reflexive_closure(r_primitive(on,0,1))");
+}
+
+}
@@ -15,4 +15,22 @@ TEST(DLPTests, ConceptDenotationComputeRepr) {
     EXPECT_EQ(denotation.str(), "ConceptDenotation(num_objects=4, object_indices=[0, 2])");
 }
 
+TEST(DLPTests, ConceptDenotationIterate) {
+    int num_objects = 130;
+    ConceptDenotation denotation(num_objects);
+    EXPECT_EQ(denotation.size(), 0);
+    denotation.insert(129);
+    denotation.insert(0);
+    denotation.insert(31);
+    denotation.insert(32);
+    denotation.insert(64);
+    EXPECT_EQ(denotation.size(), 5);
+    ObjectIndices visited;
+    denotation.for_each([&](ObjectIndex object) { visited.push_back(object); });
+    EXPECT_EQ(visited, ObjectIndices({0, 31, 32, 64, 129}));
+    EXPECT_EQ(denotation.to_sorted_vector(), visited);
+    ~denotation;
+    EXPECT_EQ(denotation.size(), 125);
+}
+
 }
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+namespace dlplan::tests::core {
+
+TEST(DLPTests, ConceptDenotationBatchEvaluate) {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    auto predicate_0 = vocabulary->add_predicate("conn", 2);
+    auto predicate_1 = vocabulary->add_predicate("start", 1);
+    auto predicate_2 = vocabulary->add_predicate("end", 1);
+
+    // Small instance: A -> B -> C
+    auto instance_0 = std::make_shared<InstanceInfo>(0, vocabulary);
+    auto atom_0_0 = instance_0->add_atom("conn", {"A", "B"});
+    auto atom_0_1 = instance_0->add_atom("conn", {"B", "C"});
+    auto atom_0_2 = instance_0->add_atom("start", {"A"});
+    auto atom_0_3 = instance_0->add_atom("end", {"C"});
+    // Instance whose rows span two blocks: chain over 70 objects.
+    auto instance_1 = std::make_shared<InstanceInfo>(1, vocabulary);
+    std::vector<Atom> atoms_1;
+    for (int i = 0; i + 1 < 70; ++i) {
+        atoms_1.push_back(instance_1->add_atom("conn", {std::to_string(i), std::to_string(i + 1)}));
+    }
+    atoms_1.push_back(instance_1->add_atom("start", {"65"}));
+    atoms_1.push_back(instance_1->add_atom("end", {"69"}));
+    atoms_1.push_back(instance_1->add_atom("end", {"3"}));
+
+    States states({
+        State(0, instance_0, {atom_0_0, atom_0_1, atom_0_2, atom_0_3}),
+        State(1, instance_0, {atom_0_0, atom_0_3}),
+        State(0, instance_1, atoms_1)});
+
+    SyntacticElementFactory factory(vocabulary);
+    DenotationsCaches caches;
+    for (const auto& description : {
+            "c_and(c_primitive(start,0),c_primitive(end,0))",
+            "c_or(c_primitive(start,0),c_primitive(end,0))",
+            "c_not(c_or(c_primitive(start,0),c_primitive(end,0)))",
+            "c_some(r_primitive(conn,0,1),c_primitive(end,0))",
+            "c_all(r_primitive(conn,0,1),c_not(c_primitive(end,0)))",
+            "c_and(c_some(r_primitive(conn,0,1),c_top),c_not(c_primitive(start,0)))",
+            // Without batch kernels.
+            "c_projection(r_primitive(conn,0,1),1)",
+            "c_top"}) {
+        auto concept_ = factory.parse_concept(description);
+        auto batch = concept_->evaluate_batch(states, caches);
+        ASSERT_EQ(batch->get_num_rows(), 3);
+        auto counts = batch->count();
+        auto empties = batch->empty();
+        for (int i = 0; i < 3; ++i) {
+            auto expected = concept_->evaluate(states[i]);
+            EXPECT_EQ(batch->get_denotation(i), expected) << description;
+            EXPECT_EQ(counts[i], expected.size()) << description;
+            EXPECT_EQ(empties[i], expected.empty()) << description;
+        }
+        EXPECT_EQ(concept_->evaluate_batch(states, caches), batch);
+    }
+
+    // The default batch evaluation does not intern a list of denotations.
+    auto projection = factory.parse_concept("c_projection(r_primitive(conn,0,1),1)");
+    EXPECT_EQ(caches.data.get<ConceptDenotations>(DenotationsCacheKey{projection->get_index(), -1, -1}), nullptr);
+
+    // Count and emptiness are computed on batches.
+    auto count = factory.parse_numerical("n_count(c_some(r_primitive(conn,0,1),c_primitive(end,0)))");
+    auto empty = factory.parse_boolean("b_empty(c_projection(r_primitive(conn,0,1),1))");
+    auto counts = count->evaluate(states, caches);
+    auto empties = empty->evaluate(states, caches);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ((*counts)[i], count->evaluate(states[i]));
+        EXPECT_EQ((*empties)[i], empty->evaluate(states[i]));
+    }
+
+    // Count and emptiness read cached denotations without packing them,
+    // and packed batches of cached denotations are not cached.
+    auto concept_ = factory.parse_concept("c_diff(c_top,c_primitive(end,0))");
+    auto denotations = concept_->evaluate(states, caches);
+    auto concept_count = factory.parse_numerical("n_count(c_diff(c_top,c_primitive(end,0)))");
+    auto concept_counts = concept_count->evaluate(states, caches);
+    EXPECT_EQ(caches.data.get<ConceptDenotationBatch>(DenotationsCacheKey{concept_->get_index(), -1, -1}), nullptr);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ((*concept_counts)[i], (*denotations)[i]->size());
+    }
+    auto packed = concept_->evaluate_batch(states, caches);
+    EXPECT_EQ(packed->count(), *concept_counts);
+    EXPECT_EQ(caches.data.get<ConceptDenotationBatch>(DenotationsCacheKey{concept_->get_index(), -1, -1}), nullptr);
+}
+
+}
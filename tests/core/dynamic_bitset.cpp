@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/utils/dynamic_bitset.h"
+
+#include <random>
+
+using namespace dlplan;
+using namespace dlplan::bitset_kernels;
+
+
+namespace dlplan::tests::core {
+
+static DynamicBitset<std::uint64_t> create_random_bitset(std::size_t num_bits, std::mt19937& generator) {
+    DynamicBitset<std::uint64_t> bitset(num_bits);
+    std::bernoulli_distribution distribution(0.5);
+    for (std::size_t pos = 0; pos < num_bits; ++pos) {
+        if (distribution(generator)) bitset.set(pos);
+    }
+    return bitset;
+}
+
+TEST(DLPTests, DynamicBitsetKernels) {
+    const auto instruction_set = get_instruction_set();
+    std::mt19937 generator(0);
+    // Sizes cover the inlined scalar path, vector bodies, and tails.
+    for (std::size_t num_bits : { 1, 63, 64, 65, 511, 512, 1000, 2500 }) {
+        const auto left = create_random_bitset(num_bits, generator);
+        const auto right = create_random_bitset(num_bits, generator);
+        auto subset = left;
+        subset &= right;
+
+        set_instruction_set(InstructionSet::SCALAR);
+        auto expected_and = left; expected_and &= right;
+        auto expected_or = left; expected_or |= right;
+        auto expected_diff = left; expected_diff -= right;
+        auto expected_not = left; ~expected_not;
+
+        for (auto other : { InstructionSet::AVX2, InstructionSet::AVX512 }) {
+            if (!is_supported(other)) continue;
+            set_instruction_set(other);
+            auto result_and = left; result_and &= right;
+            auto result_or = left; result_or |= right;
+            auto result_diff = left; result_diff -= right;
+            auto result_not = left; ~result_not;
+            set_instruction_set(InstructionSet::SCALAR);
+            EXPECT_EQ(result_and, expected_and);
+            EXPECT_EQ(result_or, expected_or);
+            EXPECT_EQ(result_diff, expected_diff);
+            EXPECT_EQ(result_not, expected_not);
+            EXPECT_EQ(result_not.count(), static_cast<int>(num_bits) - left.count());
+            set_instruction_set(other);
+            EXPECT_TRUE(subset.is_subset_of(left));
+            EXPECT_EQ(left.is_subset_of(subset), left == subset);
+            EXPECT_EQ(left.intersects(right), !subset.none());
+            EXPECT_FALSE(expected_diff.intersects(right));
+            EXPECT_TRUE(left == left);
+            EXPECT_EQ(expected_or == left, right.is_subset_of(left));
+        }
+    }
+    set_instruction_set(instruction_set);
+}
+
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+#include <sstream>
+
+using namespace dlplan::core;
+
+
+namespace dlplan::tests::core {
+
+TEST(DLPTests, EvaluationProfiler) {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+    auto atom_0 = instance->add_atom("on", {"A", "B"});
+    auto atom_1 = instance->add_atom("clear", {"A"});
+    auto atom_2 = instance->add_atom("clear", {"B"});
+    States states{State(0, instance, {atom_0, atom_1}), State(1, instance, {atom_2})};
+
+    SyntacticElementFactory factory(vocabulary);
+    auto clear = factory.parse_concept("c_primitive(clear,0)");
+    auto numerical = factory.parse_numerical("n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))");
+
+    // Disabled by default.
+    EvaluationProfiler profiler;
+    DenotationsCaches caches;
+    numerical->evaluate(states[0], caches);
+    EXPECT_TRUE(profiler.get_profiles().empty());
+
+    caches.profiler = &profiler;
+    numerical->evaluate(states[0], caches);
+    numerical->evaluate(states[1], caches);
+    numerical->evaluate(states, caches);
+    numerical->evaluate(states, caches);
+
+    auto profiles = profiler.get_profiles();
+    EXPECT_EQ(profiles.size(), 4);
+    for (size_t i = 1; i < profiles.size(); ++i) {
+        EXPECT_GE(profiles[i - 1].self_time, profiles[i].self_time);
+    }
+    for (const auto& profile : profiles) {
+        EXPECT_EQ(profile.num_calls, profile.num_hits + profile.num_misses);
+        EXPECT_LE(profile.self_time, profile.cumulative_time);
+        if (profile.index == numerical->get_index()) {
+            EXPECT_EQ(profile.repr, numerical->str());
+            // state 0 hit, state 1 miss, states miss then hit
+            EXPECT_EQ(profile.num_calls, 4);
+            EXPECT_EQ(profile.num_misses, 2);
+        } else if (profile.index == clear->get_index()) {
+            // Only the children of misses are evaluated.
+            EXPECT_EQ(profile.num_hits, 0);
+            EXPECT_GE(profile.num_misses, 2);
+            EXPECT_GT(profile.num_bytes, 0);
+        }
+    }
+
+    std::stringstream json;
+    profiler.write_json(json);
+    EXPECT_NE(json.str().find("\"repr\": \"c_primitive(clear,0)\""), std::string::npos);
+    std::stringstream csv;
+    profiler.write_csv(csv);
+    std::string header;
+    std::getline(csv, header);
+    EXPECT_EQ(header, "index,repr,num_calls,num_hits,num_misses,cumulative_time_ns,self_time_ns,num_bytes");
+    EXPECT_NE(csv.str().find(",\"c_primitive(clear,0)\","), std::string::npos);
+
+    profiler.clear();
+    EXPECT_TRUE(profiler.get_profiles().empty());
+}
+
+}
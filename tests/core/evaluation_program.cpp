@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "../utils/domain.h"
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    static std::shared_ptr<InstanceInfo> construct_gripper_instance(std::shared_ptr<VocabularyInfo> vocabulary, int num_packages) {
+        auto instance = gripper::construct_instance_info(vocabulary);
+        instance->add_atom("free", {});
+        for (int i = 4; i <= num_packages; ++i) {
+            std::string package = std::string("p") + std::to_string(i);
+            instance->add_atom("at", {package, "A"});
+            instance->add_atom("at", {package, "B"});
+            instance->add_atom("holding", {package});
+            instance->add_static_atom("package", {package});
+            instance->add_static_atom("at_g", {package, "B"});
+        }
+        instance->add_static_atom("adjacent", {"A", "B"});
+        instance->add_static_atom("adjacent", {"B", "A"});
+        return instance;
+    }
+
+    TEST(DLPTests, EvaluationProgram)
+    {
+        auto vocabulary = gripper::construct_vocabulary_info();
+        vocabulary->add_predicate("free", 0);
+        vocabulary->add_predicate("adjacent", 2, true);
+        vocabulary->add_constant("A");
+        States states = construct_hashed_states(construct_gripper_instance(vocabulary, 3), 64);
+        States more_states = construct_hashed_states(construct_gripper_instance(vocabulary, 5), 64);
+        states.insert(states.end(), more_states.begin(), more_states.end());
+
+        SyntacticElementFactory factory(vocabulary);
+        std::vector<std::shared_ptr<const Boolean>> booleans{
+            factory.parse_boolean("b_empty(c_primitive(holding,0))"),
+            factory.parse_boolean("b_empty(r_primitive(at,0,1))"),
+            factory.parse_boolean("b_inclusion(c_primitive(holding,0),c_primitive(package,0))"),
+            factory.parse_boolean("b_inclusion(r_primitive(at_g,0,1),r_primitive(at,0,1))"),
+            factory.parse_boolean("b_nullary(free)"),
+            factory.parse_boolean("b_empty(c_some(r_primitive(at,0,1),c_primitive(at_roboter,0)))"),
+            factory.parse_boolean("b_inclusion(c_and(c_primitive(package,0),c_primitive(holding,0)),c_projection(r_primitive(at_g,0,1),0))")};
+        std::vector<std::shared_ptr<const Numerical>> numericals{
+            factory.parse_numerical("n_count(c_and(c_primitive(package,0),c_not(c_some(r_primitive(at,0,1),c_one_of(A)))))"),
+            factory.parse_numerical("n_count(r_compose(r_primitive(at,0,1),r_primitive(adjacent,0,1)))"),
+            factory.parse_numerical("n_concept_distance(c_primitive(at_roboter,0),r_primitive(adjacent,0,1),c_projection(r_primitive(at_g,0,1),1))"),
+            factory.parse_numerical("n_sum_concept_distance(c_primitive(at_roboter,0),r_primitive(adjacent,0,1),c_projection(r_primitive(at,0,1),1))"),
+            factory.parse_numerical("n_role_distance(r_primitive(at,0,1),r_primitive(adjacent,0,1),r_primitive(at_g,0,1))"),
+            factory.parse_numerical("n_sum_role_distance(r_primitive(at,0,1),r_primitive(adjacent,0,1),r_primitive(at_g,0,1))")};
+        std::vector<std::shared_ptr<const Concept>> concepts{
+            factory.parse_concept("c_all(r_primitive(at,0,1),c_one_of(A))"),
+            factory.parse_concept("c_or(c_primitive(holding,0),c_diff(c_primitive(package,0),c_primitive(at_roboter,0)))"),
+            factory.parse_concept("c_bot"),
+            factory.parse_concept("c_top"),
+            factory.parse_concept("c_equal(r_primitive(at,0,1),r_primitive(at_g,0,1))"),
+            factory.parse_concept("c_subset(r_primitive(at_g,0,1),r_primitive(at,0,1))")};
+        std::vector<std::shared_ptr<const Role>> roles{
+            factory.parse_role("r_and(r_primitive(at,0,1),r_primitive(at_g,0,1))"),
+            factory.parse_role("r_diff(r_top,r_inverse(r_primitive(at,0,1)))"),
+            factory.parse_role("r_or(r_identity(c_primitive(holding,0)),r_not(r_primitive(at,0,1)))"),
+            factory.parse_role("r_restrict(r_primitive(at,0,1),c_primitive(at_roboter,0))"),
+            factory.parse_role("r_til_c(r_primitive(adjacent,0,1),c_primitive(at_roboter,0))"),
+            factory.parse_role("r_transitive_closure(r_or(r_primitive(at,0,1),r_primitive(adjacent,0,1)))"),
+            factory.parse_role("r_transitive_reflexive_closure(r_primitive(at,0,1))")};
+
+        EvaluationProgram program(booleans, numericals, concepts, roles);
+        for (const auto& state : states) {
+            program.evaluate(state);
+            for (size_t i = 0; i < booleans.size(); ++i) {
+                EXPECT_EQ(program.get_boolean_value(i), booleans[i]->evaluate(state));
+            }
+            for (size_t i = 0; i < numericals.size(); ++i) {
+                EXPECT_EQ(program.get_numerical_value(i), numericals[i]->evaluate(state));
+            }
+            for (size_t i = 0; i < concepts.size(); ++i) {
+                EXPECT_EQ(program.get_concept_denotation(i), concepts[i]->evaluate(state));
+            }
+            for (size_t i = 0; i < roles.size(); ++i) {
+                EXPECT_EQ(program.get_role_denotation(i), roles[i]->evaluate(state));
+            }
+        }
+        // Shared subterms are compiled once and registers are reused.
+        EvaluationProgram shared_program({}, {
+            factory.parse_numerical("n_count(c_some(r_primitive(at,0,1),c_primitive(at_roboter,0)))"),
+            factory.parse_numerical("n_count(c_all(r_primitive(at,0,1),c_primitive(at_roboter,0)))")});
+        EXPECT_EQ(shared_program.get_num_instructions(), 6);
+        EXPECT_LT(shared_program.get_num_registers(), 6);
+        // Reductions of intersections and existential restrictions are fused.
+        EvaluationProgram fused_program({
+            factory.parse_boolean("b_empty(c_some(r_primitive(at,0,1),c_primitive(at_roboter,0)))")}, {
+            factory.parse_numerical("n_count(c_and(c_primitive(holding,0),c_primitive(package,0)))")});
+        EXPECT_EQ(fused_program.get_num_instructions(), 6);
+        // Children with several uses are not fused but computed once.
+        EvaluationProgram shared_child_program({
+            factory.parse_boolean("b_inclusion(c_and(c_primitive(holding,0),c_primitive(package,0)),c_primitive(at_roboter,0))")}, {
+            factory.parse_numerical("n_count(c_and(c_primitive(holding,0),c_primitive(package,0)))")});
+        EXPECT_EQ(shared_child_program.get_num_instructions(), 6);
+        for (const auto& state : states) {
+            shared_child_program.evaluate(state);
+            EXPECT_EQ(shared_child_program.get_numerical_value(0), factory.parse_numerical("n_count(c_and(c_primitive(holding,0),c_primitive(package,0)))")->evaluate(state));
+        }
+        EXPECT_THROW(program.get_numerical_value(numericals.size()), std::out_of_range);
+    }
+}
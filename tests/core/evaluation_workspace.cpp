@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace dlplan::core;
+
+
+// Counts the heap allocations of all threads while enabled.
+static std::atomic<bool> count_allocations(false);
+static std::atomic<std::size_t> num_heap_allocations(0);
+
+void* operator new(std::size_t size) {
+    if (count_allocations.load(std::memory_order_relaxed)) {
+        num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+
+namespace dlplan::tests::core {
+
+TEST(DLPTests, EvaluationWorkspace) {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+    auto atom_0 = instance->add_atom("on", {"A", "B"});
+    auto atom_1 = instance->add_atom("on", {"B", "C"});
+    auto atom_2 = instance->add_atom("clear", {"A"});
+    auto atom_3 = instance->add_atom("clear", {"C"});
+    States states{State(0, instance, {atom_0, atom_1, atom_2}), State(1, instance, {atom_1, atom_2, atom_3})};
+    // Roles over many objects with few pairs are sparse.
+    auto large_instance = std::make_shared<InstanceInfo>(1, vocabulary);
+    AtomIndices large_atoms;
+    for (int i = 0; i < 20; ++i) {
+        std::string name = "b";
+        name += std::to_string(i);
+        large_atoms.push_back(large_instance->add_atom("clear", {name}).get_index());
+    }
+    large_atoms.push_back(large_instance->add_atom("on", {"b0", "b1"}).get_index());
+    large_atoms.push_back(large_instance->add_atom("on", {"b1", "b2"}).get_index());
+    large_atoms.push_back(large_instance->add_atom("on", {"b3", "b4"}).get_index());
+    states.emplace_back(2, large_instance, large_atoms);
+
+    SyntacticElementFactory factory(vocabulary);
+    auto concept_ = factory.parse_concept("c_and(c_some(r_transitive_closure(r_primitive(on,0,1)),c_primitive(clear,0)),c_not(c_primitive(clear,0)))");
+    auto role = factory.parse_role("r_restrict(r_or(r_primitive(on,0,1),r_inverse(r_primitive(on,0,1))),c_primitive(clear,0))");
+    auto numerical = factory.parse_numerical("n_count(r_compose(r_primitive(on,0,1),r_primitive(on,0,1)))");
+
+    std::vector<ConceptDenotation> concept_denotations;
+    std::vector<RoleDenotation> role_denotations;
+    std::vector<int> values;
+    for (const auto& state : states) {
+        concept_denotations.push_back(concept_->evaluate(state));
+        role_denotations.push_back(role->evaluate(state));
+        values.push_back(numerical->evaluate(state));
+    }
+
+    EvaluationWorkspace workspace;
+    EXPECT_EQ(EvaluationWorkspace::get_current(), nullptr);
+    std::size_t num_allocations = 0;
+    for (int round = 0; round < 3; ++round) {
+        EvaluationWorkspace::Activation activation(workspace);
+        EXPECT_EQ(EvaluationWorkspace::get_current(), &workspace);
+        bool all_equal = true;
+        num_heap_allocations = 0;
+        count_allocations = true;
+        for (size_t i = 0; i < states.size(); ++i) {
+            all_equal &= concept_->evaluate(states[i]) == concept_denotations[i];
+            all_equal &= role->evaluate(states[i]) == role_denotations[i];
+            all_equal &= numerical->evaluate(states[i]) == values[i];
+        }
+        count_allocations = false;
+        EXPECT_TRUE(all_equal);
+        if (round == 0) {
+            num_allocations = workspace.get_num_allocations();
+            EXPECT_GT(num_allocations, 0);
+            EXPECT_GE(num_heap_allocations, num_allocations);
+        } else {
+            // Later rounds reuse all bitsets, pair lists and bit matrices.
+            EXPECT_EQ(workspace.get_num_allocations(), num_allocations);
+            EXPECT_EQ(num_heap_allocations, 0);
+        }
+    }
+    EXPECT_EQ(EvaluationWorkspace::get_current(), nullptr);
+
+    // Denotations that outlive the activation keep their storage.
+    ConceptDenotation denotation(3);
+    {
+        EvaluationWorkspace::Activation activation(workspace);
+        denotation = concept_->evaluate(states[0]);
+    }
+    EXPECT_EQ(denotation, concept_denotations[0]);
+
+    // The free storage of each capacity is bounded.
+    EvaluationWorkspace bounded_workspace;
+    std::vector<std::vector<std::uint64_t>> storage;
+    for (int i = 0; i < 1000; ++i) {
+        storage.push_back(bounded_workspace.acquire(4));
+    }
+    for (auto& blocks : storage) {
+        bounded_workspace.release(std::move(blocks));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        bounded_workspace.acquire(4);
+    }
+    EXPECT_GT(bounded_workspace.get_num_allocations(), 1000);
+}
+
+}
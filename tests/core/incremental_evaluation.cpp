@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    TEST(DLPTests, EvaluateIncrementally)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("edge", 2, true);
+        vocabulary->add_predicate("at", 1);
+        vocabulary->add_predicate("on", 2);
+        vocabulary->add_predicate("clear", 1);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        const int num_objects = 6;
+        AtomIndices at_atoms, on_atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            instance->add_static_atom("edge", {std::to_string(i), std::to_string((i + 1) % num_objects)});
+            at_atoms.push_back(instance->add_atom("at", {std::to_string(i)}).get_index());
+            on_atoms.push_back(instance->add_atom("on", {std::to_string(i), std::to_string((i + 2) % num_objects)}).get_index());
+            instance->add_atom("clear", {std::to_string(i)});
+        }
+        // Primitives over clear cannot be patched because of the static atom.
+        instance->add_static_atom("clear", {"0"});
+
+        SyntacticElementFactory factory(vocabulary);
+        std::vector<std::shared_ptr<const Concept>> concepts{
+            factory.parse_concept("c_primitive(at,0)"),
+            factory.parse_concept("c_some(r_primitive(edge,0,1),c_primitive(at,0))"),
+            factory.parse_concept("c_and(c_primitive(clear,0),c_projection(r_primitive(on,0,1),1))")};
+        std::vector<std::shared_ptr<const Role>> roles{
+            factory.parse_role("r_primitive(on,0,1)"),
+            factory.parse_role("r_primitive(on,1,1)"),
+            factory.parse_role("r_transitive_closure(r_or(r_primitive(edge,0,1),r_primitive(on,0,1)))")};
+        std::vector<std::shared_ptr<const Numerical>> numericals{
+            factory.parse_numerical("n_count(c_primitive(at,0))"),
+            factory.parse_numerical("n_concept_distance(c_primitive(at,0),r_primitive(on,0,1),c_primitive(clear,0))")};
+        std::vector<std::shared_ptr<const Boolean>> booleans{
+            factory.parse_boolean("b_empty(r_primitive(on,0,1))")};
+
+        for (std::size_t memory_budget : {std::size_t(0), std::size_t(1) << 30}) {
+            DenotationsCaches caches = memory_budget ? DenotationsCaches(1, memory_budget) : DenotationsCaches();
+            State state(0, instance, AtomIndices{at_atoms[0], on_atoms[1]});
+            for (int i = 1; i < 50; ++i) {
+                AtomIndices add_atoms, delete_atoms;
+                // Every third transition leaves at unchanged.
+                if (i % 3) (state.get_atom_indices().size() % 2 ? add_atoms : delete_atoms).push_back(at_atoms[i % num_objects]);
+                add_atoms.push_back(on_atoms[(i * 5) % num_objects]);
+                delete_atoms.push_back(on_atoms[(i * 7) % num_objects]);
+                StateTransition transition(state, i, add_atoms, delete_atoms);
+                const State& successor = transition.get_state();
+                for (const auto& concept_element : concepts) {
+                    EXPECT_EQ(*concept_element->evaluate(transition, caches), concept_element->evaluate(successor));
+                }
+                for (const auto& role : roles) {
+                    EXPECT_EQ(*role->evaluate(transition, caches), role->evaluate(successor));
+                }
+                for (const auto& numerical : numericals) {
+                    EXPECT_EQ(numerical->evaluate(transition, caches), numerical->evaluate(successor));
+                }
+                for (const auto& boolean : booleans) {
+                    EXPECT_EQ(boolean->evaluate(transition, caches), boolean->evaluate(successor));
+                }
+                if (!transition.is_changed(concepts[1]->get_predicate_indices())) {
+                    // Elements that do not depend on a changed predicate share the denotation of the parent state.
+                    EXPECT_EQ(concepts[1]->evaluate(successor, caches), concepts[1]->evaluate(state, caches));
+                }
+                state = successor;
+            }
+        }
+
+        State state(0, instance, AtomIndices{at_atoms[0], on_atoms[1]});
+        State successor(1, instance, AtomIndices{at_atoms[0], on_atoms[2]});
+        StateTransition transition(state, successor);
+        EXPECT_EQ(transition.get_add_atom_indices(), AtomIndices{on_atoms[2]});
+        EXPECT_EQ(transition.get_delete_atom_indices(), AtomIndices{on_atoms[1]});
+        EXPECT_EQ(transition.get_changed_predicate_indices(), std::vector<PredicateIndex>{vocabulary->get_predicate("on").get_index()});
+        EXPECT_THROW(StateTransition(state, state), std::runtime_error);
+    }
+}
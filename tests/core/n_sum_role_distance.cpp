@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "../utils/denotation.h"
+#include "../utils/domain.h"
 
 #include "../../include/dlplan/core.h"
 
@@ -52,4 +53,45 @@ TEST(DLPTests, NumericalSumRoleDistance) {
     EXPECT_EQ(numerical_2->evaluate(state_0), std::numeric_limits<int>::max());
 }
 
+TEST(DLPTests, NumericalSumRoleDistanceSharedDistances) {
+    auto vocabulary = chain::construct_vocabulary_info();
+    auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+    const int num_objects = 150;
+    auto atoms = chain::construct_atoms(*instance, num_objects);
+    atoms.push_back(instance->add_atom("start", {"0", "3"}));  // distance 140
+    atoms.push_back(instance->add_atom("start", {"0", "100"}));  // distance 43
+    atoms.push_back(instance->add_atom("end", {"0", "143"}));
+    atoms.push_back(instance->add_atom("end", {"0", "2"}));
+    State state_0(0, instance, atoms);
+
+    SyntacticElementFactory factory(vocabulary);
+    DenotationsCaches caches;
+
+    auto numerical_0 = factory.parse_numerical("n_sum_role_distance(r_primitive(start,0,1),r_primitive(conn,0,1),r_primitive(end,0,1))");
+    EXPECT_EQ(numerical_0->evaluate(state_0), 183);
+    EXPECT_EQ(numerical_0->evaluate(state_0, caches), 183);
+
+    auto numerical_1 = factory.parse_numerical("n_role_distance(r_primitive(start,0,1),r_primitive(conn,0,1),r_primitive(end,0,1))");
+    EXPECT_EQ(numerical_1->evaluate(state_0), 43);
+    EXPECT_EQ(numerical_1->evaluate(state_0, caches), 43);
+
+    // Both features reuse the distances attached to r_primitive(conn,0,1).
+    auto conn = factory.parse_role("r_primitive(conn,0,1)")->evaluate(state_0, caches);
+    EXPECT_GT(compute_memory_usage(*conn), compute_memory_usage(RoleDenotation(*conn)));
+    EXPECT_EQ(&conn->get_pairwise_distances(), &conn->get_pairwise_distances());
+
+    // Caches with a memory budget count the attached distances.
+    DenotationsCaches bounded_caches(1, std::size_t(1) << 30);
+    EXPECT_EQ(numerical_0->evaluate(state_0, bounded_caches), 183);
+    EXPECT_EQ(numerical_1->evaluate(state_0, bounded_caches), 43);
+    auto bounded_conn = factory.parse_role("r_primitive(conn,0,1)")->evaluate(state_0, bounded_caches);
+    EXPECT_TRUE(bounded_conn->has_pairwise_distances());
+    EXPECT_GT(bounded_caches.per_state_data->get_memory_usage(), num_objects * num_objects * sizeof(int));
+    // Distances that exceed the budget are evicted with their denotation.
+    const std::size_t memory_budget = 64 * 1024;
+    DenotationsCaches small_caches(1, memory_budget);
+    EXPECT_EQ(numerical_0->evaluate(state_0, small_caches), 183);
+    EXPECT_LE(small_caches.per_state_data->get_memory_usage(), memory_budget);
+}
+
 }
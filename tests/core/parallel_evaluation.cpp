@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    TEST(DLPTests, EvaluateParallel)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("edge", 2, true);
+        vocabulary->add_predicate("at", 1);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        const int num_objects = 10;
+        std::vector<Atom> atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            instance->add_static_atom("edge", {std::to_string(i), std::to_string((i + 3) % num_objects)});
+            atoms.push_back(instance->add_atom("at", {std::to_string(i)}));
+        }
+        States states;
+        for (int i = 0; i < 300; ++i) {
+            std::vector<Atom> state_atoms;
+            for (int j = 0; j < num_objects; ++j) {
+                if (((i * 37) >> j) & 1) state_atoms.push_back(atoms[j]);
+            }
+            states.emplace_back(i, instance, state_atoms);
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        std::vector<std::shared_ptr<const Concept>> concepts{
+            factory.parse_concept("c_some(r_primitive(edge,0,1),c_primitive(at,0))"),
+            factory.parse_concept("c_not(c_primitive(at,0))")};
+        std::vector<std::shared_ptr<const Role>> roles{
+            factory.parse_role("r_restrict(r_primitive(edge,0,1),c_primitive(at,0))")};
+        std::vector<std::shared_ptr<const Boolean>> booleans{
+            factory.parse_boolean("b_empty(c_some(r_primitive(edge,0,1),c_primitive(at,0)))")};
+        std::vector<std::shared_ptr<const Numerical>> numericals{
+            factory.parse_numerical("n_count(c_primitive(at,0))"),
+            factory.parse_numerical("n_concept_distance(c_primitive(at,0),r_primitive(edge,0,1),c_not(c_primitive(at,0)))")};
+
+        ThreadPoolExecutor executor(4);
+        // Scratch caches per task and one shared thread-safe cache.
+        for (std::size_t num_shards : {1, 16}) {
+            DenotationsCaches serial_caches;
+            DenotationsCaches caches(num_shards);
+            auto concept_denotations = evaluate(concepts, states, caches, executor);
+            for (size_t i = 0; i < concepts.size(); ++i) {
+                const auto& expected = *concepts[i]->evaluate(states, serial_caches);
+                ASSERT_EQ(concept_denotations[i]->size(), states.size());
+                for (size_t j = 0; j < states.size(); ++j) {
+                    EXPECT_EQ(*(*concept_denotations[i])[j], *expected[j]);
+                }
+                // Results are cached and interned.
+                EXPECT_EQ(concepts[i]->evaluate(states, caches), concept_denotations[i]);
+                EXPECT_EQ(concepts[i]->evaluate(states, caches, executor), concept_denotations[i]);
+            }
+            EXPECT_EQ((*concept_denotations[1])[0], caches.data.insert_unique(concepts[1]->evaluate(states[0])));
+            auto role_denotations = evaluate(roles, states, caches, executor);
+            for (size_t j = 0; j < states.size(); ++j) {
+                EXPECT_EQ(*(*role_denotations[0])[j], roles[0]->evaluate(states[j]));
+            }
+            auto boolean_denotations = evaluate(booleans, states, caches, executor);
+            EXPECT_EQ(*boolean_denotations[0], *booleans[0]->evaluate(states, serial_caches));
+            auto numerical_denotations = evaluate(numericals, states, caches, executor);
+            for (size_t i = 0; i < numericals.size(); ++i) {
+                EXPECT_EQ(*numerical_denotations[i], *numericals[i]->evaluate(states, serial_caches));
+            }
+        }
+        DenotationsCaches caches;
+        EXPECT_TRUE(evaluate(numericals, States(), caches, executor)[0]->empty());
+    }
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "../utils/denotation.h"
+#include "../utils/domain.h"
 
 #include "../../include/dlplan/core.h"
 
@@ -29,4 +30,32 @@ TEST(DLPTests, RoleCompose) {
     EXPECT_EQ(role1->evaluate(state_0), create_role_denotation(*instance, {{"A", "B"}, {"A", "C"}, {"B", "B"}, {"B", "C"}}));
 }
 
+TEST(DLPTests, RoleComposeMultiBlockRows) {
+    // Composing the top role with a chain yields every pair (x, j) with
+    // j > 0, with rows spanning several blocks at unaligned offsets.
+    auto vocabulary = chain::construct_vocabulary_info();
+    auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+    const int num_objects = 150;
+    auto atoms = chain::construct_atoms(*instance, num_objects);
+    State state_0(0, instance, atoms);
+
+    SyntacticElementFactory factory(vocabulary);
+
+    auto role_0 = factory.parse_role("r_compose(r_primitive(conn,0,1),r_primitive(conn,0,1))");
+    auto denotation_0 = role_0->evaluate(state_0);
+    EXPECT_EQ(denotation_0.size(), num_objects - 2);
+    for (int i = 0; i + 2 < num_objects; ++i) {
+        EXPECT_TRUE(denotation_0.contains({i, i + 2}));
+    }
+
+    auto role_1 = factory.parse_role("r_compose(r_top,r_primitive(conn,0,1))");
+    auto denotation_1 = role_1->evaluate(state_0);
+    EXPECT_EQ(denotation_1.size(), num_objects * (num_objects - 1));
+    for (int i = 0; i < num_objects; ++i) {
+        for (int j = 0; j < num_objects; ++j) {
+            EXPECT_EQ(denotation_1.contains({i, j}), j > 0);
+        }
+    }
+}
+
 }
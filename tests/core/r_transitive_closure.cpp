@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "../utils/denotation.h"
+#include "../utils/domain.h"
 
 #include "../../include/dlplan/core.h"
 
@@ -31,4 +32,27 @@ TEST(DLPTests, RoleTransitiveClosure) {
     EXPECT_EQ(role_1->evaluate(state_0), create_role_denotation(*instance, {{"A", "A"}, {"A", "B"}, {"A", "C"}, {"B", "A"}, {"B", "B"}, {"B", "C"}, {"C", "A"}, {"C", "B"}, {"C", "C"}, {"D", "A"}, {"D", "B"}, {"D", "C"}, {"D", "E"}, {"E", "A"}, {"E", "B"}, {"E", "C"}}));
 }
 
+TEST(DLPTests, RoleTransitiveClosureMultiBlockRows) {
+    auto vocabulary = chain::construct_vocabulary_info();
+    auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+    const int num_objects = 150;
+    auto atoms = chain::construct_atoms(*instance, num_objects);
+    State state_0(0, instance, atoms);
+
+    SyntacticElementFactory factory(vocabulary);
+
+    auto role_0 = factory.parse_role("r_transitive_closure(r_primitive(conn,0,1))");
+    auto denotation_0 = role_0->evaluate(state_0);
+    EXPECT_EQ(denotation_0.size(), num_objects * (num_objects - 1) / 2);
+    for (int i = 0; i < num_objects; ++i) {
+        for (int j = 0; j < num_objects; ++j) {
+            EXPECT_EQ(denotation_0.contains({i, j}), i < j);
+        }
+    }
+
+    auto role_1 = factory.parse_role("r_transitive_reflexive_closure(r_primitive(conn,0,1))");
+    auto denotation_1 = role_1->evaluate(state_0);
+    EXPECT_EQ(denotation_1.size(), num_objects * (num_objects + 1) / 2);
+}
+
 }
@@ -2,6 +2,9 @@
 
 #include "../../include/dlplan/core.h"
 
+#include <algorithm>
+#include <iterator>
+
 using namespace dlplan::core;
 
 
@@ -15,4 +18,136 @@ TEST(DLPTests, RoleDenotationComputeRepr) {
     EXPECT_EQ(denotation.str(), "RoleDenotation(num_objects=4, pairs_of_object_indices=[<0,1>, <1,2>])");
 }
 
+TEST(DLPTests, RoleDenotationIterate) {
+    int num_objects = 13;
+    RoleDenotation denotation(num_objects);
+    EXPECT_EQ(denotation.size(), 0);
+    denotation.insert({12,12});
+    denotation.insert({2,6});
+    denotation.insert({0,0});
+    denotation.insert({2,5});
+    EXPECT_EQ(denotation.size(), 4);
+    PairsOfObjectIndices visited;
+    denotation.for_each([&](ObjectIndex first, ObjectIndex second) { visited.emplace_back(first, second); });
+    EXPECT_EQ(visited, PairsOfObjectIndices({{0,0}, {2,5}, {2,6}, {12,12}}));
+    EXPECT_EQ(denotation.to_sorted_vector(), visited);
+    ~denotation;
+    EXPECT_EQ(denotation.size(), 165);
+}
+
+TEST(DLPTests, RoleDenotationAdjacency) {
+    int num_objects = 5;
+    RoleDenotation denotation(num_objects);
+    denotation.insert({3,1});
+    denotation.insert({0,1});
+    denotation.insert({0,4});
+    const RoleAdjacency& adjacency = denotation.get_adjacency();
+    EXPECT_EQ(adjacency.get_num_objects(), num_objects);
+    EXPECT_EQ(ObjectIndices(adjacency.get_successors(0).begin(), adjacency.get_successors(0).end()), ObjectIndices({1, 4}));
+    EXPECT_TRUE(adjacency.get_successors(1).empty());
+    EXPECT_EQ(ObjectIndices(adjacency.get_predecessors(1).begin(), adjacency.get_predecessors(1).end()), ObjectIndices({0, 3}));
+    EXPECT_EQ(&denotation.get_adjacency(), &adjacency);
+    // Copies do not take over the index and can be modified.
+    RoleDenotation copy(denotation);
+    copy.insert({2,1});
+    const RoleAdjacency temporary(copy);
+    EXPECT_EQ(ObjectIndices(temporary.get_predecessors(1).begin(), temporary.get_predecessors(1).end()), ObjectIndices({0, 2, 3}));
+    EXPECT_EQ(ObjectIndices(temporary.get_successors(2).begin(), temporary.get_successors(2).end()), ObjectIndices({1}));
+}
+
+/// @brief Returns a denotation with the given pairs in the given representation.
+static RoleDenotation make_denotation(int num_objects, const PairsOfObjectIndices& pairs, bool dense) {
+    RoleDenotation denotation(num_objects);
+    if (dense) {
+        // Erasing switches back to the sparse representation
+        // at half the maximum sparse size, hence not below.
+        denotation.set();
+        for (int first = 0; first < num_objects; ++first) {
+            for (int second = 0; second < num_objects; ++second) {
+                if (!std::binary_search(pairs.begin(), pairs.end(), std::make_pair(first, second))) {
+                    denotation.erase({first, second});
+                }
+            }
+        }
+    } else {
+        for (const auto& pair : pairs) {
+            denotation.insert(pair);
+        }
+    }
+    return denotation;
+}
+
+TEST(DLPTests, RoleDenotationRepresentations) {
+    // Sparse denotations have at most 64 * 64 / 64 pairs.
+    int num_objects = 64;
+    RoleDenotation sparse(num_objects);
+    sparse.insert({3,1});
+    sparse.insert({0,5});
+    EXPECT_FALSE(sparse.is_dense());
+    RoleDenotation dense(num_objects);
+    for (int i = 0; i < 2 * num_objects; ++i) {
+        dense.insert({i % num_objects, i / num_objects});
+    }
+    EXPECT_TRUE(dense.is_dense());
+    ~dense;
+    ~dense;
+    EXPECT_TRUE(dense.is_dense());
+    dense -= RoleDenotation(dense);
+    EXPECT_FALSE(dense.is_dense());
+    EXPECT_TRUE(dense.empty());
+
+    // Small denotations stay sparse under out-of-order insertions
+    // and dense denotations become sparse again by erasing.
+    int num_many_objects = 256;
+    RoleDenotation reversed(num_many_objects);
+    for (int i = 299; i >= 0; --i) {
+        reversed.insert({i % num_many_objects, i / num_many_objects});
+    }
+    EXPECT_FALSE(reversed.is_dense());
+    EXPECT_EQ(reversed.size(), 300);
+    RoleDenotation erased(num_many_objects);
+    erased.set();
+    for (int first = 0; first < num_many_objects && erased.is_dense(); ++first) {
+        for (int second = 0; second < num_many_objects; ++second) {
+            erased.erase({first, second});
+        }
+    }
+    EXPECT_FALSE(erased.is_dense());
+    EXPECT_LE(erased.size(), num_many_objects * num_many_objects / 64 / 2);
+    EXPECT_EQ(erased.hash(), make_denotation(num_many_objects, erased.to_sorted_vector(), false).hash());
+
+    // Both representations hold between 32 and 64 pairs.
+    PairsOfObjectIndices left_pairs{{0,1}, {0,63}, {5,5}, {17,2}, {63,0}};
+    PairsOfObjectIndices right_pairs{{0,63}, {1,0}, {5,5}, {40,41}};
+    for (int second = 0; second < 40; ++second) {
+        left_pairs.emplace_back(20, second);
+        right_pairs.emplace_back(20, second);
+    }
+    std::sort(left_pairs.begin(), left_pairs.end());
+    std::sort(right_pairs.begin(), right_pairs.end());
+    PairsOfObjectIndices intersection, union_, difference;
+    std::set_intersection(left_pairs.begin(), left_pairs.end(), right_pairs.begin(), right_pairs.end(), std::back_inserter(intersection));
+    std::set_union(left_pairs.begin(), left_pairs.end(), right_pairs.begin(), right_pairs.end(), std::back_inserter(union_));
+    std::set_difference(left_pairs.begin(), left_pairs.end(), right_pairs.begin(), right_pairs.end(), std::back_inserter(difference));
+    for (bool left_dense : {false, true}) {
+        for (bool right_dense : {false, true}) {
+            auto left = make_denotation(num_objects, left_pairs, left_dense);
+            auto right = make_denotation(num_objects, right_pairs, right_dense);
+            EXPECT_EQ(left.is_dense(), left_dense);
+            EXPECT_EQ(right.is_dense(), right_dense);
+            EXPECT_EQ(left.to_sorted_vector(), left_pairs);
+            EXPECT_EQ(left, make_denotation(num_objects, left_pairs, !left_dense));
+            EXPECT_EQ(left.hash(), make_denotation(num_objects, left_pairs, !left_dense).hash());
+            EXPECT_NE(left, right);
+            EXPECT_TRUE(left.intersects(right));
+            EXPECT_FALSE(left.is_subset_of(right));
+            EXPECT_TRUE(make_denotation(num_objects, intersection, left_dense).is_subset_of(right));
+            EXPECT_EQ((RoleDenotation(left) &= right).to_sorted_vector(), intersection);
+            EXPECT_EQ((RoleDenotation(left) |= right).to_sorted_vector(), union_);
+            EXPECT_EQ((RoleDenotation(left) -= right).to_sorted_vector(), difference);
+            EXPECT_EQ((~RoleDenotation(left)).size(), num_objects * num_objects - static_cast<int>(left_pairs.size()));
+        }
+    }
+}
+
 }
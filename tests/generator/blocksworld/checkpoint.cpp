@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "states.h"
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/generator.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace dlplan::core;
+using namespace dlplan::generator;
+
+
+namespace dlplan::tests::generator {
+
+static bool contains(const std::string& log, const std::string& line) {
+    return log.find(line) != std::string::npos;
+}
+
+TEST(DLPTests, GeneratorCheckpoint) {
+    auto instance = make_blocksworld_instance();
+    auto states = make_blocksworld_states(instance);
+    // Unique such that concurrent test runs do not share the file.
+    const std::string filename = (std::filesystem::temp_directory_path() / (
+        std::string("dlplan_") + testing::UnitTest::GetInstance()->current_test_info()->name()
+        + "_" + std::to_string(std::random_device()()) + ".bin")).string();
+    std::remove(filename.c_str());
+
+    FeatureGenerator generator;
+    auto expected_4 = generate_strings(generator, instance, states, 4);
+    auto expected_6 = generate_strings(generator, instance, states, 6);
+
+    // Returns the features and the log of the generator.
+    auto generate_logged = [&](const States& input_states, int complexity_limit) {
+        testing::internal::CaptureStdout();
+        auto features = generate_strings(generator, instance, input_states, complexity_limit);
+        return std::make_pair(features, testing::internal::GetCapturedStdout());
+    };
+
+    generator.set_checkpoint_file(filename);
+    auto [features, log] = generate_logged(states, 4);
+    EXPECT_EQ(features, expected_4);
+    EXPECT_TRUE(contains(log, "Saved checkpoint with complexities up to 4."));
+    EXPECT_TRUE(std::filesystem::exists(filename));
+    // Resume with a higher complexity limit, only the layers above 4 are generated.
+    std::tie(features, log) = generate_logged(states, 6);
+    EXPECT_EQ(features, expected_6);
+    EXPECT_TRUE(contains(log, "Restored checkpoint with complexities up to 4."));
+    EXPECT_FALSE(contains(log, "Started generating base features"));
+    EXPECT_FALSE(contains(log, "Complexity 4:"));
+    EXPECT_TRUE(contains(log, "Complexity 5:"));
+    // Resume with a lower complexity limit, no layer is generated.
+    std::tie(features, log) = generate_logged(states, 4);
+    EXPECT_EQ(features, expected_4);
+    EXPECT_TRUE(contains(log, "Restored checkpoint with complexities up to 4."));
+    EXPECT_FALSE(contains(log, "Complexity "));
+    // Resume with fingerprints on a sample that are recomputed.
+    generator.set_num_sample_states(3);
+    std::tie(features, log) = generate_logged(states, 6);
+    EXPECT_EQ(features, expected_6);
+    EXPECT_TRUE(contains(log, "Restored checkpoint with complexities up to 6."));
+    generator.set_num_sample_states(0);
+
+    // Checkpoints of other states are ignored.
+    auto other_states = make_blocksworld_states(instance, {{{"a"}, {"b"}, {"c"}}, {{"c", "b", "a"}}});
+    generator.set_checkpoint_file("");
+    auto expected_other = generate_strings(generator, instance, other_states, 6);
+    generator.set_checkpoint_file(filename);
+    std::tie(features, log) = generate_logged(other_states, 6);
+    EXPECT_EQ(features, expected_other);
+    EXPECT_TRUE(contains(log, "Ignoring checkpoint of different states or rules."));
+    EXPECT_TRUE(contains(log, "Started generating base features"));
+
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out << "not a checkpoint";
+    }
+    EXPECT_THROW(generate_strings(generator, instance, states, 6), std::runtime_error);
+    std::remove(filename.c_str());
+}
+
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "states.h"
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/generator.h"
+
+#include <unordered_set>
+
+using namespace dlplan::core;
+using namespace dlplan::generator;
+
+
+namespace dlplan::tests::generator {
+
+TEST(DLPTests, GeneratorDeduplication) {
+    auto instance = make_blocksworld_instance();
+    auto states = make_blocksworld_states(instance);
+    SyntacticElementFactory factory(instance->get_vocabulary_info());
+    FeatureGenerator generator;
+    const auto [booleans, numericals, concepts, roles] = generator.generate(factory, states, 5, 5, 5, 5, 5, 3600, 100000);
+
+    // Denotations are interned by the caches, hence equal iff their pointers are equal.
+    DenotationsCaches caches;
+    std::unordered_set<std::shared_ptr<const BooleanDenotations>> boolean_denotations;
+    for (const auto& boolean : booleans) {
+        EXPECT_TRUE(boolean_denotations.insert(boolean->evaluate(states, caches)).second) << boolean->str();
+    }
+    std::unordered_set<std::shared_ptr<const NumericalDenotations>> numerical_denotations;
+    for (const auto& numerical : numericals) {
+        EXPECT_TRUE(numerical_denotations.insert(numerical->evaluate(states, caches)).second) << numerical->str();
+    }
+    std::unordered_set<std::shared_ptr<const ConceptDenotations>> concept_denotations;
+    for (const auto& concept_ : concepts) {
+        EXPECT_TRUE(concept_denotations.insert(concept_->evaluate(states, caches)).second) << concept_->str();
+    }
+    std::unordered_set<std::shared_ptr<const RoleDenotations>> role_denotations;
+    for (const auto& role : roles) {
+        EXPECT_TRUE(role_denotations.insert(role->evaluate(states, caches)).second) << role->str();
+    }
+
+    // Features within the complexity limits that were rejected as duplicates.
+    for (const auto& repr : {"c_and(c_primitive(clear,0),c_primitive(clear,0))", "c_not(c_not(c_primitive(ontable,0)))",
+                             "c_some(r_primitive(on,0,1),c_top)", "c_all(r_primitive(on_g,0,1),c_bot)"}) {
+        EXPECT_TRUE(concept_denotations.count(factory.parse_concept(repr)->evaluate(states, caches))) << repr;
+    }
+    EXPECT_TRUE(role_denotations.count(factory.parse_role("r_inverse(r_inverse(r_primitive(on,0,1)))")->evaluate(states, caches)));
+    EXPECT_TRUE(numerical_denotations.count(factory.parse_numerical("n_count(c_not(c_not(c_primitive(clear,0))))")->evaluate(states, caches)));
+    EXPECT_TRUE(boolean_denotations.count(factory.parse_boolean("b_empty(c_primitive(holding,0))")->evaluate(states, caches)));
+}
+
+}
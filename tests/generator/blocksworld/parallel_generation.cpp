@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include "states.h"
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/generator.h"
+
+using namespace dlplan::core;
+using namespace dlplan::generator;
+
+
+namespace dlplan::tests::generator {
+
+TEST(DLPTests, GeneratorParallelGeneration) {
+    auto instance = make_blocksworld_instance();
+    auto states = make_blocksworld_states(instance);
+
+    FeatureGenerator generator;
+    generator.set_generate_inclusion_boolean(true);
+    generator.set_generate_or_concept(true);
+    generator.set_generate_or_role(true);
+    auto serial = generate_strings(generator, instance, states, 6);
+    EXPECT_GT(serial.size(), 100);
+
+    ThreadPoolExecutor executor(4);
+    generator.set_executor(&executor);
+    EXPECT_EQ(generate_strings(generator, instance, states, 6), serial);
+    EXPECT_EQ(generate_strings(generator, instance, states, 6), serial);
+
+    generator.set_executor(nullptr);
+    EXPECT_EQ(generate_strings(generator, instance, states, 6), serial);
+}
+
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include "states.h"
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/generator.h"
+
+using namespace dlplan::core;
+using namespace dlplan::generator;
+
+
+namespace dlplan::tests::generator {
+
+TEST(DLPTests, GeneratorStagedEvaluation) {
+    auto instance = make_blocksworld_instance();
+    auto states = make_blocksworld_states(instance);
+
+    FeatureGenerator generator;
+    generator.set_generate_inclusion_boolean(true);
+    generator.set_generate_or_concept(true);
+    auto exhaustive = generate_strings(generator, instance, states, 6);
+
+    // Small samples let many different features agree on the sample.
+    for (int num_sample_states : {1, 2, 4, 8, 9}) {
+        generator.set_num_sample_states(num_sample_states);
+        EXPECT_EQ(generate_strings(generator, instance, states, 6), exhaustive) << num_sample_states;
+    }
+
+    ThreadPoolExecutor executor(4);
+    generator.set_executor(&executor);
+    generator.set_num_sample_states(3);
+    EXPECT_EQ(generate_strings(generator, instance, states, 6), exhaustive);
+}
+
+}
@@ -0,0 +1,91 @@
+#ifndef DLPLAN_TESTS_GENERATOR_BLOCKSWORLD_STATES_H_
+#define DLPLAN_TESTS_GENERATOR_BLOCKSWORLD_STATES_H_
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/generator.h"
+
+#include <string>
+#include <vector>
+
+
+namespace dlplan::tests::generator {
+
+/// @brief Returns the instance with blocks a, b, c and goal a on b on c.
+inline std::shared_ptr<core::InstanceInfo> make_blocksworld_instance() {
+    auto vocabulary = std::make_shared<core::VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("ontable", 1);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("holding", 1);
+    vocabulary->add_predicate("handempty", 0);
+    vocabulary->add_predicate("on_g", 2, true);
+    auto instance = std::make_shared<core::InstanceInfo>(0, vocabulary);
+    instance->add_static_atom("on_g", {"a", "b"});
+    instance->add_static_atom("on_g", {"b", "c"});
+    return instance;
+}
+
+/// @brief Returns the states with the given towers, each from bottom to top.
+///        The tower {"*", x} means that block x is held.
+inline core::States make_blocksworld_states(
+    const std::shared_ptr<core::InstanceInfo>& instance,
+    const std::vector<std::vector<std::vector<std::string>>>& configurations) {
+    core::States states;
+    for (const auto& towers : configurations) {
+        core::AtomIndices atom_indices;
+        bool handempty = true;
+        for (const auto& tower : towers) {
+            if (tower.size() == 2 && tower[0] == "*") {
+                atom_indices.push_back(instance->add_atom("holding", {tower[1]}).get_index());
+                handempty = false;
+                continue;
+            }
+            atom_indices.push_back(instance->add_atom("ontable", {tower.front()}).get_index());
+            for (std::size_t i = 1; i < tower.size(); ++i) {
+                atom_indices.push_back(instance->add_atom("on", {tower[i], tower[i - 1]}).get_index());
+            }
+            atom_indices.push_back(instance->add_atom("clear", {tower.back()}).get_index());
+        }
+        if (handempty) {
+            atom_indices.push_back(instance->add_atom("handempty", {}).get_index());
+        }
+        states.emplace_back(static_cast<int>(states.size()), instance, atom_indices);
+    }
+    return states;
+}
+
+/// @brief Returns some reachable states of the instance.
+inline core::States make_blocksworld_states(const std::shared_ptr<core::InstanceInfo>& instance) {
+    return make_blocksworld_states(instance, {
+        {{"a"}, {"b"}, {"c"}},
+        {{"c", "b", "a"}},
+        {{"c", "b"}, {"a"}},
+        {{"c"}, {"b"}, {"*", "a"}},
+        {{"a", "b", "c"}},
+        {{"a", "b"}, {"c"}},
+        {{"b", "c"}, {"*", "a"}},
+        {{"c", "a"}, {"b"}},
+        {{"b", "a"}, {"*", "c"}},
+    });
+}
+
+/// @brief Returns the string representations of the features in the order of
+///        generation with the same complexity limit for all kinds of features.
+inline std::vector<std::string> generate_strings(
+    dlplan::generator::FeatureGenerator& generator,
+    const std::shared_ptr<core::InstanceInfo>& instance,
+    const core::States& states,
+    int complexity_limit) {
+    core::SyntacticElementFactory factory(instance->get_vocabulary_info());
+    const auto [booleans, numericals, concepts, roles] = generator.generate(factory, states, complexity_limit, complexity_limit, complexity_limit, complexity_limit, complexity_limit, 3600, 100000);
+    std::vector<std::string> result;
+    for (const auto& boolean : booleans) result.push_back(boolean->str());
+    for (const auto& numerical : numericals) result.push_back(numerical->str());
+    for (const auto& concept_ : concepts) result.push_back(concept_->str());
+    for (const auto& role : roles) result.push_back(role->str());
+    return result;
+}
+
+}
+
+#endif
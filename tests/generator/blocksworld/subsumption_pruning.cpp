@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "states.h"
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/generator.h"
+
+using namespace dlplan::core;
+using namespace dlplan::generator;
+
+
+namespace dlplan::tests::generator {
+
+/// @brief Returns the arguments of the outermost constructor.
+static std::vector<std::string> split_operands(const std::string& repr) {
+    std::vector<std::string> operands;
+    int depth = 0;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < repr.size(); ++i) {
+        if (repr[i] == '(') {
+            if (depth++ == 0) begin = i + 1;
+        } else if (repr[i] == ')') {
+            if (--depth == 0) operands.push_back(repr.substr(begin, i - begin));
+        } else if (repr[i] == ',' && depth == 1) {
+            operands.push_back(repr.substr(begin, i - begin));
+            begin = i + 1;
+        }
+    }
+    return operands;
+}
+
+/// @brief Returns the string representations of the features in the order of generation.
+static std::vector<std::string> to_strings(const GeneratedFeatures& features) {
+    std::vector<std::string> result;
+    for (const auto& boolean : std::get<0>(features)) result.push_back(boolean->str());
+    for (const auto& numerical : std::get<1>(features)) result.push_back(numerical->str());
+    for (const auto& concept_ : std::get<2>(features)) result.push_back(concept_->str());
+    for (const auto& role : std::get<3>(features)) result.push_back(role->str());
+    return result;
+}
+
+TEST(DLPTests, GeneratorSubsumptionPruning) {
+    auto instance = make_blocksworld_instance();
+    auto states = make_blocksworld_states(instance);
+    SyntacticElementFactory factory(instance->get_vocabulary_info());
+    FeatureGenerator generator;
+    generator.set_generate_or_concept(true);
+    generator.set_generate_or_role(true);
+    const auto features = generator.generate(factory, states, 7, 5, 7, 7, 7, 3600, 1000000);
+    const auto& concepts = std::get<2>(features);
+    const auto pruned = to_strings(features);
+
+    // Skipped pairs would have been rejected as duplicates.
+    generator.set_prune_comparable_operands(false);
+    SyntacticElementFactory unpruned_factory(instance->get_vocabulary_info());
+    EXPECT_EQ(to_strings(generator.generate(unpruned_factory, states, 7, 5, 7, 7, 7, 3600, 1000000)), pruned);
+
+    // Sketches on a sample and parallel subset tests keep the same pairs.
+    generator.set_prune_comparable_operands(true);
+    generator.set_num_sample_states(3);
+    ThreadPoolExecutor executor(4);
+    generator.set_executor(&executor);
+    SyntacticElementFactory sample_factory(instance->get_vocabulary_info());
+    EXPECT_EQ(to_strings(generator.generate(sample_factory, states, 7, 5, 7, 7, 7, 3600, 1000000)), pruned);
+
+    // Operands of kept conjunctions and disjunctions are incomparable.
+    DenotationsCaches caches;
+    int num_checked = 0;
+    for (const auto& concept_ : concepts) {
+        auto operands = split_operands(concept_->str());
+        if (operands.size() != 2 || (concept_->str().rfind("c_and(", 0) && concept_->str().rfind("c_or(", 0))) continue;
+        auto left = factory.parse_concept(operands[0])->evaluate(states, caches);
+        auto right = factory.parse_concept(operands[1])->evaluate(states, caches);
+        bool left_subset = true;
+        bool right_subset = true;
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            left_subset &= (*left)[i]->is_subset_of(*(*right)[i]);
+            right_subset &= (*right)[i]->is_subset_of(*(*left)[i]);
+        }
+        EXPECT_FALSE(left_subset || right_subset) << concept_->str();
+        ++num_checked;
+    }
+    EXPECT_GT(num_checked, 0);
+}
+
+}
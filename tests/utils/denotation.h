@@ -1,5 +1,5 @@
-#ifndef DLPLAN_TESTS_UTILS_DOMAIN_H_
-#define DLPLAN_TESTS_UTILS_DOMAIN_H_
+#ifndef DLPLAN_TESTS_UTILS_DENOTATION_H_
+#define DLPLAN_TESTS_UTILS_DENOTATION_H_
 
 #include "../../include/dlplan/core.h"
 
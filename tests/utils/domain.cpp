@@ -52,6 +52,40 @@ std::shared_ptr<VocabularyInfo> construct_vocabulary_info() {
 }
 }
 
+namespace chain {
+std::shared_ptr<VocabularyInfo> construct_vocabulary_info() {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("conn", 2);
+    vocabulary->add_predicate("start", 2);
+    vocabulary->add_predicate("end", 2);
+    return vocabulary;
+}
+
+std::vector<Atom> construct_atoms(InstanceInfo& instance, int num_objects) {
+    std::vector<Atom> atoms;
+    for (int i = 0; i + 1 < num_objects; ++i) {
+        atoms.push_back(instance.add_atom("conn", {std::to_string(i), std::to_string(i + 1)}));
+    }
+    return atoms;
+}
+}
+
+States construct_hashed_states(std::shared_ptr<InstanceInfo> instance, int num_states) {
+    std::vector<Atom> atoms;
+    for (const auto& atom : instance->get_atoms()) {
+        if (!atom.is_static()) atoms.push_back(atom);
+    }
+    States states;
+    for (int i = 0; i < num_states; ++i) {
+        std::vector<Atom> state_atoms;
+        for (size_t j = 0; j < atoms.size(); ++j) {
+            if (((i * 2654435761u) >> (j % 32)) & 1) state_atoms.push_back(atoms[j]);
+        }
+        states.emplace_back(i, instance, state_atoms);
+    }
+    return states;
+}
+
 std::shared_ptr<SyntacticElementFactory> construct_syntactic_element_factory(std::shared_ptr<VocabularyInfo> vocabulary) {
     return std::make_shared<SyntacticElementFactory>(vocabulary);
 }
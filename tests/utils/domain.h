@@ -16,6 +16,20 @@ namespace blocks_4 {
 extern std::shared_ptr<dlplan::core::VocabularyInfo> construct_vocabulary_info();
 }
 
+/// @brief A chain 0 -> 1 -> ... -> n-1 of conn atoms. With enough objects,
+///        rows of role denotations span several blocks at unaligned offsets.
+namespace chain {
+/// @brief Returns a vocabulary with the binary predicates conn, start, and end.
+extern std::shared_ptr<dlplan::core::VocabularyInfo> construct_vocabulary_info();
+
+/// @brief Adds the conn atoms of a chain over the objects named 0, ..., num_objects-1.
+extern std::vector<dlplan::core::Atom> construct_atoms(dlplan::core::InstanceInfo& instance, int num_objects);
+}
+
+/// @brief Returns states of the instance, each with a pseudo-random subset of
+///        the dynamic atoms selected by a multiplicative hash of its index.
+extern dlplan::core::States construct_hashed_states(std::shared_ptr<dlplan::core::InstanceInfo> instance_info, int num_states);
+
 extern std::shared_ptr<dlplan::core::SyntacticElementFactory> construct_syntactic_element_factory(std::shared_ptr<dlplan::core::VocabularyInfo> vocabulary_info);
 
 }